@@ -29,6 +29,7 @@ public:
 private slots:
   void newPart();
   void deleteProject();
+  void planFromInventory();
   void cutLog();
   void partCompleteRough();
   void partCompleteFinished();
@@ -10,6 +10,7 @@
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QByteArray>
+#include <QVariant>
 
 #include "sales/product.hpp"
 
@@ -96,12 +97,6 @@ namespace woodworks::domain
 
         // ---- Mapping -----
 
-        /**
-         * @brief Generates the SQL statement for creating the database table.
-         * @return A QString containing the SQL statement.
-         */
-        static QString createDbSQL();
-
         /**
          * @brief Generates the SQL statement for viewing individual cookies.
          * @return A QString containing the SQL statement.
@@ -158,6 +153,19 @@ namespace woodworks::domain
          */
         static void bindForUpdate(QSqlQuery &query, const Cookie &cookie);
 
+        /**
+         * Names the table a cookie is stored in.
+         * @return The table name.
+         */
+        static QString tableName();
+
+        /**
+         * Maps the cookie attributes to their columns, without the id.
+         * @param cookie The cookie to map.
+         * @return Column name to value, bound the same way as bindForUpdate.
+         */
+        static QVariantMap columnValues(const Cookie &cookie);
+
         /**
          * @brief Creates a Cookie object from a QSqlRecord.
          * @param record The QSqlRecord containing the cookie data.
@@ -173,7 +181,7 @@ namespace woodworks::domain
          */
         static bool matches(const Cookie &item, const Cookie &example) noexcept
         {
-            return item.species.name == example.species.name &&
+            return item.species == example.species &&
                    item.length.toTicks() == example.length.toTicks() &&
                    item.diameter.toTicks() == example.diameter.toTicks() &&
                    item.drying == example.drying &&
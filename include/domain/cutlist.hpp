@@ -7,6 +7,7 @@
 
 #include <QString>
 #include <QSqlQuery>
+#include <QVariant>
 #include <string>
 
 #include "types.hpp"
@@ -135,12 +136,6 @@ namespace woodworks::domain
 
         // ---- Mapping -----
 
-        /**
-         * @brief Generates the SQL statement for creating the database table.
-         * @return A QString containing the SQL statement.
-         */
-        static QString createDbSQL();
-
         /**
          * @brief Generates the SQL query for viewing the cutlist of a specific project.
          * @param project The name of the project.
@@ -204,6 +199,19 @@ namespace woodworks::domain
          */
         static void bindForUpdate(QSqlQuery &query, const CustomCut &customCut);
 
+        /**
+         * @brief Names the table custom cuts are stored in.
+         * @return The table name.
+         */
+        static QString tableName();
+
+        /**
+         * @brief Maps the custom cut data to its columns, without the id.
+         * @param customCut The CustomCut object containing the data.
+         * @return Column name to value, bound the same way as bindForUpdate.
+         */
+        static QVariantMap columnValues(const CustomCut &customCut);
+
         /**
          * @brief Creates a CustomCut object from a QSqlRecord.
          * @param record The QSqlRecord containing the custom cut data.
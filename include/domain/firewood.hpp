@@ -11,6 +11,7 @@
 #include <string>
 #include <QSqlQuery>
 #include <QByteArray>
+#include <QVariant>
 
 #include "sales/product.hpp"
 
@@ -100,12 +101,6 @@ namespace woodworks::domain
 
         // --- Mapping -----
 
-        /**
-         * @brief Generates the SQL for creating the firewood table.
-         * @return SQL statement as QString.
-         */
-        static QString createDbSQL();
-
         /**
          * @brief SQL view for individual firewood entries.
          * @return SQL statement as QString.
@@ -162,6 +157,18 @@ namespace woodworks::domain
          */
         static void bindForUpdate(QSqlQuery &, const Firewood &);
 
+        /**
+         * @brief Names the table firewood is stored in.
+         */
+        static QString tableName();
+
+        /**
+         * @brief Maps firewood data to its columns, without the id.
+         * @param fw The Firewood instance.
+         * @return Column name to value, bound the same way as bindForUpdate.
+         */
+        static QVariantMap columnValues(const Firewood &);
+
         /**
          * @brief Constructs a Firewood object from a QSqlRecord.
          * @param record The record containing firewood data.
@@ -177,7 +184,7 @@ namespace woodworks::domain
          */
         static bool matches(const Firewood &item, const Firewood &example) noexcept
         {
-            return item.species.name == example.species.name &&
+            return item.species == example.species &&
                    item.location == example.location &&
                    item.drying == example.drying &&
                    item.location == example.location;
@@ -7,6 +7,8 @@
 
 #include "firewood.hpp"
 #include "infra/repository.hpp"
+#include "infra/unit_of_work.hpp"
+#include <functional>
 #include <vector>
 
 namespace woodworks::domain
@@ -74,84 +76,58 @@ namespace woodworks::domain
 
         /**
          * @brief Moves up to a specified volume of firewood to a new location.
+         *
+         * Runs as one transaction with one change notification.
          * @param volume The volume of firewood to move (in cubic feet).
          * @param newLocation The new location for the firewood.
          */
         void moveVolume(double volume, const std::string &newLocation)
         {
-            auto repo = woodworks::infra::QtSqlRepository<Firewood>::spawn();
-            double remaining = volume;
-            std::vector<Firewood> kept;
-            for (auto &fw : items)
-            {
-                if (remaining <= 0)
-                {
-                    kept.push_back(fw);
-                    continue;
-                }
-                if (fw.cubicFeet <= remaining)
-                {
-                    fw.location = newLocation;
-                    repo.update(fw);
-                    remaining -= fw.cubicFeet;
-                }
-                else
-                {
-                    Firewood moved = fw;
-                    moved.cubicFeet = remaining;
-                    moved.location = newLocation;
-                    repo.add(moved);
-                    fw.cubicFeet -= remaining;
-                    repo.update(fw);
-                    kept.push_back(fw);
-                    remaining = 0;
-                }
-            }
-            items = std::move(kept);
+            takeVolume(volume, [&](Firewood &fw)
+                       { fw.location = newLocation; }, false);
         }
 
         /**
          * @brief Deletes up to a specified volume of firewood from the bundle.
+         *
+         * Runs as one transaction with one change notification.
          * @param volume The volume of firewood to delete (in cubic feet).
          */
         void deleteVolume(double volume)
         {
-            auto repo = woodworks::infra::QtSqlRepository<Firewood>::spawn();
-            double remaining = volume;
-            std::vector<Firewood> kept;
-            for (auto &fw : items)
-            {
-                if (remaining <= 0)
-                {
-                    kept.push_back(fw);
-                    continue;
-                }
-                if (fw.cubicFeet <= remaining)
-                {
-                    repo.remove(fw.id.id);
-                    remaining -= fw.cubicFeet;
-                }
-                else
-                {
-                    fw.cubicFeet -= remaining;
-                    repo.update(fw);
-                    kept.push_back(fw);
-                    remaining = 0;
-                }
-            }
-            items = std::move(kept);
+            takeVolume(volume, nullptr, false);
         }
 
         /**
          * @brief Dries up to a specified volume of firewood to a new drying state.
+         *
+         * Runs as one transaction with one change notification.
          * @param volume The volume of firewood to dry (in cubic feet).
          * @param newDrying The new drying state for the firewood.
          */
         void dryVolume(double volume, types::Drying newDrying)
+        {
+            takeVolume(volume, [&](Firewood &fw)
+                       { fw.drying = newDrying; }, true);
+        }
+
+    private:
+        /**
+         * @brief Applies a change to up to a volume of firewood, splitting the item that straddles it.
+         * @param volume The volume to change (in cubic feet).
+         * @param change Applied to whole items and to the split-off part; null deletes them instead.
+         * @param keepChanged Whether changed items stay in the bundle.
+         */
+        void takeVolume(double volume, const std::function<void(Firewood &)> &change, bool keepChanged)
         {
             auto repo = woodworks::infra::QtSqlRepository<Firewood>::spawn();
+            // Declared first so the one notification fires after the commit
+            woodworks::infra::NotificationBatch batch;
+            woodworks::infra::UnitOfWork uow(woodworks::infra::DbConnection::instance());
             double remaining = volume;
             std::vector<Firewood> kept;
+            std::vector<Firewood> changed;
+            std::vector<int> removed;
             for (auto &fw : items)
             {
                 if (remaining <= 0)
@@ -161,25 +137,37 @@ namespace woodworks::domain
                 }
                 if (fw.cubicFeet <= remaining)
                 {
-                    fw.drying = newDrying;
-                    repo.update(fw);
                     remaining -= fw.cubicFeet;
-                    kept.push_back(fw);
+                    if (!change)
+                    {
+                        removed.push_back(fw.id.id);
+                        continue;
+                    }
+                    change(fw);
+                    changed.push_back(fw);
+                    if (keepChanged)
+                    {
+                        kept.push_back(fw);
+                    }
                 }
                 else
                 {
-                    // split item: dry a portion and leave remainder
-                    Firewood dried = fw;
-                    dried.cubicFeet = remaining;
-                    dried.drying = newDrying;
-                    repo.add(dried);
-
+                    if (change)
+                    {
+                        Firewood part = fw;
+                        part.cubicFeet = remaining;
+                        change(part);
+                        repo.add(part);
+                    }
                     fw.cubicFeet -= remaining;
-                    repo.update(fw);
+                    changed.push_back(fw);
                     kept.push_back(fw);
                     remaining = 0;
                 }
             }
+            repo.updateMany(changed);
+            repo.removeMany(removed);
+            uow.commit();
             items = std::move(kept);
         }
     };
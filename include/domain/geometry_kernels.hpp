@@ -0,0 +1,302 @@
+/**
+ * @file geometry_kernels.hpp
+ * @brief Batch numerics for chord widths, board feet, log volumes and value.
+ *
+ * Inputs are struct-of-arrays columns of raw 1/16" ticks (the same integers
+ * Length stores), so loops run over contiguous memory and vectorize. Every
+ * batch function has a scalar twin used by the domain code, and the two give
+ * identical results. When the build targets AVX (see WOODWORKS_NATIVE_ARCH in
+ * CMakeLists.txt) the hot loops use intrinsics; otherwise they are written so
+ * the compiler auto-vectorizes them.
+ */
+
+#pragma once
+
+#include "domain/units.hpp"
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define WOODWORKS_RESTRICT __restrict__
+#else
+#define WOODWORKS_RESTRICT
+#endif
+
+/**
+ * @namespace woodworks::domain::geometry
+ * @brief Contains scalar and batch geometry kernels.
+ */
+namespace woodworks::domain::geometry
+{
+    using imperial::Length;
+
+    constexpr double PI = 3.14159265358979323846;
+    constexpr double TICKS_PER_INCH = 16.0;
+    constexpr double TICKS_PER_FOOT = 192.0;
+    // ticks^3 in one board foot (144 cubic inches)
+    constexpr double CUBIC_TICKS_PER_BOARD_FOOT = 144.0 * TICKS_PER_INCH * TICKS_PER_INCH * TICKS_PER_INCH;
+    // ticks^3 in one cubic foot
+    constexpr double CUBIC_TICKS_PER_CUBIC_FOOT = TICKS_PER_FOOT * TICKS_PER_FOOT * TICKS_PER_FOOT;
+
+    /**
+     * @struct BoardColumns
+     * @brief Thickness, width and length of many boards, one column each.
+     */
+    struct BoardColumns
+    {
+        std::vector<uint32_t> thickness;
+        std::vector<uint32_t> width;
+        std::vector<uint32_t> length;
+
+        size_t size() const { return thickness.size(); }
+
+        void reserve(size_t n)
+        {
+            thickness.reserve(n);
+            width.reserve(n);
+            length.reserve(n);
+        }
+
+        void push(Length t, Length w, Length l)
+        {
+            thickness.push_back(t.toTicks());
+            width.push_back(w.toTicks());
+            length.push_back(l.toTicks());
+        }
+    };
+
+    /**
+     * @struct LogColumns
+     * @brief Diameters and lengths of many logs, one column each.
+     */
+    struct LogColumns
+    {
+        std::vector<uint32_t> diameter;
+        std::vector<uint32_t> length;
+
+        size_t size() const { return diameter.size(); }
+
+        void reserve(size_t n)
+        {
+            diameter.reserve(n);
+            length.reserve(n);
+        }
+
+        void push(Length d, Length l)
+        {
+            diameter.push_back(d.toTicks());
+            length.push_back(l.toTicks());
+        }
+    };
+
+    // -------------- Scalar -------------- //
+
+    /**
+     * @brief Width of a cut parallel to the log centerline, 2 * sqrt(x(D-x)), truncated to a tick.
+     * @param diameter The log diameter.
+     * @param offset Offset from the edge of the log.
+     * @return The chord width; zero past the far edge.
+     */
+    inline Length chordWidth(Length diameter, Length offset)
+    {
+        if (offset > diameter)
+        {
+            return Length::fromTicks(0);
+        }
+        double x = offset.toTicks();
+        double d = diameter.toTicks();
+        return Length::fromTicks(static_cast<uint32_t>(2.0 * std::sqrt(x * (d - x))));
+    }
+
+    /**
+     * @brief Board feet of a rectangular piece.
+     */
+    inline double boardFeet(Length thickness, Length width, Length length)
+    {
+        return static_cast<double>(thickness.toTicks()) * static_cast<double>(width.toTicks()) *
+               static_cast<double>(length.toTicks()) * (1.0 / CUBIC_TICKS_PER_BOARD_FOOT);
+    }
+
+    /**
+     * @brief Volume of a cylinder in cubic feet.
+     */
+    inline double cylinderCubicFeet(Length diameter, Length length)
+    {
+        double d = diameter.toTicks();
+        return d * d * static_cast<double>(length.toTicks()) * (PI / 4.0 / CUBIC_TICKS_PER_CUBIC_FOOT);
+    }
+
+    /**
+     * @brief Volume of a conical frustum (a tapered log) in cubic feet.
+     * @param smallEnd Diameter at one end.
+     * @param largeEnd Diameter at the other end.
+     * @param length Length between the ends.
+     */
+    inline double frustumCubicFeet(Length smallEnd, Length largeEnd, Length length)
+    {
+        double r = smallEnd.toTicks();
+        double R = largeEnd.toTicks();
+        return static_cast<double>(length.toTicks()) * (R * R + R * r + r * r) * (PI / 12.0 / CUBIC_TICKS_PER_CUBIC_FOOT);
+    }
+
+    // -------------- Batch -------------- //
+
+    /**
+     * @brief Chord widths at many offsets across one log.
+     * @param diameter Log diameter in ticks.
+     * @param offsets Offsets in ticks.
+     * @param n Number of offsets.
+     * @param out Chord widths in ticks.
+     */
+    inline void chordWidths(uint32_t diameter, const uint32_t *WOODWORKS_RESTRICT offsets, size_t n,
+                            uint32_t *WOODWORKS_RESTRICT out)
+    {
+        const double d = diameter;
+        size_t i = 0;
+#if defined(__AVX__)
+        const __m256d vd = _mm256_set1_pd(d);
+        const __m256d two = _mm256_set1_pd(2.0);
+        for (; i + 4 <= n; i += 4)
+        {
+            __m256d x = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i *>(offsets + i)));
+            x = _mm256_min_pd(x, vd);
+            __m256d w = _mm256_mul_pd(two, _mm256_sqrt_pd(_mm256_mul_pd(x, _mm256_sub_pd(vd, x))));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm256_cvttpd_epi32(w));
+        }
+#endif
+        for (; i < n; ++i)
+        {
+            // Offsets past the far edge clamp to it, giving a zero width
+            double x = std::min(static_cast<double>(offsets[i]), d);
+            out[i] = static_cast<uint32_t>(2.0 * std::sqrt(x * (d - x)));
+        }
+    }
+
+    /**
+     * @brief Chord width at every tick offset from 0 to the diameter.
+     * @param diameter The log diameter.
+     * @return diameter + 1 widths, indexed by offset in ticks.
+     */
+    inline std::vector<uint32_t> chordWidthProfile(Length diameter)
+    {
+        const uint32_t d = diameter.toTicks();
+        std::vector<uint32_t> offsets(static_cast<size_t>(d) + 1);
+        for (uint32_t x = 0; x <= d; ++x)
+        {
+            offsets[x] = x;
+        }
+        std::vector<uint32_t> widths(offsets.size());
+        chordWidths(d, offsets.data(), offsets.size(), widths.data());
+        return widths;
+    }
+
+    /**
+     * @brief Board feet of many boards.
+     * @param boards Board dimensions.
+     * @param out One value per board.
+     */
+    inline void boardFeet(const BoardColumns &boards, double *WOODWORKS_RESTRICT out)
+    {
+        const uint32_t *WOODWORKS_RESTRICT t = boards.thickness.data();
+        const uint32_t *WOODWORKS_RESTRICT w = boards.width.data();
+        const uint32_t *WOODWORKS_RESTRICT l = boards.length.data();
+        const size_t n = boards.size();
+        size_t i = 0;
+#if defined(__AVX__)
+        const __m256d scale = _mm256_set1_pd(1.0 / CUBIC_TICKS_PER_BOARD_FOOT);
+        for (; i + 4 <= n; i += 4)
+        {
+            __m256d vt = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i *>(t + i)));
+            __m256d vw = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i *>(w + i)));
+            __m256d vl = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i *>(l + i)));
+            _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(vt, vw), vl), scale));
+        }
+#endif
+        for (; i < n; ++i)
+        {
+            out[i] = static_cast<double>(t[i]) * static_cast<double>(w[i]) * static_cast<double>(l[i]) * (1.0 / CUBIC_TICKS_PER_BOARD_FOOT);
+        }
+    }
+
+    /**
+     * @brief Cylinder volumes of many logs, in cubic feet.
+     * @param logs Log dimensions.
+     * @param out One value per log.
+     */
+    inline void cylinderCubicFeet(const LogColumns &logs, double *WOODWORKS_RESTRICT out)
+    {
+        const uint32_t *WOODWORKS_RESTRICT d = logs.diameter.data();
+        const uint32_t *WOODWORKS_RESTRICT l = logs.length.data();
+        const size_t n = logs.size();
+        const double scale = PI / 4.0 / CUBIC_TICKS_PER_CUBIC_FOOT;
+        for (size_t i = 0; i < n; ++i)
+        {
+            double di = d[i];
+            out[i] = di * di * static_cast<double>(l[i]) * scale;
+        }
+    }
+
+    /**
+     * @brief Frustum volumes of many tapered logs, in cubic feet.
+     * @param smallEnd Small end diameters in ticks.
+     * @param largeEnd Large end diameters in ticks.
+     * @param length Lengths in ticks.
+     * @param n Number of logs.
+     * @param out One value per log.
+     */
+    inline void frustumCubicFeet(const uint32_t *WOODWORKS_RESTRICT smallEnd, const uint32_t *WOODWORKS_RESTRICT largeEnd,
+                                 const uint32_t *WOODWORKS_RESTRICT length, size_t n, double *WOODWORKS_RESTRICT out)
+    {
+        const double scale = PI / 12.0 / CUBIC_TICKS_PER_CUBIC_FOOT;
+        for (size_t i = 0; i < n; ++i)
+        {
+            double r = smallEnd[i];
+            double R = largeEnd[i];
+            out[i] = static_cast<double>(length[i]) * (R * R + R * r + r * r) * scale;
+        }
+    }
+
+    /**
+     * @brief Multiplies quantities by unit prices, element-wise.
+     * @param quantities Board feet, cubic feet or pieces.
+     * @param centsPerUnit Price of one unit.
+     * @param n Number of items.
+     * @param out Value of each item in cents.
+     * @return Total value in cents.
+     */
+    inline double value(const double *WOODWORKS_RESTRICT quantities, const double *WOODWORKS_RESTRICT centsPerUnit, size_t n,
+                        double *WOODWORKS_RESTRICT out)
+    {
+        double total = 0.0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = quantities[i] * centsPerUnit[i];
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            total += out[i];
+        }
+        return total;
+    }
+
+    /**
+     * @brief Sum of a column.
+     */
+    inline double sum(const double *WOODWORKS_RESTRICT values, size_t n)
+    {
+        double total = 0.0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            total += values[i];
+        }
+        return total;
+    }
+}
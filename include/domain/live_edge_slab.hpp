@@ -10,6 +10,7 @@
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QByteArray>
+#include <QVariant>
 
 #include "sales/product.hpp"
 
@@ -75,8 +76,6 @@ namespace woodworks::domain
         sales::Product toProduct();
 
         // ---- Mapping -----
-        /** @brief SQL for creating the slabs table. */
-        static QString createDbSQL();
         /** @brief SQL for inserting a slab record. */
         static QString insertSQL();
         /** @brief SQL view for individual slab entries. */
@@ -104,6 +103,16 @@ namespace woodworks::domain
          * @param slab The LiveEdgeSlab instance.
          */
         static void bindForUpdate(QSqlQuery &, const LiveEdgeSlab &);
+        /**
+         * @brief Names the table slabs are stored in.
+         */
+        static QString tableName();
+        /**
+         * @brief Maps slab data to its columns, without the id.
+         * @param slab The LiveEdgeSlab instance.
+         * @return Column name to value, bound the same way as bindForUpdate.
+         */
+        static QVariantMap columnValues(const LiveEdgeSlab &);
         /**
          * @brief Constructs a LiveEdgeSlab from a QSqlRecord.
          * @param record The record containing slab data.
@@ -119,7 +128,7 @@ namespace woodworks::domain
          */
         static bool matches(const LiveEdgeSlab &item, const LiveEdgeSlab &example) noexcept
         {
-            return item.species.name == example.species.name &&
+            return item.species == example.species &&
                    item.thickness.toTicks() == example.thickness.toTicks() &&
                    item.width.toTicks() == example.width.toTicks() &&
                    item.length.toTicks() == example.length.toTicks() &&
@@ -6,6 +6,7 @@
 #include <string>
 #include <QSqlQuery>
 #include <QByteArray>
+#include <QVariant>
 #include "domain/cookie.hpp"
 #include "domain/firewood.hpp"
 
@@ -91,12 +92,6 @@ namespace woodworks::domain
 
         // ---- Mapping -----
 
-        /**
-         * Generates the SQL statement for creating the database table.
-         * @return The SQL create table statement.
-         */
-        static QString createDbSQL();
-
         /**
          * Generates the SQL statement for viewing individual logs.
          * @return The SQL individual view statement.
@@ -153,6 +148,19 @@ namespace woodworks::domain
          */
         static void bindForUpdate(QSqlQuery &query, const Log &log);
 
+        /**
+         * Names the table a log is stored in.
+         * @return The table name.
+         */
+        static QString tableName();
+
+        /**
+         * Maps the log attributes to their columns, without the id.
+         * @param log The log to map.
+         * @return Column name to value, bound the same way as bindForUpdate.
+         */
+        static QVariantMap columnValues(const Log &log);
+
         /**
          * Creates a Log object from a database record.
          * @param record The database record.
@@ -168,7 +176,7 @@ namespace woodworks::domain
          */
         static bool matches(const Log &item, const Log &example) noexcept
         {
-            return item.species.name == example.species.name &&
+            return item.species == example.species &&
                    item.length.toTicks() == example.length.toTicks() &&
                    item.diameter.toTicks() == example.diameter.toTicks() &&
                    item.drying == example.drying &&
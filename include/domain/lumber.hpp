@@ -5,6 +5,7 @@
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QByteArray>
+#include <QVariant>
 
 #include "sales/product.hpp"
 
@@ -70,12 +71,6 @@ namespace woodworks::domain
 
         // ---- Mapping -----
 
-        /**
-         * Generates the SQL statement for creating the database table.
-         * @return The SQL create table statement.
-         */
-        static QString createDbSQL();
-
         /**
          * Generates the SQL statement for viewing individual lumber entries.
          * @return The SQL individual view statement.
@@ -132,6 +127,19 @@ namespace woodworks::domain
          */
         static void bindForUpdate(QSqlQuery &query, const Lumber &lumber);
 
+        /**
+         * Names the table a lumber is stored in.
+         * @return The table name.
+         */
+        static QString tableName();
+
+        /**
+         * Maps the lumber attributes to their columns, without the id.
+         * @param lumber The lumber to map.
+         * @return Column name to value, bound the same way as bindForUpdate.
+         */
+        static QVariantMap columnValues(const Lumber &lumber);
+
         /**
          * Creates a Lumber object from a database record.
          * @param record The database record.
@@ -147,7 +155,7 @@ namespace woodworks::domain
          */
         static bool matches(const Lumber &item, const Lumber &example) noexcept
         {
-            return item.species.name == example.species.name &&
+            return item.species == example.species &&
                    item.thickness.toTicks() == example.thickness.toTicks() &&
                    item.width.toTicks() == example.width.toTicks() &&
                    item.length.toTicks() == example.length.toTicks() &&
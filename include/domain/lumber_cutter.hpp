@@ -148,15 +148,26 @@ namespace woodworks::domain::lumber
          */
         std::vector<Lumber> finalizeCuts(std::optional<std::string> location = {}, std::optional<std::string> notes = {})
         {
-            // Original slab worth
-            int allocCentsTotal = slab.worth.toCents();
+            std::vector<Lumber> boards;
+            if (plannedBoards.empty())
+            {
+                return boards;
+            }
+
             // Each cut board is worth a fraction of the original slab worth
             // based on the width of the board (i.e. ten inch width lumber on a 100 inch slab worth 100 cents is worth 10 cents)
-            int centsPerBoard = slab.worth.toCents() / plannedBoards.size();
+            unsigned int totalWidth = 0;
+            for (auto &b : plannedBoards)
+            {
+                totalWidth += b.width.toTicks();
+            }
 
-            std::vector<Lumber> boards;
             for (auto &b : plannedBoards)
             {
+                int centsPerBoard = totalWidth > 0
+                                        ? static_cast<int>(static_cast<long long>(slab.worth.toCents()) * b.width.toTicks() / totalWidth)
+                                        : 0;
+
                 Lumber board = Lumber::uninitialized();
                 board.species = slab.species;
                 board.length = slab.length;
@@ -0,0 +1,394 @@
+/**
+ * @file nesting.hpp
+ * @brief Defines the CutlistNester, which lays out CustomCut parts on lumber and slabs in inventory.
+ */
+
+#pragma once
+
+#include "domain/cutlist.hpp"
+#include "domain/lumber.hpp"
+#include "domain/live_edge_slab.hpp"
+#include "domain/units.hpp"
+#include "domain/types.hpp"
+#include "domain/geometry_kernels.hpp"
+#include "infra/repository.hpp"
+
+#include <vector>
+#include <string>
+#include <map>
+#include <tuple>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+/**
+ * @namespace woodworks::domain::nesting
+ * @brief Contains the cutlist nesting engine.
+ */
+namespace woodworks::domain::nesting
+{
+    /**
+     * @enum StockKind
+     * @brief Which inventory table a piece of stock came from.
+     */
+    enum class StockKind : uint8_t
+    {
+        LUMBER,
+        SLAB
+    };
+
+    /**
+     * @struct NestPart
+     * @brief One physical part to cut; a CustomCut with quantity 3 becomes three parts.
+     */
+    struct NestPart
+    {
+        Id cutId{-1};
+        std::string name;
+        std::string species;
+        Length thickness{Length::fromTicks(0)};
+        Length width{Length::fromTicks(0)};
+        Length length{Length::fromTicks(0)};
+    };
+
+    /**
+     * @struct NestStock
+     * @brief A board or slab the parts may be cut from.
+     */
+    struct NestStock
+    {
+        Id id{-1};
+        StockKind kind{StockKind::LUMBER};
+        std::string species;
+        Length thickness{Length::fromTicks(0)};
+        Length width{Length::fromTicks(0)};
+        Length length{Length::fromTicks(0)};
+    };
+
+    /**
+     * @struct Placement
+     * @brief Where a part sits on its board, measured from one corner.
+     */
+    struct Placement
+    {
+        size_t part;
+        Length alongLength;
+        Length acrossWidth;
+    };
+
+    /**
+     * @struct BoardLayout
+     * @brief The parts cut from a single piece of stock.
+     */
+    struct BoardLayout
+    {
+        NestStock stock;
+        std::vector<Placement> placements;
+        /** @brief Volume of stock not going into parts, in board feet. */
+        double wasteBoardFeet{0.0};
+    };
+
+    /**
+     * @struct NestingOptions
+     * @brief Settings for a nesting run.
+     */
+    struct NestingOptions
+    {
+        /** @brief Saw kerf between neighbouring parts. */
+        Length kerf{Length::fromTicks(2)};
+        /** @brief Worker threads used to score candidate boards; 0 uses every core. */
+        unsigned int threads{0};
+    };
+
+    /**
+     * @struct NestingResult
+     * @brief A complete cut plan.
+     */
+    struct NestingResult
+    {
+        /** @brief Every part, indexed by Placement::part. */
+        std::vector<NestPart> parts;
+        /** @brief Boards used, in the order they were chosen. */
+        std::vector<BoardLayout> boards;
+        /** @brief Indices of parts that no available stock could hold. */
+        std::vector<size_t> unplaced;
+        /** @brief Total waste over all used boards, in board feet. */
+        double wasteBoardFeet{0.0};
+        /** @brief Part volume divided by the volume of boards used. */
+        double utilization{0.0};
+    };
+
+    /**
+     * @class CutlistNester
+     * @brief Packs parts onto stock with guillotine cuts, minimizing waste.
+     *
+     * Parts keep their grain running along the board, so they are never rotated,
+     * and a board must be at least as thick as a part to hold it. Parts are only
+     * placed on stock of the same species. Boards are chosen greedily: each round
+     * every remaining distinct board size is packed first-fit-decreasing with the
+     * remaining parts, in parallel, and the board with the best volume
+     * utilization is taken.
+     */
+    class CutlistNester
+    {
+    public:
+        explicit CutlistNester(NestingOptions options = {}) : options_(options) {}
+
+        /**
+         * @brief Nests a project's outstanding parts against the lumber and slabs in inventory.
+         * @param project The cutlist project name.
+         * @return The cut plan.
+         */
+        NestingResult nestProject(const std::string &project) const
+        {
+            std::vector<NestPart> parts;
+            // Streamed: only the parts and stock dimensions are kept, not the entities and their images
+            infra::QtSqlRepository<CustomCut>::spawn().forEach([&](const CustomCut &cut)
+                                                                {
+                if (cut.project != project)
+                    return;
+                for (int i = cut.progress_rough; i < cut.quantity; ++i)
+                {
+                    parts.push_back(NestPart{cut.id, cut.part, cut.species, cut.t, cut.w, cut.l});
+                } });
+
+            std::vector<NestStock> stock;
+            infra::QtSqlRepository<Lumber>::spawn().forEach([&](const Lumber &lumber)
+                                                            { stock.push_back(NestStock{lumber.id, StockKind::LUMBER, lumber.species.name, lumber.thickness, lumber.width, lumber.length}); });
+            infra::QtSqlRepository<LiveEdgeSlab>::spawn().forEach([&](const LiveEdgeSlab &slab)
+                                                                  { stock.push_back(NestStock{slab.id, StockKind::SLAB, slab.species.name, slab.thickness, slab.width, slab.length}); });
+            return nest(std::move(parts), stock);
+        }
+
+        /**
+         * @brief Nests parts against the given stock.
+         * @param parts Parts to place.
+         * @param stock Boards available.
+         * @return The cut plan.
+         */
+        NestingResult nest(std::vector<NestPart> parts, const std::vector<NestStock> &stock) const
+        {
+            NestingResult result;
+            result.parts = std::move(parts);
+
+            std::map<std::string, std::vector<size_t>> partsBySpecies;
+            for (size_t i = 0; i < result.parts.size(); ++i)
+            {
+                partsBySpecies[result.parts[i].species].push_back(i);
+            }
+
+            double partVolume = 0.0;
+            double boardVolume = 0.0;
+            for (auto &[species, indices] : partsBySpecies)
+            {
+                // First-fit-decreasing: biggest faces first, longest first on ties
+                std::stable_sort(indices.begin(), indices.end(), [&](size_t a, size_t b)
+                                 {
+                    const auto &pa = result.parts[a];
+                    const auto &pb = result.parts[b];
+                    double areaA = pa.length.toInches() * pa.width.toInches();
+                    double areaB = pb.length.toInches() * pb.width.toInches();
+                    if (areaA != areaB)
+                    {
+                        return areaA > areaB;
+                    }
+                    return pa.length > pb.length; });
+
+                std::vector<NestStock> candidates;
+                for (const auto &board : stock)
+                {
+                    if (board.species == species)
+                    {
+                        candidates.push_back(board);
+                    }
+                }
+                nestSpecies(result, indices, candidates, partVolume, boardVolume);
+            }
+
+            result.utilization = boardVolume > 0.0 ? partVolume / boardVolume : 0.0;
+            return result;
+        }
+
+    private:
+        struct FreeRect
+        {
+            unsigned int x, y, l, w;
+        };
+
+        struct Packing
+        {
+            std::vector<Placement> placements;
+            double partVolume{0.0};
+            double score{0.0};
+        };
+
+        static double boardFeet(Length t, Length w, Length l)
+        {
+            return geometry::boardFeet(t, w, l);
+        }
+
+        // Guillotine pack of `order` onto one board. Kerf is added to every part
+        // and to the board, so parts may sit flush against the board's edges.
+        Packing pack(const NestStock &board, const std::vector<NestPart> &parts, const std::vector<size_t> &order) const
+        {
+            const unsigned int kerf = options_.kerf.toTicks();
+            Packing packing;
+            std::vector<FreeRect> free{{0, 0, board.length.toTicks() + kerf, board.width.toTicks() + kerf}};
+
+            for (size_t index : order)
+            {
+                const auto &part = parts[index];
+                if (part.thickness > board.thickness)
+                {
+                    continue;
+                }
+                const unsigned int pl = part.length.toTicks() + kerf;
+                const unsigned int pw = part.width.toTicks() + kerf;
+
+                // Best short side fit
+                size_t bestRect = free.size();
+                unsigned int bestFit = ~0u;
+                for (size_t r = 0; r < free.size(); ++r)
+                {
+                    if (free[r].l >= pl && free[r].w >= pw)
+                    {
+                        unsigned int fit = std::min(free[r].l - pl, free[r].w - pw);
+                        if (fit < bestFit)
+                        {
+                            bestFit = fit;
+                            bestRect = r;
+                        }
+                    }
+                }
+                if (bestRect == free.size())
+                {
+                    continue;
+                }
+
+                FreeRect rect = free[bestRect];
+                free[bestRect] = free.back();
+                free.pop_back();
+                packing.placements.push_back(Placement{index, Length::fromTicks(rect.x), Length::fromTicks(rect.y)});
+                packing.partVolume += boardFeet(part.thickness, part.width, part.length);
+
+                // Split along the shorter leftover so the larger offcut stays whole
+                FreeRect right, top;
+                if (rect.l - pl < rect.w - pw)
+                {
+                    right = {rect.x + pl, rect.y, rect.l - pl, pw};
+                    top = {rect.x, rect.y + pw, rect.l, rect.w - pw};
+                }
+                else
+                {
+                    right = {rect.x + pl, rect.y, rect.l - pl, rect.w};
+                    top = {rect.x, rect.y + pw, pl, rect.w - pw};
+                }
+                if (right.l > kerf && right.w > kerf)
+                {
+                    free.push_back(right);
+                }
+                if (top.l > kerf && top.w > kerf)
+                {
+                    free.push_back(top);
+                }
+            }
+
+            double volume = boardFeet(board.thickness, board.width, board.length);
+            packing.score = volume > 0.0 ? packing.partVolume / volume : 0.0;
+            return packing;
+        }
+
+        void nestSpecies(NestingResult &result, std::vector<size_t> remaining, const std::vector<NestStock> &stock,
+                         double &partVolume, double &boardVolume) const
+        {
+            // Identical boards pack identically, so only one of each size is scored
+            std::map<std::tuple<unsigned int, unsigned int, unsigned int>, std::vector<size_t>> classes;
+            for (size_t i = 0; i < stock.size(); ++i)
+            {
+                classes[{stock[i].thickness.toTicks(), stock[i].width.toTicks(), stock[i].length.toTicks()}].push_back(i);
+            }
+            std::vector<std::vector<size_t>> open;
+            for (auto &entry : classes)
+            {
+                open.push_back(std::move(entry.second));
+            }
+
+            unsigned int threadCount = options_.threads != 0 ? options_.threads : std::max(1u, std::thread::hardware_concurrency());
+
+            while (!remaining.empty() && !open.empty())
+            {
+                std::vector<Packing> packings(open.size());
+                std::atomic<size_t> next{0};
+                auto worker = [&]()
+                {
+                    for (size_t c = next++; c < open.size(); c = next++)
+                    {
+                        packings[c] = pack(stock[open[c].back()], result.parts, remaining);
+                    }
+                };
+                std::vector<std::thread> workers;
+                for (unsigned int t = 1; t < std::min<size_t>(threadCount, open.size()); ++t)
+                {
+                    workers.emplace_back(worker);
+                }
+                worker();
+                for (auto &thread : workers)
+                {
+                    thread.join();
+                }
+
+                // A size that holds nothing now never will, since parts only go away
+                size_t best = open.size();
+                std::vector<std::vector<size_t>> stillOpen;
+                std::vector<Packing> stillPackings;
+                for (size_t c = 0; c < open.size(); ++c)
+                {
+                    if (packings[c].placements.empty())
+                    {
+                        continue;
+                    }
+                    if (best == open.size() || packings[c].score > stillPackings[best].score)
+                    {
+                        best = stillOpen.size();
+                    }
+                    stillOpen.push_back(std::move(open[c]));
+                    stillPackings.push_back(std::move(packings[c]));
+                }
+                open = std::move(stillOpen);
+                if (open.empty())
+                {
+                    break;
+                }
+
+                BoardLayout layout;
+                layout.stock = stock[open[best].back()];
+                layout.placements = std::move(stillPackings[best].placements);
+                double volume = boardFeet(layout.stock.thickness, layout.stock.width, layout.stock.length);
+                layout.wasteBoardFeet = volume - stillPackings[best].partVolume;
+                result.wasteBoardFeet += layout.wasteBoardFeet;
+                partVolume += stillPackings[best].partVolume;
+                boardVolume += volume;
+
+                std::vector<bool> placed(result.parts.size(), false);
+                for (const auto &placement : layout.placements)
+                {
+                    placed[placement.part] = true;
+                }
+                remaining.erase(std::remove_if(remaining.begin(), remaining.end(), [&](size_t i)
+                                               { return placed[i]; }),
+                                remaining.end());
+                result.boards.push_back(std::move(layout));
+
+                open[best].pop_back();
+                if (open[best].empty())
+                {
+                    open.erase(open.begin() + static_cast<std::ptrdiff_t>(best));
+                }
+            }
+
+            result.unplaced.insert(result.unplaced.end(), remaining.begin(), remaining.end());
+        }
+
+        NestingOptions options_;
+    };
+}
@@ -0,0 +1,157 @@
+/**
+ * @file rip_planner.hpp
+ * @brief Defines the RipPlanner, which chooses the most valuable mix of board widths to rip from a slab.
+ */
+
+#pragma once
+
+#include "domain/lumber_cutter.hpp"
+#include "domain/units.hpp"
+
+#include <vector>
+#include <algorithm>
+
+namespace woodworks::domain::lumber
+{
+    /**
+     * @struct RipWidth
+     * @brief A sellable board width and what an inch of it is worth.
+     */
+    struct RipWidth
+    {
+        Length width;
+        double centsPerInch{0.0};
+    };
+
+    /**
+     * @struct RipPlannerOptions
+     * @brief Inputs for a rip plan.
+     */
+    struct RipPlannerOptions
+    {
+        /** @brief Widths the planner may rip. */
+        std::vector<RipWidth> widths;
+        /** @brief Material lost to each rip cut. */
+        Length kerf{Length::fromTicks(2)};
+        /** @brief Live edge trimmed off each side before ripping. */
+        Length trimWidth{Length::fromTicks(0)};
+    };
+
+    /**
+     * @struct RipPlan
+     * @brief Board widths to rip, widest first.
+     */
+    struct RipPlan
+    {
+        std::vector<Length> boards;
+        /** @brief Value of all boards, in cents. */
+        double valueCents{0.0};
+        /** @brief Slab width not going into boards, trim and kerf included. */
+        Length waste{Length::fromTicks(0)};
+
+        /**
+         * @brief Loads this plan into a cutter, replacing its planned boards.
+         * @param cutter The cutter the plan was made for.
+         */
+        void applyTo(LumberCutter &cutter) const
+        {
+            cutter.plannedBoards.clear();
+            for (const auto &width : boards)
+            {
+                cutter.plannedBoards.push_back({width, cutter.slab.thickness});
+            }
+            cutter.boardCount = static_cast<int>(boards.size());
+            cutter.waste = waste;
+        }
+    };
+
+    /**
+     * @class RipPlanner
+     * @brief Unbounded knapsack over the slab width in 1/16" ticks.
+     *
+     * Every board costs its width plus one kerf. The last board needs no kerf
+     * after it, so the capacity is the usable width plus one kerf. A run is
+     * O(ticks * widths), a few thousand steps for a typical slab, so it can be
+     * recomputed on every input change.
+     */
+    class RipPlanner
+    {
+    public:
+        explicit RipPlanner(RipPlannerOptions options) : options_(std::move(options)) {}
+
+        /**
+         * @brief Plans the rip for a slab.
+         * @param slab The slab to rip.
+         * @return The most valuable plan; empty if nothing fits.
+         */
+        RipPlan plan(const LiveEdgeSlab &slab) const
+        {
+            return plan(slab.width);
+        }
+
+        /**
+         * @brief Plans the rip for a given slab width.
+         * @param slabWidth Full width of the slab, before trimming.
+         * @return The most valuable plan; empty if nothing fits.
+         */
+        RipPlan plan(Length slabWidth) const
+        {
+            RipPlan result;
+            const unsigned int trim = options_.trimWidth.toTicks() * 2;
+            if (trim >= slabWidth.toTicks())
+            {
+                result.waste = slabWidth;
+                return result;
+            }
+            const unsigned int avail = slabWidth.toTicks() - trim;
+            const unsigned int kerf = options_.kerf.toTicks();
+            const unsigned int capacity = avail + kerf;
+
+            // best[c]: most value in c ticks; choice[c]: width index taken last, or -1
+            std::vector<double> best(capacity + 1, 0.0);
+            std::vector<int> choice(capacity + 1, -1);
+            for (unsigned int c = 1; c <= capacity; ++c)
+            {
+                best[c] = best[c - 1];
+                choice[c] = -1;
+                for (size_t i = 0; i < options_.widths.size(); ++i)
+                {
+                    const auto &option = options_.widths[i];
+                    const unsigned int cost = option.width.toTicks() + kerf;
+                    if (option.width.toTicks() == 0 || cost > c)
+                    {
+                        continue;
+                    }
+                    double value = best[c - cost] + option.width.toInches() * option.centsPerInch;
+                    if (value > best[c])
+                    {
+                        best[c] = value;
+                        choice[c] = static_cast<int>(i);
+                    }
+                }
+            }
+
+            unsigned int used = 0;
+            for (unsigned int c = capacity; c > 0;)
+            {
+                if (choice[c] < 0)
+                {
+                    --c;
+                    continue;
+                }
+                Length width = options_.widths[static_cast<size_t>(choice[c])].width;
+                result.boards.push_back(width);
+                used += width.toTicks();
+                c -= width.toTicks() + kerf;
+            }
+            std::sort(result.boards.begin(), result.boards.end(), [](Length a, Length b)
+                      { return a > b; });
+            result.valueCents = best[capacity];
+            result.waste = Length::fromTicks(slabWidth.toTicks() - used);
+            return result;
+        }
+
+    private:
+        RipPlannerOptions options_;
+    };
+}
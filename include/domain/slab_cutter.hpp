@@ -3,10 +3,14 @@
  * @brief Defines the SlabCutter class and related structures for processing logs into slabs.
  */
 
+#pragma once
+
 #include "log.hpp"
 #include "domain/live_edge_slab.hpp"
 #include "domain/units.hpp"
 #include "domain/types.hpp"
+#include "domain/geometry_kernels.hpp"
+#include "domain/width_profile.hpp"
 #include "infra/repository.hpp"
 
 #include <vector>
@@ -58,7 +62,20 @@ namespace woodworks::domain::slabs
          * @brief Constructs a SlabCutter with the given log.
          * @param sourceLog The log to be processed.
          */
-        explicit SlabCutter(const Log &sourceLog) : log(sourceLog), logDiameterUsed(Length::fromTicks(0)) {}
+        explicit SlabCutter(const Log &sourceLog) : log(sourceLog), logDiameterUsed(Length::fromTicks(0)), profile(sourceLog.diameter) {}
+
+        /**
+         * @brief The chord width profile of the log, built once and rebuilt only if the diameter changes.
+         * @return The log's width profile.
+         */
+        const LogWidthProfile &widthProfile() const
+        {
+            if (profile.diameter() != log.diameter)
+            {
+                profile = LogWidthProfile(log.diameter);
+            }
+            return profile;
+        }
 
         // Remaining diameter of the log
         Length getRemainingDiameter() const
@@ -87,15 +104,9 @@ namespace woodworks::domain::slabs
          */
         Length slabWidthAtThickness(Length thickness) const
         {
-            if (thickness + logDiameterUsed > log.diameter)
-            {
-                return getWidthAtOffset(logDiameterUsed);
-            }
-
-            // Otherwise, the average of the width at the current used and the width at the current used + thickness
-            Length widthAtCurrent = getWidthAtOffset(logDiameterUsed);
-            Length widthAtCurrentPlusThickness = getWidthAtOffset(logDiameterUsed + thickness);
-            return (widthAtCurrent + widthAtCurrentPlusThickness) / 2;
+            // The average of the width at the current used and the width at the current used + thickness,
+            // or just the current width if the slab runs past the far edge
+            return widthProfile().slabWidth(logDiameterUsed, thickness);
         }
 
         /**
@@ -104,12 +115,16 @@ namespace woodworks::domain::slabs
          */
         void addSlab(Length thickness)
         {
+            redoCuts.clear();
+            cutStarts.push_back(logDiameterUsed);
+
             if (thickness + logDiameterUsed > log.diameter)
             {
                 // Use from now to the diameter of the log
-                InProgressSlab slab = {thickness, slabWidthAtThickness(Length::fromFeet(0))};
+                InProgressSlab slab = {getRemainingDiameter(), slabWidthAtThickness(thickness)};
                 plannedCuts.push_back(slab);
                 logDiameterUsed = log.diameter;
+                return;
             }
 
             // Add the slab to the planned cuts
@@ -127,17 +142,44 @@ namespace woodworks::domain::slabs
             {
                 return;
             }
-            // Remove the last cut
-            logDiameterUsed = logDiameterUsed - plannedCuts.back().thickness;
+            // Remove the last cut, returning to where it started
+            Length start = cutStarts.size() == plannedCuts.size() ? cutStarts.back() : logDiameterUsed - plannedCuts.back().thickness;
+            redoCuts.push_back({plannedCuts.back(), start, logDiameterUsed});
+            logDiameterUsed = start;
             plannedCuts.pop_back();
+            if (!cutStarts.empty())
+            {
+                cutStarts.pop_back();
+            }
         }
 
+        /**
+         * @brief Redoes the last undone cut.
+         */
+        void redoCut()
+        {
+            if (redoCuts.empty())
+            {
+                return;
+            }
+            auto cut = redoCuts.back();
+            redoCuts.pop_back();
+            plannedCuts.push_back(cut.slab);
+            cutStarts.push_back(cut.start);
+            logDiameterUsed = cut.end;
+        }
+
+        bool canUndo() const { return !plannedCuts.empty(); }
+        bool canRedo() const { return !redoCuts.empty(); }
+
         /**
          * @brief Clears all planned cuts.
          */
         void clearPlannedCuts()
         {
             plannedCuts.clear();
+            cutStarts.clear();
+            redoCuts.clear();
             logDiameterUsed = Length::fromTicks(0);
         }
 
@@ -164,13 +206,16 @@ namespace woodworks::domain::slabs
          */
         vector<LiveEdgeSlab> completeCuts(Length cutLength, optional<string> location, optional<string> notes)
         {
-            // First, calculate the total volume of all slabs cut (approx)
-            double totalVolumeInCubed = 0;
+            // First, calculate the volume of each slab cut (approx) and the total
+            woodworks::domain::geometry::BoardColumns columns;
+            columns.reserve(plannedCuts.size());
             for (const auto &plannedSlab : plannedCuts)
             {
-                // Volume = length * width * thickness
-                totalVolumeInCubed += cutLength.toFeet() * plannedSlab.width.toFeet() * plannedSlab.thickness.toFeet();
+                columns.push(plannedSlab.thickness, plannedSlab.width, cutLength);
             }
+            vector<double> volumes(columns.size());
+            woodworks::domain::geometry::boardFeet(columns, volumes.data());
+            double totalVolume = woodworks::domain::geometry::sum(volumes.data(), volumes.size());
 
             // That volume gives us a good measure to get the cost
             vector<LiveEdgeSlab> slabs;
@@ -178,10 +223,9 @@ namespace woodworks::domain::slabs
             Dollar cutWorth = log.cut(cutLength);
             int cents = cutWorth.toCents();
 
-            for (auto plannedSlab : plannedCuts)
+            for (size_t i = 0; i < plannedCuts.size(); ++i)
             {
-                // Volume of this slab
-                double volume = cutLength.toFeet() * plannedSlab.width.toFeet() * plannedSlab.thickness.toFeet();
+                const auto &plannedSlab = plannedCuts[i];
 
                 // Create the slab
                 LiveEdgeSlab slab = LiveEdgeSlab::uninitialized();
@@ -191,7 +235,7 @@ namespace woodworks::domain::slabs
                 slab.thickness = plannedSlab.thickness;
                 slab.drying = log.drying;
                 slab.surfacing = SlabSurfacing::RGH;
-                slab.worth = Dollar(static_cast<int>(cents * (volume / totalVolumeInCubed)));
+                slab.worth = Dollar(totalVolume > 0 ? static_cast<int>(cents * (volumes[i] / totalVolume)) : 0);
 
                 if (location.has_value())
                 {
@@ -212,6 +256,21 @@ namespace woodworks::domain::slabs
         }
 
     private:
+        // An undone cut, with where it started and where the next cut would have started
+        struct UndoneCut
+        {
+            InProgressSlab slab;
+            Length start;
+            Length end;
+        };
+
+        /** @brief Chord widths across the log, see widthProfile(). */
+        mutable LogWidthProfile profile;
+        /** @brief Diameter used before each planned cut, parallel to plannedCuts. */
+        vector<Length> cutStarts;
+        /** @brief Undone cuts, most recent last. */
+        vector<UndoneCut> redoCuts;
+
         /**
          * @brief Calculates the width of a cut parallel to the log centerline at a given offset.
          * @param offset The offset from the log centerline.
@@ -219,14 +278,8 @@ namespace woodworks::domain::slabs
          */
         Length getWidthAtOffset(Length offset) const
         {
-            if (offset > log.length)
-            {
-                return Length::fromTicks(0);
-            }
-
-            // 2 * sqrt(x(D-x))
-            return Length::fromTicks(
-                2 * sqrt(offset.toTicks() * (log.diameter.toTicks() - offset.toTicks())));
+            // 2 * sqrt(x(D-x)), from the profile
+            return widthProfile().chordAt(offset);
         }
     };
 }
\ No newline at end of file
@@ -0,0 +1,317 @@
+/**
+ * @file slab_planner.hpp
+ * @brief Defines the SlabPlanner, which searches slab cutting patterns for a log.
+ */
+
+#pragma once
+
+#include "domain/slab_cutter.hpp"
+#include "domain/geometry_kernels.hpp"
+#include "domain/width_profile.hpp"
+#include "domain/units.hpp"
+#include "domain/types.hpp"
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace woodworks::domain::slabs
+{
+    /**
+     * @enum PlanObjective
+     * @brief What the planner tries to maximize.
+     */
+    enum class PlanObjective : uint8_t
+    {
+        VALUE, ///< Total price of the slabs, using the thickness and width weights.
+        YIELD  ///< Total board feet of the slabs.
+    };
+
+    /**
+     * @struct ThicknessOption
+     * @brief A slab thickness the planner may cut, with its price per board foot.
+     */
+    struct ThicknessOption
+    {
+        Length thickness;
+        double centsPerBoardFoot{0.0};
+    };
+
+    /**
+     * @struct WidthTier
+     * @brief Price multiplier applied to slabs at least minWidth wide.
+     */
+    struct WidthTier
+    {
+        Length minWidth;
+        double multiplier{1.0};
+    };
+
+    /**
+     * @struct SlabPlannerOptions
+     * @brief Inputs for a planning run.
+     */
+    struct SlabPlannerOptions
+    {
+        /** @brief Thicknesses the planner may choose from. */
+        std::vector<ThicknessOption> thicknesses;
+        /** @brief Material lost to the saw blade between slabs. */
+        Length kerf{Length::fromTicks(2)};
+        /** @brief Slabs narrower than this are never planned. */
+        Length minWidth{Length::fromTicks(0)};
+        /** @brief Width multipliers; the widest tier a slab reaches applies. */
+        std::vector<WidthTier> widthTiers;
+        /** @brief Whether to maximize value or yield. */
+        PlanObjective objective{PlanObjective::VALUE};
+        /** @brief Number of distinct plans to return. */
+        size_t maxPlans{3};
+    };
+
+    /**
+     * @struct SlabPlan
+     * @brief One cutting pattern, in the same form SlabCutter::plannedCuts uses.
+     */
+    struct SlabPlan
+    {
+        /** @brief Planned slabs, ready for SlabCutter::completeCuts. */
+        std::vector<InProgressSlab> cuts;
+        /** @brief Offset across the diameter at which each slab starts. */
+        std::vector<Length> offsets;
+        /** @brief Diameter used once the plan (and its kerfs) is cut. */
+        Length endOffset{Length::fromTicks(0)};
+        /** @brief Estimated price of all slabs, in cents. */
+        double valueCents{0.0};
+        /** @brief Board feet of all slabs. */
+        double boardFeet{0.0};
+        /** @brief The objective score the plan was ranked by. */
+        double score{0.0};
+
+        /**
+         * @brief Appends this plan to a cutter, after the cuts already planned.
+         *
+         * The plan starts where the cutter's used diameter stood when it was
+         * made, so slabs planned by hand before then are kept.
+         * @param cutter The cutter the plan was made for.
+         */
+        void applyTo(SlabCutter &cutter) const
+        {
+            // Added one at a time so each cut can be undone on its own
+            for (size_t i = 0; i < cuts.size(); ++i)
+            {
+                cutter.logDiameterUsed = offsets[i];
+                cutter.addSlab(cuts[i].thickness);
+            }
+            cutter.logDiameterUsed = endOffset;
+        }
+    };
+
+    /**
+     * @class SlabPlanner
+     * @brief Finds the best slab cutting patterns for a log.
+     *
+     * Runs a k-best dynamic program over the remaining diameter in 1/16" ticks.
+     * At every offset the saw either skips a tick or cuts one of the allowed
+     * thicknesses (plus kerf), so the result is optimal for the chosen objective
+     * over all tick-aligned patterns. Widths use the same chord formula as
+     * SlabCutter, so a plan applied to the cutter matches what addSlab would give.
+     */
+    class SlabPlanner
+    {
+    public:
+        explicit SlabPlanner(SlabPlannerOptions options) : options_(std::move(options))
+        {
+            if (options_.thicknesses.empty())
+            {
+                throw std::invalid_argument("SlabPlanner needs at least one thickness");
+            }
+            for (const auto &option : options_.thicknesses)
+            {
+                if (option.thickness.toTicks() == 0)
+                {
+                    throw std::invalid_argument("SlabPlanner thickness must be positive");
+                }
+            }
+            if (options_.maxPlans == 0)
+            {
+                options_.maxPlans = 1;
+            }
+        }
+
+        /**
+         * @brief Plans the rest of the cutter's log, starting at its used diameter.
+         * @param cutter The cutter holding the log.
+         * @return Up to maxPlans distinct plans, best first.
+         */
+        std::vector<SlabPlan> plan(const SlabCutter &cutter) const
+        {
+            return plan(cutter.log, cutter.logDiameterUsed, cutter.widthProfile());
+        }
+
+        /**
+         * @brief Plans a log from a starting offset across its diameter.
+         * @param log The log to plan.
+         * @param start Diameter already used.
+         * @return Up to maxPlans distinct plans, best first.
+         */
+        std::vector<SlabPlan> plan(const Log &log, Length start) const
+        {
+            return plan(log, start, LogWidthProfile(log.diameter));
+        }
+
+        /**
+         * @brief Plans a log using an already built width profile.
+         * @param log The log to plan.
+         * @param start Diameter already used.
+         * @param profile Width profile of the log.
+         * @return Up to maxPlans distinct plans, best first.
+         */
+        std::vector<SlabPlan> plan(const Log &log, Length start, const LogWidthProfile &profile) const
+        {
+            const unsigned int diameter = log.diameter.toTicks();
+            const unsigned int first = std::min(start.toTicks(), diameter);
+            const unsigned int kerf = options_.kerf.toTicks();
+            // Keep a wider beam per offset than we return, since plans that share
+            // a thickness sequence are collapsed as they propagate.
+            const size_t beam = options_.maxPlans * 4;
+
+            // best[p] holds the top partial plans that cut [p, diameter]
+            std::vector<std::vector<Partial>> best(diameter + 2);
+            best[diameter].push_back(Partial{});
+            best[diameter + 1].push_back(Partial{});
+
+            for (unsigned int p = diameter; p-- > first;)
+            {
+                std::vector<Partial> candidates = best[p + 1];
+                for (size_t i = 0; i < options_.thicknesses.size(); ++i)
+                {
+                    const auto &option = options_.thicknesses[i];
+                    const unsigned int t = option.thickness.toTicks();
+                    if (p + t > diameter)
+                    {
+                        continue;
+                    }
+                    Length width = profile.slabWidth(Length::fromTicks(p), option.thickness);
+                    if (width < options_.minWidth || width.toTicks() == 0)
+                    {
+                        continue;
+                    }
+                    double boardFeet = geometry::boardFeet(option.thickness, width, log.length);
+                    double value = boardFeet * option.centsPerBoardFoot * widthMultiplier(width);
+                    double score = options_.objective == PlanObjective::VALUE ? value : boardFeet;
+
+                    unsigned int next = std::min(p + t + kerf, diameter);
+                    for (size_t tail = 0; tail < best[next].size(); ++tail)
+                    {
+                        const auto &rest = best[next][tail];
+                        Partial partial;
+                        partial.score = rest.score + score;
+                        partial.valueCents = rest.valueCents + value;
+                        partial.boardFeet = rest.boardFeet + boardFeet;
+                        partial.sequence = rest.sequence * SEQUENCE_PRIME + i + 1;
+                        partial.option = static_cast<int>(i);
+                        partial.start = p;
+                        partial.next = next;
+                        partial.tail = tail;
+                        candidates.push_back(partial);
+                    }
+                }
+                best[p] = keepBest(std::move(candidates), beam);
+            }
+
+            std::vector<SlabPlan> plans;
+            for (const auto &partial : keepBest(best[first], options_.maxPlans))
+            {
+                if (partial.option < 0)
+                {
+                    continue;
+                }
+                SlabPlan plan;
+                plan.score = partial.score;
+                plan.valueCents = partial.valueCents;
+                plan.boardFeet = partial.boardFeet;
+                // Follow the tail links back out to the far edge
+                for (const Partial *cut = &partial; cut->option >= 0; cut = &best[cut->next][cut->tail])
+                {
+                    const auto &option = options_.thicknesses[static_cast<size_t>(cut->option)];
+                    plan.cuts.push_back(InProgressSlab{option.thickness, profile.slabWidth(Length::fromTicks(cut->start), option.thickness)});
+                    plan.offsets.push_back(Length::fromTicks(cut->start));
+                    plan.endOffset = Length::fromTicks(cut->next);
+                }
+                plans.push_back(std::move(plan));
+            }
+            return plans;
+        }
+
+        /**
+         * @brief Width of a cut parallel to the log centerline, 2 * sqrt(x(D-x)).
+         * @param diameter The log diameter.
+         * @param offset The offset from the edge of the log.
+         * @return The chord width at the offset.
+         */
+        static Length chordWidth(Length diameter, Length offset)
+        {
+            return geometry::chordWidth(diameter, offset);
+        }
+
+    private:
+        static constexpr uint64_t SEQUENCE_PRIME = 1099511628211ull;
+
+        // A plan for [p, diameter], stored as its first cut plus a link to the
+        // rest in best[next][tail], so extending a plan is O(1)
+        struct Partial
+        {
+            double score{0.0};
+            double valueCents{0.0};
+            double boardFeet{0.0};
+            uint64_t sequence{0};   // hash of the thickness sequence, for deduplication
+            int option{-1};         // first cut's thickness option; -1 means no cuts
+            unsigned int start{0};  // first cut's start tick
+            unsigned int next{0};
+            size_t tail{0};
+        };
+
+        double widthMultiplier(Length width) const
+        {
+            double multiplier = 1.0;
+            Length reached = Length::fromTicks(0);
+            for (const auto &tier : options_.widthTiers)
+            {
+                if (width >= tier.minWidth && tier.minWidth >= reached)
+                {
+                    reached = tier.minWidth;
+                    multiplier = tier.multiplier;
+                }
+            }
+            return multiplier;
+        }
+
+        // Sort by score and keep the best `count` distinct thickness sequences
+        static std::vector<Partial> keepBest(std::vector<Partial> candidates, size_t count)
+        {
+            std::stable_sort(candidates.begin(), candidates.end(),
+                             [](const Partial &a, const Partial &b)
+                             { return a.score > b.score; });
+            std::vector<Partial> kept;
+            kept.reserve(count);
+            for (auto &candidate : candidates)
+            {
+                if (kept.size() >= count)
+                {
+                    break;
+                }
+                bool duplicate = std::any_of(kept.begin(), kept.end(),
+                                             [&](const Partial &k)
+                                             { return k.sequence == candidate.sequence; });
+                if (!duplicate)
+                {
+                    kept.push_back(candidate);
+                }
+            }
+            return kept;
+        }
+
+        SlabPlannerOptions options_;
+    };
+}
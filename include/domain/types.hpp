@@ -19,10 +19,23 @@ namespace woodworks::domain::types
      * @brief Contains types and enumerations for species, IDs, dollar values, quality, and surfacing states.
      */
 
-    // Species
+    /**
+     * @struct Species
+     * @brief A wood species by name, with its interned key once it has been read from or written to the database.
+     *
+     * Keys are unique per name, so two species with keys compare as integers.
+     * Assign a whole Species to change it; the key describes the name it was read with.
+     */
     struct Species
     {
         std::string name;
+        int id{0}; ///< Key in the species table; 0 if not known.
+
+        bool operator==(const Species &other) const
+        {
+            return id != 0 && other.id != 0 ? id == other.id : name == other.name;
+        }
+        bool operator!=(const Species &other) const { return !(*this == other); }
     };
 
     /**
@@ -0,0 +1,85 @@
+/**
+ * @file width_profile.hpp
+ * @brief Defines LogWidthProfile, a precomputed table of chord widths across a log.
+ */
+
+#pragma once
+
+#include "domain/units.hpp"
+#include "domain/geometry_kernels.hpp"
+
+#include <vector>
+#include <cstdint>
+
+namespace woodworks::domain::slabs
+{
+    using imperial::Length;
+
+    /**
+     * @class LogWidthProfile
+     * @brief Chord widths and cumulative cross-section area at every tick across a log's diameter.
+     *
+     * Built once per log with the batch chord kernel, after which every width or
+     * area query for an (offset, thickness) pair is two table lookups. Widths
+     * are identical to geometry::chordWidth.
+     */
+    class LogWidthProfile
+    {
+    public:
+        LogWidthProfile() : LogWidthProfile(Length::fromTicks(0)) {}
+
+        explicit LogWidthProfile(Length diameter)
+            : diameter_(diameter), chords_(geometry::chordWidthProfile(diameter)), prefixArea_(chords_.size() + 1, 0)
+        {
+            for (size_t x = 0; x < chords_.size(); ++x)
+            {
+                prefixArea_[x + 1] = prefixArea_[x] + chords_[x];
+            }
+        }
+
+        /** @brief Diameter the profile was built for. */
+        Length diameter() const { return diameter_; }
+
+        /**
+         * @brief Chord width at an offset from the edge of the log.
+         * @return Zero past the far edge.
+         */
+        Length chordAt(Length offset) const
+        {
+            return offset > diameter_ ? Length::fromTicks(0) : Length::fromTicks(chords_[offset.toTicks()]);
+        }
+
+        /**
+         * @brief Width credited to a slab, the average of its two faces.
+         * @param offset Where the slab starts.
+         * @param thickness Slab thickness.
+         * @return The slab width; a slab running past the far edge gets the width of its near face.
+         */
+        Length slabWidth(Length offset, Length thickness) const
+        {
+            if (offset + thickness > diameter_)
+            {
+                return chordAt(offset);
+            }
+            return (chordAt(offset) + chordAt(offset + thickness)) / 2;
+        }
+
+        /**
+         * @brief Cross-section area of the log between two offsets, in square inches.
+         * @param offset Where the band starts.
+         * @param thickness Band thickness; clamped to the far edge.
+         */
+        double crossSectionArea(Length offset, Length thickness) const
+        {
+            uint32_t end = static_cast<uint32_t>(chords_.size());
+            uint32_t from = offset.toTicks() < end ? offset.toTicks() : end;
+            uint32_t to = offset.toTicks() + thickness.toTicks() < end ? offset.toTicks() + thickness.toTicks() : end;
+            return static_cast<double>(prefixArea_[to] - prefixArea_[from]) / (geometry::TICKS_PER_INCH * geometry::TICKS_PER_INCH);
+        }
+
+    private:
+        Length diameter_;
+        std::vector<uint32_t> chords_;      // chords_[x] = chord width x ticks from the edge
+        std::vector<uint64_t> prefixArea_;  // prefixArea_[x] = sum of chords_[0..x)
+    };
+}
@@ -0,0 +1,380 @@
+/**
+ * @file yard_planner.hpp
+ * @brief Defines the YardPlanner, which assigns logs in the yard to a list of orders.
+ */
+
+#pragma once
+
+#include "domain/log.hpp"
+#include "domain/slab_planner.hpp"
+#include "domain/units.hpp"
+#include "domain/types.hpp"
+
+#include <vector>
+#include <string>
+#include <map>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+
+/**
+ * @namespace woodworks::domain::yard
+ * @brief Contains the whole-yard batch planner.
+ */
+namespace woodworks::domain::yard
+{
+    /**
+     * @enum DemandKind
+     * @brief What an order asks for.
+     */
+    enum class DemandKind : uint8_t
+    {
+        SLAB,   ///< Live edge slabs at least `width` wide
+        LUMBER, ///< Boards ripped to exactly `width`
+        COOKIE  ///< Cookies from logs at least `width` in diameter
+    };
+
+    /**
+     * @struct Demand
+     * @brief One line of the demand list.
+     */
+    struct Demand
+    {
+        DemandKind kind{DemandKind::SLAB};
+        /** @brief Species wanted; empty takes any species. */
+        std::string species;
+        Length thickness{Length::fromTicks(0)};
+        Length width{Length::fromTicks(0)};
+        /** @brief Piece length; unused for cookies. */
+        Length length{Length::fromTicks(0)};
+        int quantity{0};
+        double centsEach{0.0};
+    };
+
+    /**
+     * @struct LogAssignment
+     * @brief A log dedicated to one demand line.
+     */
+    struct LogAssignment
+    {
+        Id logId{-1};
+        size_t demand{0};
+        /** @brief Pieces the log goes toward the demand. */
+        int pieces{0};
+        /** @brief Pieces the log could produce, if the order were larger. */
+        int capacity{0};
+        double valueCents{0.0};
+    };
+
+    /**
+     * @struct YardPlan
+     * @brief A full or partial plan for the yard.
+     */
+    struct YardPlan
+    {
+        std::vector<LogAssignment> assignments;
+        /** @brief Pieces planned for each demand line. */
+        std::vector<int> filled;
+        /** @brief Demand lines planned in full. */
+        size_t ordersFilled{0};
+        double valueCents{0.0};
+        size_t logsEvaluated{0};
+        size_t logsTotal{0};
+        /** @brief False while the planner is still evaluating logs. */
+        bool complete{false};
+    };
+
+    /**
+     * @struct YardPlannerOptions
+     * @brief Settings for a planning run.
+     */
+    struct YardPlannerOptions
+    {
+        Length kerf{Length::fromTicks(2)};
+        /** @brief Added to a log's score when it finishes a demand line, so whole orders win ties. */
+        double orderFilledBonusCents{100.0};
+        /** @brief Worker threads evaluating logs; 0 uses every core. */
+        unsigned int threads{0};
+        /** @brief Logs evaluated between partial plans. */
+        size_t batchSize{64};
+    };
+
+    /**
+     * @class YardPlanner
+     * @brief Evaluates every log against every demand in parallel, then assigns logs greedily.
+     *
+     * Each log is dedicated to a single demand line. Worker threads work out how
+     * many pieces each log yields for each line, using SlabPlanner for slabs and
+     * lumber. As each batch of logs is evaluated the calling thread reruns the
+     * assignment over everything seen so far and passes the partial plan to the
+     * progress callback. The assignment is lazy greedy on marginal value: a stale
+     * heap entry is re-scored when it surfaces and pushed back if it fell. A
+     * log's worth to a demand mostly falls as the demand fills, except that the
+     * order-filled bonus makes it rise once the log could finish the line; those
+     * logs get fresh entries when the line's remainder drops to their yield.
+     *
+     * The planner does no database work, so it can run off the GUI thread; load
+     * the logs with the repository first.
+     */
+    class YardPlanner
+    {
+    public:
+        using Progress = std::function<void(const YardPlan &)>;
+
+        explicit YardPlanner(YardPlannerOptions options = {}) : options_(options) {}
+
+        /**
+         * @brief Plans the yard.
+         * @param logs Logs available to cut.
+         * @param demands The demand list.
+         * @param progress Called on this thread with each partial plan and the final one.
+         * @param cancel Optional flag; when set the planner returns what it has.
+         * @return The final plan.
+         */
+        YardPlan plan(const std::vector<Log> &logs, const std::vector<Demand> &demands,
+                      const Progress &progress = {}, const std::atomic<bool> *cancel = nullptr) const
+        {
+            // yields[i][j]: pieces log i can give demand j
+            std::vector<std::vector<int>> yields(logs.size());
+            std::vector<size_t> done;
+            done.reserve(logs.size());
+            std::mutex mutex;
+            std::condition_variable ready;
+            std::atomic<size_t> next{0};
+            size_t workersDone = 0;
+
+            auto worker = [&]()
+            {
+                for (size_t i = next++; i < logs.size(); i = next++)
+                {
+                    if (cancel && cancel->load())
+                    {
+                        break;
+                    }
+                    auto logYields = evaluate(logs[i], demands);
+                    std::lock_guard<std::mutex> lock(mutex);
+                    yields[i] = std::move(logYields);
+                    done.push_back(i);
+                    ready.notify_one();
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                ++workersDone;
+                ready.notify_one();
+            };
+
+            unsigned int threadCount = options_.threads != 0 ? options_.threads : std::max(1u, std::thread::hardware_concurrency());
+            std::vector<std::thread> workers;
+            for (unsigned int t = 0; t < std::min<size_t>(threadCount, std::max<size_t>(logs.size(), 1)); ++t)
+            {
+                workers.emplace_back(worker);
+            }
+
+            YardPlan plan;
+            size_t reported = 0;
+            const size_t batch = std::max<size_t>(options_.batchSize, 1);
+            while (true)
+            {
+                std::vector<size_t> evaluated;
+                bool finished;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    ready.wait(lock, [&]()
+                               { return done.size() >= reported + batch || workersDone == workers.size(); });
+                    evaluated = done;
+                    finished = workersDone == workers.size();
+                }
+                if (evaluated.size() > reported || finished)
+                {
+                    plan = assign(logs, demands, yields, evaluated);
+                    plan.logsTotal = logs.size();
+                    plan.complete = finished && evaluated.size() == logs.size();
+                    reported = evaluated.size();
+                    if (progress)
+                    {
+                        progress(plan);
+                    }
+                }
+                if (finished)
+                {
+                    break;
+                }
+            }
+
+            for (auto &thread : workers)
+            {
+                thread.join();
+            }
+            return plan;
+        }
+
+        /**
+         * @brief Pieces one log can give each demand line if dedicated to it.
+         * @param log The log.
+         * @param demands The demand list.
+         * @return One count per demand line.
+         */
+        std::vector<int> evaluate(const Log &log, const std::vector<Demand> &demands) const
+        {
+            std::vector<int> result(demands.size(), 0);
+            const unsigned int kerf = options_.kerf.toTicks();
+            // Every slab and lumber demand plans the same log, so share one width profile
+            const slabs::LogWidthProfile profile(log.diameter);
+            for (size_t j = 0; j < demands.size(); ++j)
+            {
+                const auto &demand = demands[j];
+                if (demand.quantity <= 0 || demand.thickness.toTicks() == 0 ||
+                    (!demand.species.empty() && demand.species != log.species.name))
+                {
+                    continue;
+                }
+
+                if (demand.kind == DemandKind::COOKIE)
+                {
+                    if (log.diameter >= demand.width)
+                    {
+                        result[j] = static_cast<int>((log.length.toTicks() + kerf) / (demand.thickness.toTicks() + kerf));
+                    }
+                    continue;
+                }
+
+                if (demand.length.toTicks() == 0 || demand.length > log.length)
+                {
+                    continue;
+                }
+                int sections = static_cast<int>((log.length.toTicks() + kerf) / (demand.length.toTicks() + kerf));
+
+                slabs::SlabPlannerOptions slabOptions;
+                slabOptions.thicknesses = {slabs::ThicknessOption{demand.thickness, 1.0}};
+                slabOptions.kerf = options_.kerf;
+                slabOptions.minWidth = demand.width;
+                slabOptions.objective = demand.kind == DemandKind::SLAB ? slabs::PlanObjective::VALUE : slabs::PlanObjective::YIELD;
+                slabOptions.maxPlans = 1;
+                auto plans = slabs::SlabPlanner(slabOptions).plan(log, Length::fromTicks(0), profile);
+                if (plans.empty())
+                {
+                    continue;
+                }
+
+                int perSection = 0;
+                for (const auto &slab : plans.front().cuts)
+                {
+                    perSection += demand.kind == DemandKind::SLAB
+                                      ? 1
+                                      : static_cast<int>((slab.width.toTicks() + kerf) / (demand.width.toTicks() + kerf));
+                }
+                result[j] = sections * perSection;
+            }
+            return result;
+        }
+
+    private:
+        struct Candidate
+        {
+            double score;
+            size_t log;
+            size_t demand;
+            bool operator<(const Candidate &other) const { return score < other.score; }
+        };
+
+        double score(const Demand &demand, int capacity, int remaining) const
+        {
+            int pieces = std::min(capacity, remaining);
+            double value = pieces * demand.centsEach;
+            if (pieces > 0 && pieces == remaining)
+            {
+                value += options_.orderFilledBonusCents;
+            }
+            return value;
+        }
+
+        YardPlan assign(const std::vector<Log> &logs, const std::vector<Demand> &demands,
+                        const std::vector<std::vector<int>> &yields, const std::vector<size_t> &evaluated) const
+        {
+            YardPlan plan;
+            plan.logsEvaluated = evaluated.size();
+            plan.filled.assign(demands.size(), 0);
+
+            std::vector<int> remaining(demands.size());
+            for (size_t j = 0; j < demands.size(); ++j)
+            {
+                remaining[j] = std::max(demands[j].quantity, 0);
+            }
+
+            std::priority_queue<Candidate> heap;
+            // Per demand, the logs that yield for it by ascending yield, to find those a smaller remainder lets finish the line
+            std::vector<std::vector<std::pair<int, size_t>>> byYield(demands.size());
+            for (size_t i : evaluated)
+            {
+                for (size_t j = 0; j < yields[i].size(); ++j)
+                {
+                    if (yields[i][j] > 0)
+                    {
+                        heap.push(Candidate{score(demands[j], yields[i][j], remaining[j]), i, j});
+                        byYield[j].emplace_back(yields[i][j], i);
+                    }
+                }
+            }
+            for (auto &logsForDemand : byYield)
+            {
+                std::sort(logsForDemand.begin(), logsForDemand.end());
+            }
+
+            std::vector<bool> used(logs.size(), false);
+            while (!heap.empty())
+            {
+                Candidate top = heap.top();
+                heap.pop();
+                if (used[top.log] || remaining[top.demand] == 0)
+                {
+                    continue;
+                }
+                double current = score(demands[top.demand], yields[top.log][top.demand], remaining[top.demand]);
+                if (current < top.score)
+                {
+                    heap.push(Candidate{current, top.log, top.demand});
+                    continue;
+                }
+
+                int pieces = std::min(yields[top.log][top.demand], remaining[top.demand]);
+                const int before = remaining[top.demand];
+                remaining[top.demand] -= pieces;
+                plan.filled[top.demand] += pieces;
+                used[top.log] = true;
+
+                // Logs yielding at least the new remainder but less than the old one can now finish the line and earn the bonus
+                const int after = remaining[top.demand];
+                if (after > 0)
+                {
+                    const auto &logsForDemand = byYield[top.demand];
+                    auto first = std::lower_bound(logsForDemand.begin(), logsForDemand.end(), std::make_pair(after, size_t{0}));
+                    auto last = std::lower_bound(first, logsForDemand.end(), std::make_pair(before, size_t{0}));
+                    for (auto it = first; it != last; ++it)
+                    {
+                        if (!used[it->second])
+                        {
+                            heap.push(Candidate{score(demands[top.demand], it->first, after), it->second, top.demand});
+                        }
+                    }
+                }
+                double value = pieces * demands[top.demand].centsEach;
+                plan.valueCents += value;
+                plan.assignments.push_back(LogAssignment{logs[top.log].id, top.demand, pieces, yields[top.log][top.demand], value});
+            }
+
+            for (size_t j = 0; j < demands.size(); ++j)
+            {
+                if (demands[j].quantity > 0 && remaining[j] == 0)
+                {
+                    ++plan.ordersFilled;
+                }
+            }
+            return plan;
+        }
+
+        YardPlannerOptions options_;
+    };
+}
@@ -1,11 +1,25 @@
 /**
  * @file connection.hpp
  * @brief Provides a singleton database connection for the application.
+ *
+ * The database file is, in order of precedence:
+ *   1. whatever was passed to DbConnection::configure (e.g. from `--db`),
+ *   2. the WOODWORKS_DB environment variable,
+ *   3. `database/path` in the WoodWorks QSettings,
+ *   4. `woodworks.db` in the working directory.
+ * The template file comes from the same places (`--template`,
+ * WOODWORKS_DB_TEMPLATE, `database/template`).
+ *
+ * `:memory:` keeps the database in memory, in a shared cache so that other
+ * connections in the process can open it by the same name. Tests and
+ * benchmarks use it to run without touching disk. With a template, the
+ * database starts as a copy of that file.
  */
 
 #pragma once
 
 #include <QSqlDatabase>
+#include <QString>
 #include <mutex>
 
 /**
@@ -28,6 +42,27 @@ namespace woodworks::infra
          */
         static QSqlDatabase &instance();
 
+        /** @brief The path that selects an in-memory database. */
+        static constexpr const char *IN_MEMORY = ":memory:";
+
+        /**
+         * @brief Chooses the database instance() opens, overriding the environment and settings.
+         * @param path A file, or IN_MEMORY.
+         * @param templatePath A database copied into a new in-memory database before it is
+         *        migrated; only used with IN_MEMORY, and optional.
+         * @throws std::runtime_error if the connection is already open.
+         */
+        static void configure(const QString &path, const QString &templatePath = QString());
+
+        /**
+         * @brief The database instance() opens, or has opened.
+         * @return A file path, or IN_MEMORY.
+         */
+        static QString path();
+
+        /** @brief The template copied into an in-memory database, or an empty string. */
+        static QString templatePath();
+
         /**
          * @brief Provides access to the database connection.
          * @return A reference to the QSqlDatabase instance.
@@ -49,5 +84,9 @@ namespace woodworks::infra
          * @brief Ensures the database connection is initialized only once.
          */
         static inline std::once_flag initFlag_;
+
+        static inline QString path_;         ///< Set by configure(); empty to use the environment or settings.
+        static inline QString templatePath_; ///< Set by configure().
+        static inline bool opened_{false};
     };
 }
\ No newline at end of file
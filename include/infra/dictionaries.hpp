@@ -0,0 +1,119 @@
+/**
+ * @file dictionaries.hpp
+ * @brief Provides in-memory distinct-value lists for the inventory filter combo boxes.
+ *
+ * Each dictionary counts how many rows hold each value, e.g. how many items
+ * of every species are in stock. The counts are read with one GROUP BY per
+ * table and column the first time a list is asked for. After that,
+ * QtSqlRepository keeps them up to date from the rows it writes, so a value
+ * appears with its first row and disappears with its last.
+ *
+ * Writes the repository cannot describe row by row drop the counts instead:
+ * bulk statements, rolled-back transactions and writes that bypass the
+ * repositories. The next read loads them again.
+ *
+ * Counts describe one database, so each connection has its own set.
+ */
+
+#pragma once
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+/**
+ * @namespace woodworks::infra
+ * @brief Contains infrastructure-related classes and utilities.
+ */
+namespace woodworks::infra
+{
+    /**
+     * @struct DictionaryStats
+     * @brief How the dictionaries have been kept up to date.
+     */
+    struct DictionaryStats
+    {
+        size_t loads{0};         ///< Full reads from the database.
+        size_t rowsApplied{0};   ///< Rows added or removed incrementally.
+        size_t invalidations{0}; ///< Times the counts were dropped.
+    };
+
+    /**
+     * @class Dictionaries
+     * @brief Reference-counted distinct values of the columns the inventory filters on.
+     */
+    class Dictionaries
+    {
+    public:
+        /** @brief The lists kept. */
+        enum Kind
+        {
+            SPECIES,
+            LOCATIONS,
+            DRYING,           ///< Drying labels, as the display views show them.
+            SLAB_SURFACING,   ///< Surfacing labels of live edge slabs.
+            LUMBER_SURFACING, ///< Surfacing labels of lumber.
+            LUMBER_THICKNESS, ///< Lumber thickness in quarters, e.g. "8/4".
+            KIND_COUNT
+        };
+
+        /** @brief The lists of the default connection. */
+        static Dictionaries &instance();
+
+        /** @brief The lists of a connection. */
+        static Dictionaries &of(const QSqlDatabase &db);
+
+        Dictionaries(const Dictionaries &) = delete;
+        Dictionaries &operator=(const Dictionaries &) = delete;
+
+        /**
+         * @brief The distinct values of one list, loading every list first if needed.
+         *
+         * Names are sorted alphabetically; labels and thicknesses in code order.
+         */
+        QStringList values(Kind kind);
+
+        /** @brief Whether the counts are in memory, i.e. whether writes need to be applied. */
+        bool loaded() const;
+
+        /**
+         * @brief Reads the dictionary columns of one row, to apply before the row is changed.
+         * @return std::nullopt when nothing needs applying: not loaded, or a table without dictionary columns.
+         */
+        std::optional<QVariantMap> read(QSqlDatabase &db, const QString &table, int id) const;
+
+        /** @brief Counts a row written to a table; takes T::columnValues. */
+        void added(const QString &table, const QVariantMap &row);
+
+        /** @brief Uncounts a row removed from a table, or the old values of an updated row. */
+        void removed(const QString &table, const QVariantMap &row);
+
+        /** @brief Drops the counts, so the next values() reads them again. */
+        void invalidate();
+
+        DictionaryStats stats() const;
+
+    private:
+        explicit Dictionaries(QString connection) : connection_(std::move(connection)) {}
+
+        /** @brief Sort key and display text; the key is 0 for names, so they sort by text. */
+        using Entry = std::pair<qint64, QString>;
+
+        void load();
+        void apply(const QString &table, const QVariantMap &row, int delta);
+
+        QString connection_; ///< Name of the connection counted.
+        mutable std::mutex mutex_;
+        bool loaded_{false};
+        std::array<std::map<Entry, int>, KIND_COUNT> counts_;
+        DictionaryStats stats_;
+    };
+}
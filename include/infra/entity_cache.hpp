@@ -0,0 +1,413 @@
+/**
+ * @file entity_cache.hpp
+ * @brief Provides a per-entity-type LRU identity map that QtSqlRepository::get serves from.
+ *
+ * Context menus and double-click handlers fetch the same row again and again
+ * through short-lived repositories, so each cache is process-wide, one per
+ * entity type. Ids belong to a database, so entries are keyed by connection
+ * and id, and the connections share one LRU order and cap. The repository writes through it on add, update and remove,
+ * and any transaction that rolls back clears every cache, since it may have
+ * undone writes the caches already hold.
+ *
+ * The repository diffs updates against StoredColumns<T>, which remembers the
+ * column values of entities fetched by id or written whatever the cache's
+ * capacity, and writes only the columns that changed.
+ *
+ * The memory cap counts the entity and its strings but not its image: images
+ * are implicitly shared QByteArrays, so the cache and every copy it hands out
+ * refer to the one buffer read from the database.
+ *
+ * Caching is off (capacity 0) unless EntityCaches::setCapacity is called or
+ * WOODWORKS_ENTITY_CACHE_KB is set.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @namespace woodworks::infra
+ * @brief Contains infrastructure-related classes and utilities.
+ */
+namespace woodworks::infra
+{
+    /**
+     * @struct CacheStats
+     * @brief Counters for one entity cache.
+     */
+    struct CacheStats
+    {
+        std::string entity; ///< typeid name of the cached type.
+        size_t hits{0};
+        size_t misses{0};
+        size_t evictions{0};
+        size_t entries{0};
+        size_t bytes{0};    ///< Estimated, without images.
+        size_t capacity{0}; ///< 0 when caching is off.
+
+        double hitRate() const { return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses); }
+    };
+
+    /**
+     * @class EntityCaches
+     * @brief Controls every EntityCache at once.
+     */
+    class EntityCaches
+    {
+    public:
+        /** @brief Sets the byte cap of every cache, current and future; 0 turns caching off and empties them. */
+        static void setCapacity(size_t bytes);
+
+        /** @brief The cap new caches start with. */
+        static size_t capacity();
+
+        /** @brief Empties every cache and StoredColumns, e.g. after writes that bypassed the repositories. */
+        static void clearAll();
+
+        /** @brief Counters for every cache created so far. */
+        static std::vector<CacheStats> stats();
+
+        /** @brief Called by each EntityCache when it is created. */
+        static void registerCache(std::function<void(size_t)> setCapacity, std::function<void()> clear, std::function<CacheStats()> stats);
+
+        /** @brief Called by each StoredColumns when it is created; it has no capacity or stats. */
+        static void registerStoredColumns(std::function<void()> clear);
+    };
+
+    /** @brief What the caches key a connection's rows by: its name and database. */
+    inline QString cacheConnectionKey(const QSqlDatabase &db)
+    {
+        return db.connectionName() + '\n' + db.databaseName();
+    }
+
+    /**
+     * @brief Estimated bytes an entity holds, excluding its image.
+     *
+     * Fits the inventory types; types with other strings overload it in their namespace.
+     */
+    template <typename T>
+    size_t cacheFootprint(const T &item)
+    {
+        return sizeof(T) + item.species.name.capacity() + item.location.capacity() + item.notes.capacity();
+    }
+
+    /**
+     * @class EntityCache
+     * @brief LRU map from connection and id to entity for one type.
+     * @tparam T The entity type.
+     */
+    template <typename T>
+    class EntityCache
+    {
+    public:
+        /**
+         * @brief Retrieves the cache for T, creating and registering it on first use.
+         */
+        static EntityCache &instance()
+        {
+            static EntityCache cache;
+            return cache;
+        }
+
+        EntityCache(const EntityCache &) = delete;
+        EntityCache &operator=(const EntityCache &) = delete;
+
+        bool enabled() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return capacity_ > 0;
+        }
+
+        /**
+         * @brief Looks an entity up, counting a hit or a miss.
+         * @return A copy of the cached entity, or std::nullopt.
+         */
+        std::optional<T> find(const QSqlDatabase &db, int id)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = findLocked(cacheConnectionKey(db), id);
+            if (!it)
+            {
+                ++misses_;
+                return std::nullopt;
+            }
+            ++hits_;
+            entries_.splice(entries_.begin(), entries_, *it);
+            return (*it)->item;
+        }
+
+        /**
+         * @brief Looks an entity up without counting it or refreshing its place in the LRU order.
+         * @return A copy of the cached entity, or std::nullopt.
+         */
+        std::optional<T> peek(const QSqlDatabase &db, int id) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = findLocked(cacheConnectionKey(db), id);
+            if (!it)
+            {
+                return std::nullopt;
+            }
+            return (*it)->item;
+        }
+
+        /** @brief Stores the current state of an entity, evicting the least recently used ones over the cap. */
+        void put(const QSqlDatabase &db, int id, const T &item)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (capacity_ == 0)
+            {
+                return;
+            }
+            const QString connection = cacheConnectionKey(db);
+            eraseLocked(connection, id);
+            size_t bytes = cacheFootprint(item);
+            if (bytes > capacity_)
+            {
+                return;
+            }
+            entries_.push_front(Entry{connection, id, item, bytes});
+            index_[connection][id] = entries_.begin();
+            bytes_ += bytes;
+            evictLocked();
+        }
+
+        /** @brief Forgets an entity, e.g. because it was deleted. */
+        void erase(const QSqlDatabase &db, int id)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            eraseLocked(cacheConnectionKey(db), id);
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            entries_.clear();
+            index_.clear();
+            bytes_ = 0;
+        }
+
+        void setCapacity(size_t bytes)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            capacity_ = bytes;
+            evictLocked();
+        }
+
+        CacheStats stats() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return CacheStats{typeid(T).name(), hits_, misses_, evictions_, entries_.size(), bytes_, capacity_};
+        }
+
+    private:
+        struct Entry
+        {
+            QString connection;
+            int id;
+            T item;
+            size_t bytes;
+        };
+
+        using Entries = std::list<Entry>;
+
+        EntityCache() : capacity_(EntityCaches::capacity())
+        {
+            EntityCaches::registerCache([this](size_t bytes)
+                                        { setCapacity(bytes); },
+                                        [this]()
+                                        { clear(); },
+                                        [this]()
+                                        { return stats(); });
+        }
+
+        std::optional<typename Entries::iterator> findLocked(const QString &connection, int id) const
+        {
+            auto rows = index_.find(connection);
+            if (rows == index_.end())
+            {
+                return std::nullopt;
+            }
+            auto it = rows->second.find(id);
+            if (it == rows->second.end())
+            {
+                return std::nullopt;
+            }
+            return it->second;
+        }
+
+        void eraseLocked(const QString &connection, int id)
+        {
+            auto rows = index_.find(connection);
+            if (rows == index_.end())
+            {
+                return;
+            }
+            auto it = rows->second.find(id);
+            if (it == rows->second.end())
+            {
+                return;
+            }
+            bytes_ -= it->second->bytes;
+            entries_.erase(it->second);
+            rows->second.erase(it);
+            if (rows->second.empty())
+            {
+                index_.erase(rows);
+            }
+        }
+
+        void evictLocked()
+        {
+            while (!entries_.empty() && bytes_ > capacity_)
+            {
+                const Entry &oldest = entries_.back();
+                eraseLocked(oldest.connection, oldest.id);
+                ++evictions_;
+            }
+        }
+
+        mutable std::mutex mutex_;
+        Entries entries_; ///< Most recently used first.
+        std::map<QString, std::unordered_map<int, typename Entries::iterator>> index_;
+        size_t capacity_;
+        size_t bytes_{0};
+        size_t hits_{0};
+        size_t misses_{0};
+        size_t evictions_{0};
+    };
+
+    /**
+     * @class StoredColumns
+     * @brief The column values of each entity of one type as last read or written, for QtSqlRepository::update to diff against.
+     *
+     * Entities fetched with get() or getMany(), and every entity written,
+     * are tracked with no cap, so an edit writes only what changed even with
+     * EntityCache off. Streaming reads (cursor, forEach, list, filter) are
+     * not tracked, so a whole-table scan holds nothing afterwards. Images are
+     * kept as a fingerprint, not a copy, so tracking a row costs about as
+     * much as its small columns. Ids belong to a database, so rows are
+     * tracked per connection.
+     * @tparam T The entity type.
+     */
+    template <typename T>
+    class StoredColumns
+    {
+    public:
+        static StoredColumns &instance()
+        {
+            static StoredColumns stored;
+            return stored;
+        }
+
+        StoredColumns(const StoredColumns &) = delete;
+        StoredColumns &operator=(const StoredColumns &) = delete;
+
+        /** @brief Stand-in for an image: its size and two hashes. Other values are returned as they are. */
+        static QVariant fingerprint(const QVariant &value)
+        {
+            if (value.type() != QVariant::ByteArray)
+            {
+                return value;
+            }
+            QByteArray bytes = value.toByteArray();
+            return QString("blob:%1:%2:%3").arg(bytes.size()).arg(qHash(bytes, 1)).arg(qHash(bytes, 2));
+        }
+
+        /** @brief Records an entity's columns, as T::columnValues gives them. */
+        void remember(const QSqlDatabase &db, int id, const QVariantMap &columns)
+        {
+            std::vector<QVariant> values;
+            values.reserve(static_cast<size_t>(columns.size()));
+            const QStringList names = columns.keys();
+            for (const QString &name : names)
+            {
+                values.push_back(fingerprint(columns.value(name)));
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (names_.isEmpty())
+            {
+                names_ = names;
+            }
+            if (names != names_)
+            {
+                return;
+            }
+            rows_[cacheConnectionKey(db)][id] = std::move(values);
+        }
+
+        /** @brief The columns last recorded for an entity, with images as fingerprints. */
+        std::optional<QVariantMap> find(const QSqlDatabase &db, int id) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto rows = rows_.find(cacheConnectionKey(db));
+            if (rows == rows_.end())
+            {
+                return std::nullopt;
+            }
+            auto it = rows->second.find(id);
+            if (it == rows->second.end())
+            {
+                return std::nullopt;
+            }
+            QVariantMap columns;
+            for (int i = 0; i < names_.size(); ++i)
+            {
+                columns.insert(names_[i], it->second[static_cast<size_t>(i)]);
+            }
+            return columns;
+        }
+
+        /** @brief The number of entities tracked for a connection. */
+        size_t size(const QSqlDatabase &db) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto rows = rows_.find(cacheConnectionKey(db));
+            return rows == rows_.end() ? 0 : rows->second.size();
+        }
+
+        /** @brief Stops tracking an entity, e.g. because it was deleted. */
+        void forget(const QSqlDatabase &db, int id)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto rows = rows_.find(cacheConnectionKey(db));
+            if (rows != rows_.end())
+            {
+                rows->second.erase(id);
+            }
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            rows_.clear();
+        }
+
+    private:
+        StoredColumns()
+        {
+            EntityCaches::registerStoredColumns([this]()
+                                                { clear(); });
+        }
+
+        mutable std::mutex mutex_;
+        QStringList names_; ///< Column names, in T::columnValues key order; the same for every row.
+        std::map<QString, std::unordered_map<int, std::vector<QVariant>>> rows_;
+    };
+}
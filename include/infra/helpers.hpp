@@ -8,6 +8,8 @@
 #include <QSqlError>
 
 #include "connection.hpp"
+#include "logging.hpp"
+#include "sql_trace.hpp"
 
 /**
  * @namespace woodworks::infra
@@ -26,16 +28,16 @@ namespace woodworks::infra
 
         // From species in [cookies, firewood, logs, lumber, slabs]
         QStringList speciesList;
-        QSqlQuery query(db);
+        TracedQuery query(db);
         if (!query.prepare(
-                "SELECT DISTINCT species FROM ("
-                "SELECT species FROM cookies UNION "
-                "SELECT species FROM firewood UNION "
-                "SELECT species FROM logs UNION "
-                "SELECT species FROM lumber UNION "
-                "SELECT species FROM live_edge_slabs)"))
+                "SELECT name FROM species WHERE id IN ("
+                "SELECT species_id FROM cookies UNION "
+                "SELECT species_id FROM firewood UNION "
+                "SELECT species_id FROM logs UNION "
+                "SELECT species_id FROM lumber UNION "
+                "SELECT species_id FROM live_edge_slabs)"))
         {
-            qDebug() << "Error preparing query for unique species:" << query.lastError().text();
+            WOODWORKS_LOG_WARN("helpers", "error preparing query for unique species", {{"error", query.lastError().text()}});
             return speciesList;
         }
 
@@ -49,7 +51,7 @@ namespace woodworks::infra
         }
         else
         {
-            qDebug() << "Error fetching unique species:" << query.lastError().text();
+            WOODWORKS_LOG_WARN("helpers", "error fetching unique species", {{"error", query.lastError().text()}});
         }
         return out;
     }
@@ -62,7 +64,7 @@ namespace woodworks::infra
     {
         auto &db = DbConnection::instance();
         QStringList dryingList;
-        QSqlQuery query(db);
+        TracedQuery query(db);
         if (!query.prepare(
                 "SELECT DISTINCT Drying FROM ("
                 "SELECT Drying FROM display_cookies UNION "
@@ -71,7 +73,7 @@ namespace woodworks::infra
                 "SELECT Drying FROM display_lumber UNION "
                 "SELECT Drying FROM display_slabs)"))
         {
-            qDebug() << "Error preparing query for unique drying options:" << query.lastError().text();
+            WOODWORKS_LOG_WARN("helpers", "error preparing query for unique drying options", {{"error", query.lastError().text()}});
             return dryingList;
         }
 
@@ -85,7 +87,7 @@ namespace woodworks::infra
         }
         else
         {
-            qDebug() << "Error fetching unique drying options:" << query.lastError().text();
+            WOODWORKS_LOG_WARN("helpers", "error fetching unique drying options", {{"error", query.lastError().text()}});
         }
         return out;
     }
@@ -98,16 +100,16 @@ namespace woodworks::infra
     {
         auto &db = DbConnection::instance();
         QStringList locationList;
-        QSqlQuery query(db);
+        TracedQuery query(db);
         if (!query.prepare(
-                "SELECT DISTINCT location FROM ("
-                "SELECT location FROM cookies UNION "
-                "SELECT location FROM firewood UNION "
-                "SELECT location FROM logs UNION "
-                "SELECT location FROM lumber UNION "
-                "SELECT location FROM live_edge_slabs)"))
+                "SELECT name FROM storage_bins WHERE id IN ("
+                "SELECT location_id FROM cookies UNION "
+                "SELECT location_id FROM firewood UNION "
+                "SELECT location_id FROM logs UNION "
+                "SELECT location_id FROM lumber UNION "
+                "SELECT location_id FROM live_edge_slabs)"))
         {
-            qDebug() << "Error preparing query for unique locations:" << query.lastError().text();
+            WOODWORKS_LOG_WARN("helpers", "error preparing query for unique locations", {{"error", query.lastError().text()}});
             return locationList;
         }
 
@@ -121,7 +123,7 @@ namespace woodworks::infra
         }
         else
         {
-            qDebug() << "Error fetching unique locations:" << query.lastError().text();
+            WOODWORKS_LOG_WARN("helpers", "error fetching unique locations", {{"error", query.lastError().text()}});
         }
         return out;
     }
@@ -135,11 +137,11 @@ namespace woodworks::infra
     inline int getMaxOfColumn(const QString &tableName, const QString &columnName)
     {
         auto &db = DbConnection::instance();
-        QSqlQuery query(db);
+        TracedQuery query(db);
         query.prepare(QString("SELECT MAX(%1) FROM %2").arg(columnName, tableName));
         if (!query.exec())
         {
-            qDebug() << "Error executing query:" << query.lastError().text();
+            WOODWORKS_LOG_WARN("helpers", "query failed", {{"table", tableName}, {"column", columnName}, {"error", query.lastError().text()}});
             return -1;
         }
         if (query.next())
@@ -158,11 +160,11 @@ namespace woodworks::infra
     inline int getMinOfColumn(const QString &tableName, const QString &columnName)
     {
         auto &db = DbConnection::instance();
-        QSqlQuery query(db);
+        TracedQuery query(db);
         query.prepare(QString("SELECT MIN(%1) FROM %2").arg(columnName, tableName));
         if (!query.exec())
         {
-            qDebug() << "Error executing query:" << query.lastError().text();
+            WOODWORKS_LOG_WARN("helpers", "query failed", {{"table", tableName}, {"column", columnName}, {"error", query.lastError().text()}});
             return -1;
         }
         if (query.next())
@@ -181,11 +183,11 @@ namespace woodworks::infra
     inline QStringList getUniqueValuesOfColumn(const QString &tableName, const QString &columnName)
     {
         auto &db = DbConnection::instance();
-        QSqlQuery query(db);
+        TracedQuery query(db);
         query.prepare(QString("SELECT DISTINCT %1 FROM %2").arg(columnName, tableName));
         if (!query.exec())
         {
-            qDebug() << "Error executing query:" << query.lastError().text();
+            WOODWORKS_LOG_WARN("helpers", "query failed", {{"table", tableName}, {"column", columnName}, {"error", query.lastError().text()}});
             return QStringList();
         }
         QStringList values;
@@ -0,0 +1,138 @@
+/**
+ * @file inventory_generator.hpp
+ * @brief Provides a seeded generator of synthetic inventory for load and scale testing.
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "domain/log.hpp"
+#include "domain/cookie.hpp"
+#include "domain/live_edge_slab.hpp"
+#include "domain/lumber.hpp"
+#include "domain/firewood.hpp"
+#include "domain/cutlist.hpp"
+
+/**
+ * @namespace woodworks::infra
+ * @brief Contains infrastructure-related classes and utilities.
+ */
+namespace woodworks::infra
+{
+    /**
+     * @struct GeneratorOptions
+     * @brief How much of each kind of inventory to generate.
+     */
+    struct GeneratorOptions
+    {
+        size_t logs{0};
+        size_t slabs{0};
+        size_t lumber{0};
+        size_t cookies{0};
+        size_t firewood{0};
+        size_t customCuts{0};
+        /**
+         * @brief Extra logs run through SlabCutter and LumberCutter, so some
+         * slabs, boards and cookies were really cut from a parent in the database.
+         */
+        size_t lineageLogs{0};
+        /** @brief Size of the image attached to every row; 0 for none. */
+        size_t imageBytes{0};
+        /** @brief Rows written per transaction. */
+        size_t batchSize{10000};
+
+        /**
+         * @brief The same number of rows in every inventory table.
+         * @param rows Rows per table.
+         * @return The options.
+         */
+        static GeneratorOptions uniform(size_t rows)
+        {
+            GeneratorOptions options;
+            options.logs = options.slabs = options.lumber = options.cookies = options.firewood = rows;
+            options.customCuts = rows / 10;
+            options.lineageLogs = rows / 1000;
+            return options;
+        }
+    };
+
+    /**
+     * @struct GeneratorStats
+     * @brief Rows written by a generator run.
+     */
+    struct GeneratorStats
+    {
+        size_t logs{0};
+        size_t slabs{0};
+        size_t lumber{0};
+        size_t cookies{0};
+        size_t firewood{0};
+        size_t customCuts{0};
+        double seconds{0.0};
+
+        size_t total() const { return logs + slabs + lumber + cookies + firewood + customCuts; }
+    };
+
+    /**
+     * @class InventoryGenerator
+     * @brief Fills the application database with realistic, reproducible inventory.
+     *
+     * Species follow a fixed mix weighted toward the common hardwoods, and sizes
+     * are bell shaped around typical sawmill stock. Random numbers come from
+     * std::mt19937 with hand-rolled distributions, so a seed gives the same rows
+     * with every compiler and standard library.
+     *
+     * Bulk rows go through each type's insert statement, prepared once and
+     * executed inside transactions of batchSize rows. Lineage logs instead go
+     * through the real cutters, so they exercise the same code paths as the
+     * sawyer screens. Like the cutters, the generator writes to
+     * DbConnection::instance().
+     */
+    class InventoryGenerator
+    {
+    public:
+        /**
+         * @brief Constructs a generator.
+         * @param seed The same seed always gives the same rows.
+         */
+        explicit InventoryGenerator(uint32_t seed = 1);
+
+        /**
+         * @brief Writes the requested rows.
+         * @param options Row counts and image size.
+         * @return Rows written per table.
+         * @throws std::runtime_error if a statement fails.
+         */
+        GeneratorStats generate(const GeneratorOptions &options);
+
+        // One random item of each kind, not yet saved
+        domain::Log makeLog();
+        domain::LiveEdgeSlab makeSlab();
+        domain::Lumber makeLumber();
+        domain::Cookie makeCookie();
+        domain::Firewood makeFirewood();
+        domain::CustomCut makeCustomCut();
+
+    private:
+        template <typename T, typename Make>
+        size_t insertMany(size_t count, size_t batchSize, Make make);
+
+        void cutLineage(size_t count, GeneratorStats &stats);
+
+        uint32_t below(uint32_t bound);
+        double bell(double mean, double spread, double low, double high);
+        std::string species();
+        std::string location();
+        QByteArray image();
+
+        std::mt19937 rng_;
+        size_t imageBytes_{0};
+        std::vector<QByteArray> images_;
+    };
+}
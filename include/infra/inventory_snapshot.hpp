@@ -0,0 +1,221 @@
+/**
+ * @file inventory_snapshot.hpp
+ * @brief Provides in-memory columnar copies of the inventory display views for filtering without SQL.
+ *
+ * A snapshot reads an individual display view once. It keeps each displayed
+ * column as an array of cells and each filterable base column as an array of
+ * doubles: ticks, cents, enum codes and interned keys. Filters compile to the
+ * same base-table predicates as the SQL path, then run as scans over those
+ * arrays. The result is a list of row numbers that a SnapshotModel shows
+ * without copying any cells.
+ *
+ * Repositories report the ids they add, update and remove. Removed rows
+ * are marked dead at once; added and updated ones are read again by id the
+ * next time the snapshot is asked for, and written over their old row or
+ * appended. Row numbers therefore never move, and models already showing
+ * a snapshot stay valid. Writes the repositories cannot describe row by
+ * row drop the snapshots instead: bulk statements, rolled-back
+ * transactions, the inventory generator and the legacy import. So does a
+ * build-up of dead rows.
+ *
+ * Grouped views, and filters that only the view's output can answer, use
+ * makeFilteredModel. Set WOODWORKS_SNAPSHOT_FILTERS=0 to always query SQLite.
+ */
+
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "infra/mappers/view_helpers.hpp"
+
+/**
+ * @namespace woodworks::infra
+ * @brief Contains infrastructure-related classes and utilities.
+ */
+namespace woodworks::infra
+{
+    /**
+     * @class InventorySnapshot
+     * @brief The rows of one individual display view, stored column by column.
+     */
+    class InventorySnapshot
+    {
+    public:
+        /**
+         * @brief Reads a display view.
+         * @return nullptr for grouped views and tables that are not inventory display views.
+         * @throws std::runtime_error if the view cannot be read.
+         */
+        static std::shared_ptr<InventorySnapshot> load(QSqlDatabase &db, const QString &view);
+
+        const QString &view() const { return view_; }
+        /** @brief The base table the view reads, e.g. "logs". */
+        const QString &table() const { return table_; }
+        const QStringList &headers() const { return headers_; }
+        /** @brief Rows held, including dead ones. */
+        int rowCount() const { return rows_; }
+        /** @brief Rows marked dead since the view was read. */
+        int deadRows() const { return dead_; }
+        int columnCount() const { return static_cast<int>(cells_.size()); }
+
+        /** @brief A cell as the view shows it. */
+        const QVariant &cell(int row, int column) const { return cells_[column][row]; }
+
+        /**
+         * @brief The rows the filters keep, in view order.
+         * @return std::nullopt if a filter cannot be answered from the base columns.
+         */
+        std::optional<std::vector<int>> match(const QVector<FieldFilter> &filters) const;
+
+        /**
+         * @brief Reads rows again by id: known ids are overwritten, new ones appended, vanished ones marked dead.
+         * @return The number of rows read.
+         * @throws std::runtime_error if the rows cannot be read.
+         */
+        int reload(QSqlDatabase &db, const std::set<int> &ids);
+
+        /** @brief Marks rows dead, so no filter matches them. */
+        void kill(const std::vector<int> &ids);
+
+    private:
+        /** @brief Reads the view's rows matching a condition on the base table, or all of them. */
+        int read(QSqlDatabase &db, const QString &where, const QVector<QVariant> &bound);
+
+        /** @brief A filterable base column; NaN stands for NULL, which no predicate matches. */
+        struct BaseColumn
+        {
+            std::vector<double> values;
+            bool numeric{true}; ///< False if any value was text, so predicates on it need SQL.
+        };
+
+        QString view_;
+        QString table_;
+        QString source_; ///< Display columns, base columns and id, FROM the view's tables.
+        QStringList headers_;
+        QStringList baseColumns_;
+        int rows_{0};
+        int dead_{0};
+        std::vector<std::vector<QVariant>> cells_;
+        std::map<QString, BaseColumn> base_;
+        std::vector<uint8_t> alive_;
+        std::unordered_map<int, int> rowOf_; ///< Row number of each id.
+    };
+
+    /**
+     * @struct SnapshotStats
+     * @brief How filters have been answered.
+     */
+    struct SnapshotStats
+    {
+        size_t loads{0};         ///< Views read into memory.
+        size_t scans{0};         ///< Filters answered from memory.
+        size_t fallbacks{0};     ///< Filters sent to SQLite instead.
+        size_t rowsPatched{0};   ///< Rows read again or marked dead after a repository write.
+        size_t invalidations{0}; ///< Times the snapshots were dropped.
+        double lastScanMs{0.0};  ///< Duration of the latest scan.
+    };
+
+    /**
+     * @class InventorySnapshots
+     * @brief The snapshots currently in memory, patched from repository writes.
+     */
+    class InventorySnapshots
+    {
+    public:
+        static InventorySnapshots &instance();
+
+        InventorySnapshots(const InventorySnapshots &) = delete;
+        InventorySnapshots &operator=(const InventorySnapshots &) = delete;
+
+        bool enabled() const;
+        void setEnabled(bool enabled);
+
+        /**
+         * @brief The snapshot of a view, reading it first if needed.
+         * @return nullptr if disabled or the view cannot be snapshotted.
+         */
+        std::shared_ptr<const InventorySnapshot> get(const QString &view);
+
+        /** @brief Drops every snapshot, so the next get() reads its view again. */
+        void invalidate();
+
+        /**
+         * @brief Rows of a table were added or updated; they are read again by the next get().
+         *
+         * Only the default connection's writes are patched in; any other drops the snapshots.
+         */
+        void rowsWritten(const QSqlDatabase &db, const QString &table, const std::vector<int> &ids);
+
+        /** @brief Rows of a table were deleted; as rowsWritten(). */
+        void rowsRemoved(const QSqlDatabase &db, const QString &table, const std::vector<int> &ids);
+
+        /** @brief Records the outcome of one filter; called by makeSnapshotModel. */
+        void recordScan(double ms);
+        void recordFallback();
+
+        SnapshotStats stats() const;
+
+    private:
+        /** @brief A view's snapshot, nullptr if it cannot be snapshotted, and ids to read again. */
+        struct Entry
+        {
+            std::shared_ptr<InventorySnapshot> snapshot;
+            std::set<int> pending;
+        };
+
+        InventorySnapshots();
+
+        /** @brief Whether writes on a connection can be patched into the snapshots of the default one. */
+        static bool patchable(const QSqlDatabase &db);
+        void invalidateLocked();
+
+        mutable std::mutex mutex_;
+        bool enabled_{true};
+        std::map<QString, Entry> snapshots_;
+        SnapshotStats stats_;
+    };
+
+    /**
+     * @class SnapshotModel
+     * @brief A read-only table model showing selected rows of a snapshot.
+     *
+     * It holds only the snapshot and the row numbers, so building one for
+     * every keystroke costs a scan, not a copy of the table.
+     */
+    class SnapshotModel : public QAbstractTableModel
+    {
+    public:
+        SnapshotModel(std::shared_ptr<const InventorySnapshot> snapshot, std::vector<int> rows, QObject *parent = nullptr);
+
+        int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+        int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+        QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+        QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    private:
+        std::shared_ptr<const InventorySnapshot> snapshot_;
+        std::vector<int> rows_;
+    };
+
+    /**
+     * @brief Answers filters on a display view from its snapshot.
+     * @param view The display view.
+     * @param filters The filters to apply.
+     * @param parent The parent QObject.
+     * @return nullptr if the filters need SQL; use makeFilteredModel then.
+     */
+    SnapshotModel *makeSnapshotModel(const QString &view, const QVector<FieldFilter> &filters, QObject *parent = nullptr);
+}
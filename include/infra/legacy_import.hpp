@@ -0,0 +1,105 @@
+/**
+ * @file legacy_import.hpp
+ * @brief Imports a database from the old quarter/eighth-inch schema (see schema_dump.sql).
+ *
+ * The legacy file is ATTACHed next to the application database and every
+ * table is copied with INSERT ... SELECT in id-ordered batches, one
+ * transaction each. Rows, unit conversion and image BLOBs all stay inside
+ * SQLite, so memory use does not grow with the size of the legacy file.
+ *
+ * Conversions, to the 1/16" ticks the mappers use:
+ *   - logs: remaining length, i.e. len_quarters less everything cut from the
+ *     log (cookies, custom cuts, firewood, partial cuts); cost is the value
+ *     of that remaining length. Scrapped and fully cut logs are skipped.
+ *   - cookies, slabs (to live_edge_slabs), lumber, firewood: dimensions
+ *     converted; worth is the length taken from the parent log at its price.
+ *   - cutlist: t/w/l from eighths; lineage taken from its custom cut.
+ * Ids are kept, and each product's parent log id is kept in `from_log`.
+ *
+ * Progress is committed with each batch, so an interrupted import picks up
+ * where it stopped when run again.
+ */
+
+#pragma once
+
+#include <QSqlDatabase>
+#include <QString>
+
+#include <functional>
+#include <vector>
+
+/**
+ * @namespace woodworks::infra
+ * @brief Contains infrastructure-related classes and utilities.
+ */
+namespace woodworks::infra
+{
+    /**
+     * @struct LegacyTableReport
+     * @brief What happened to one legacy table.
+     */
+    struct LegacyTableReport
+    {
+        QString source; ///< Legacy table.
+        QString target; ///< Table it was copied into.
+        size_t copied{0};  ///< Rows copied, including by earlier interrupted runs.
+        size_t skipped{0}; ///< Rows with nothing left to import, e.g. fully cut logs.
+        size_t batches{0}; ///< Transactions committed by this run.
+        bool resumed{false};
+    };
+
+    /**
+     * @struct LegacyCheck
+     * @brief One table's totals on both sides, as compared by verify().
+     */
+    struct LegacyCheck
+    {
+        QString target;
+        qint64 expectedRows{0}, actualRows{0};
+        double expectedMeasure{0}, actualMeasure{0}; ///< Sum of the table's main dimension, in ticks.
+        qint64 expectedBlobBytes{0}, actualBlobBytes{0};
+
+        bool ok() const;
+    };
+
+    /**
+     * @struct LegacyImportOptions
+     * @brief Tuning for LegacyImporter::run.
+     */
+    struct LegacyImportOptions
+    {
+        /** @brief Legacy rows per transaction. */
+        size_t batchSize{2000};
+        /** @brief Called after each batch with the target table and rows copied so far. */
+        std::function<void(const QString &, size_t)> progress;
+    };
+
+    /**
+     * @class LegacyImporter
+     * @brief Copies a legacy database into the current schema.
+     */
+    class LegacyImporter
+    {
+    public:
+        /**
+         * @brief Imports, or finishes importing, a legacy database.
+         * @param db The application database, already at the latest schema version.
+         * @param legacyPath The legacy SQLite file; it is only read.
+         * @param options Batch size and progress reporting.
+         * @return One report per legacy table, in import order.
+         * @throws std::runtime_error if the legacy file cannot be attached, a target
+         *         table already holds rows from elsewhere, or a statement fails. Batches
+         *         committed before the failure are kept and are not copied again.
+         */
+        static std::vector<LegacyTableReport> run(QSqlDatabase &db, const QString &legacyPath,
+                                                  const LegacyImportOptions &options = {});
+
+        /**
+         * @brief Compares row counts, converted dimensions and BLOB sizes between a legacy file and what was imported from it.
+         * @param db The application database.
+         * @param legacyPath The legacy SQLite file.
+         * @return One check per table; rows the application added after the import are ignored.
+         */
+        static std::vector<LegacyCheck> verify(QSqlDatabase &db, const QString &legacyPath);
+    };
+}
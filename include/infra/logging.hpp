@@ -0,0 +1,241 @@
+/**
+ * @file logging.hpp
+ * @brief Provides leveled, structured logging drained to the console by a background thread.
+ *
+ * Usage:
+ *   WOODWORKS_LOG_DEBUG("repository", "update", {{"id", item.id.id}});
+ *   WOODWORKS_LOG_WARN("importer", "file could not open", {{"path", filePath}});
+ *
+ * Records below WOODWORKS_LOG_MIN_LEVEL are compiled out entirely. The rest
+ * cost one relaxed atomic load when the runtime level filters them, and
+ * otherwise a push into a lock-free ring buffer; formatting and console I/O
+ * happen on the drain thread. The runtime level starts from the
+ * WOODWORKS_LOG_LEVEL environment variable (trace, debug, info, warn, error
+ * or off) and defaults to info.
+ */
+
+#pragma once
+
+#include <QString>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Lowest level compiled in: 0 trace, 1 debug, 2 info, 3 warn, 4 error
+#ifndef WOODWORKS_LOG_MIN_LEVEL
+#define WOODWORKS_LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * @namespace woodworks::infra::logging
+ * @brief Contains the logging facility.
+ */
+namespace woodworks::infra::logging
+{
+    /**
+     * @enum Level
+     * @brief Severity of a record. Mixed case, since DEBUG and ERROR are common platform macros.
+     */
+    enum class Level : uint8_t
+    {
+        Trace,
+        Debug,
+        Info,
+        Warn,
+        Error,
+        Off
+    };
+
+    /**
+     * @brief Whether records at a level are compiled in at all.
+     */
+    constexpr bool compiledIn(Level level)
+    {
+        return static_cast<int>(level) + 1 > WOODWORKS_LOG_MIN_LEVEL;
+    }
+
+    /**
+     * @brief Name of a level, as printed.
+     */
+    const char *toString(Level level);
+
+    /**
+     * @brief Parses a level name, case-insensitively.
+     * @param name One of trace, debug, info, warn, error or off.
+     * @param fallback Returned for anything else.
+     */
+    Level parseLevel(const std::string &name, Level fallback);
+
+    /**
+     * @struct Field
+     * @brief A key/value pair attached to a record.
+     */
+    struct Field
+    {
+        const char *key;
+        std::string value;
+
+        Field(const char *k, std::string v) : key(k), value(std::move(v)) {}
+        Field(const char *k, const char *v) : key(k), value(v) {}
+        Field(const char *k, const QString &v) : key(k), value(v.toStdString()) {}
+        Field(const char *k, bool v) : key(k), value(v ? "true" : "false") {}
+
+        template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+        Field(const char *k, T v) : key(k)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                char text[32];
+                std::snprintf(text, sizeof(text), "%g", static_cast<double>(v));
+                value = text;
+            }
+            else
+            {
+                value = std::to_string(v);
+            }
+        }
+    };
+
+    /**
+     * @struct Record
+     * @brief One log entry.
+     */
+    struct Record
+    {
+        Level level{Level::Info};
+        const char *category{""};
+        std::string message;
+        std::vector<Field> fields;
+        std::chrono::system_clock::time_point time;
+    };
+
+    /**
+     * @class RingBuffer
+     * @brief Bounded multi-producer, single-consumer queue of records.
+     *
+     * Each slot carries a sequence number, so producers claim slots with a
+     * single compare-and-swap and never block one another or the consumer.
+     * A full buffer rejects the push instead of waiting.
+     */
+    class RingBuffer
+    {
+    public:
+        /**
+         * @param capacity Number of slots, rounded up to a power of two.
+         */
+        explicit RingBuffer(size_t capacity);
+
+        /** @brief Adds a record; false if the buffer is full. */
+        bool push(Record &&record);
+
+        /** @brief Takes the oldest record; false if the buffer is empty. Consumer thread only. */
+        bool pop(Record &out);
+
+        size_t capacity() const { return mask_ + 1; }
+
+    private:
+        struct Slot
+        {
+            std::atomic<size_t> sequence{0};
+            Record record;
+        };
+
+        std::unique_ptr<Slot[]> slots_;
+        size_t mask_;
+        alignas(64) std::atomic<size_t> head_{0};
+        alignas(64) std::atomic<size_t> tail_{0};
+    };
+
+    /**
+     * @class Logger
+     * @brief Process-wide logger with a background drain thread.
+     */
+    class Logger
+    {
+    public:
+        using Sink = std::function<void(const Record &)>;
+
+        /**
+         * @brief Retrieves the singleton logger, starting its drain thread on first use.
+         */
+        static Logger &instance();
+
+        ~Logger();
+        Logger(const Logger &) = delete;
+        Logger &operator=(const Logger &) = delete;
+
+        /** @brief Sets the runtime verbosity; records below it are discarded. */
+        void setLevel(Level level) { level_.store(level, std::memory_order_relaxed); }
+        Level level() const { return level_.load(std::memory_order_relaxed); }
+        bool enabled(Level level) const { return level >= level_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Queues a record for the drain thread.
+         * @param level Severity.
+         * @param category Subsystem, e.g. "repository"; must outlive the program.
+         * @param message What happened.
+         * @param fields Structured details.
+         */
+        void write(Level level, const char *category, std::string message, std::initializer_list<Field> fields = {});
+
+        /**
+         * @brief Replaces where drained records go; the default prints one logfmt line per record to stderr.
+         */
+        void setSink(Sink sink);
+
+        /** @brief Blocks until every record queued so far has reached the sink. */
+        void flush();
+
+        /** @brief Records discarded because the buffer was full. */
+        size_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+        /** @brief Formats a record as a single logfmt line. */
+        static std::string format(const Record &record);
+
+    private:
+        Logger();
+        void drain();
+
+        std::atomic<Level> level_;
+        RingBuffer buffer_;
+        std::atomic<size_t> queued_{0};
+        std::atomic<size_t> drained_{0};
+        std::atomic<size_t> dropped_{0};
+        std::atomic<bool> stopping_{false};
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable drainedSignal_;
+        Sink sink_;
+        std::thread thread_;
+    };
+}
+
+#define WOODWORKS_LOG(level, category, ...)                                                          \
+    do                                                                                               \
+    {                                                                                                \
+        if constexpr (::woodworks::infra::logging::compiledIn(level))                               \
+        {                                                                                            \
+            auto &woodworksLogger_ = ::woodworks::infra::logging::Logger::instance();                \
+            if (woodworksLogger_.enabled(level))                                                     \
+            {                                                                                        \
+                woodworksLogger_.write(level, category, __VA_ARGS__);                                \
+            }                                                                                        \
+        }                                                                                            \
+    } while (0)
+
+#define WOODWORKS_LOG_TRACE(category, ...) WOODWORKS_LOG(::woodworks::infra::logging::Level::Trace, category, __VA_ARGS__)
+#define WOODWORKS_LOG_DEBUG(category, ...) WOODWORKS_LOG(::woodworks::infra::logging::Level::Debug, category, __VA_ARGS__)
+#define WOODWORKS_LOG_INFO(category, ...) WOODWORKS_LOG(::woodworks::infra::logging::Level::Info, category, __VA_ARGS__)
+#define WOODWORKS_LOG_WARN(category, ...) WOODWORKS_LOG(::woodworks::infra::logging::Level::Warn, category, __VA_ARGS__)
+#define WOODWORKS_LOG_ERROR(category, ...) WOODWORKS_LOG(::woodworks::infra::logging::Level::Error, category, __VA_ARGS__)
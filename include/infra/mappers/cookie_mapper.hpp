@@ -2,57 +2,41 @@
 
 #include "domain/cookie.hpp"
 #include "view_helpers.hpp"
+#include "infra/name_table.hpp"
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QByteArray>
 
 namespace woodworks::domain
 {
-    inline QString Cookie::createDbSQL()
-    {
-        return u8R"(
-            CREATE TABLE IF NOT EXISTS cookies (
-                id INTEGER PRIMARY KEY AUTOINCREMENT,
-                species TEXT NOT NULL,
-                length REAL NOT NULL,
-                diameter REAL NOT NULL,
-                drying INTEGER NOT NULL,
-                worth INTEGER NOT NULL,
-                location TEXT,
-                notes TEXT,
-                image BLOB
-            )
-        )";
-    }
-
     inline QString Cookie::individualViewSQL()
     {
         return woodworks::infra::makeIndividualViewSQL(
-            "display_cookies", "cookies",
+            "display_cookies", woodworks::infra::withNames("cookies"),
             QStringList{
-                "id AS 'ID'",
-                "species AS 'Species'",
+                "cookies.id AS 'ID'",
+                "species.name AS 'Species'",
                 "ROUND(length/16.0,2) AS 'Thickness (in)'",
                 "ROUND(diameter/16.0,2) AS 'Diameter (in)'",
                 "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying'",
                 "printf('%.2f',worth/100.0) AS 'Worth ($)'",
-                "location AS 'Location'",
+                "storage_bins.name AS 'Location'",
                 "notes AS 'Notes'"});
     }
 
     inline QString Cookie::groupedViewSQL()
     {
         return woodworks::infra::makeGroupedViewSQL(
-            "display_cookies_grouped", "cookies",
+            "display_cookies_grouped", woodworks::infra::withNames("cookies"),
             QStringList{
                 "COUNT(*) AS 'Count'",
-                "species AS 'Species'",
+                "species.name AS 'Species'",
                 "ROUND(length/16.0,2) AS 'Thickness (in)'",
                 "ROUND(diameter/16.0,2) AS 'Diameter (in)'",
                 "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying'",
                 "ROUND(AVG(worth)/100.0,2) AS 'Avg Worth ($)'"},
             QStringList{
-                "species",
+                "species_id",
                 "ROUND(length/16.0,2)",
                 "ROUND(diameter/16.0,2)",
                 "drying"});
@@ -60,12 +44,12 @@ namespace woodworks::domain
 
     inline QString Cookie::insertSQL()
     {
-        return "INSERT INTO cookies (species, length, diameter, drying, worth, location, notes, image) VALUES (:species, :length, :diameter, :drying, :worth, :location, :notes, :image)";
+        return "INSERT INTO cookies (species_id, length, diameter, drying, worth, location_id, notes, image) VALUES (:species_id, :length, :diameter, :drying, :worth, :location_id, :notes, :image)";
     }
 
     inline QString Cookie::updateSQL()
     {
-        return "UPDATE cookies SET species = :species, length = :length, diameter = :diameter, drying = :drying, worth = :worth, location = :location, notes = :notes, image = :image WHERE id = :id";
+        return "UPDATE cookies SET species_id = :species_id, length = :length, diameter = :diameter, drying = :drying, worth = :worth, location_id = :location_id, notes = :notes, image = :image WHERE id = :id";
     }
 
     inline QString Cookie::selectOneSQL() { return u8R"(SELECT * FROM cookies WHERE id=:id)"; }
@@ -76,39 +60,55 @@ namespace woodworks::domain
 
     inline void Cookie::bindForInsert(QSqlQuery &q, const Cookie &cookie)
     {
-        q.bindValue(":species", QString::fromStdString(cookie.species.name));
+        q.bindValue(":species_id", woodworks::infra::speciesKey(cookie.species.name));
         q.bindValue(":length", cookie.length.toTicks());
         q.bindValue(":diameter", cookie.diameter.toTicks());
         q.bindValue(":drying", static_cast<int>(cookie.drying));
         q.bindValue(":worth", cookie.worth.cents);
-        q.bindValue(":location", QString::fromStdString(cookie.location));
+        q.bindValue(":location_id", woodworks::infra::locationKey(cookie.location));
         q.bindValue(":notes", QString::fromStdString(cookie.notes));
         q.bindValue(":image", cookie.imageBuffer);
     }
 
     inline void Cookie::bindForUpdate(QSqlQuery &q, const Cookie &cookie)
     {
-        q.bindValue(":species", QString::fromStdString(cookie.species.name));
+        q.bindValue(":species_id", woodworks::infra::speciesKey(cookie.species.name));
         q.bindValue(":length", cookie.length.toTicks());
         q.bindValue(":diameter", cookie.diameter.toTicks());
         q.bindValue(":drying", static_cast<int>(cookie.drying));
         q.bindValue(":worth", cookie.worth.cents);
-        q.bindValue(":location", QString::fromStdString(cookie.location));
+        q.bindValue(":location_id", woodworks::infra::locationKey(cookie.location));
         q.bindValue(":notes", QString::fromStdString(cookie.notes));
         q.bindValue(":image", cookie.imageBuffer);
         q.bindValue(":id", cookie.id.id);
     }
 
+    inline QString Cookie::tableName() { return "cookies"; }
+
+    inline QVariantMap Cookie::columnValues(const Cookie &cookie)
+    {
+        return QVariantMap{
+            {"species_id", woodworks::infra::speciesKey(cookie.species.name)},
+            {"length", cookie.length.toTicks()},
+            {"diameter", cookie.diameter.toTicks()},
+            {"drying", static_cast<int>(cookie.drying)},
+            {"worth", cookie.worth.cents},
+            {"location_id", woodworks::infra::locationKey(cookie.location)},
+            {"notes", QString::fromStdString(cookie.notes)},
+            {"image", cookie.imageBuffer},
+        };
+    }
+
     inline Cookie Cookie::fromRecord(const QSqlRecord &record)
     {
         Cookie cookie;
         cookie.id = Id{record.value("id").toInt()};
-        cookie.species = Species{record.value("species").toString().toStdString()};
+        cookie.species = woodworks::infra::speciesFromKey(record.value("species_id").toInt());
         cookie.length = Length::fromTicks(record.value("length").toDouble());
         cookie.diameter = Length::fromTicks(record.value("diameter").toDouble());
         cookie.drying = static_cast<Drying>(record.value("drying").toInt());
         cookie.worth = Dollar{record.value("worth").toInt()};
-        cookie.location = record.value("location").toString().toStdString();
+        cookie.location = woodworks::infra::NameTable::locations().name(record.value("location_id").toInt());
         cookie.notes = record.value("notes").toString().toStdString();
         cookie.imageBuffer = record.value("image").toByteArray();
         return cookie;
@@ -10,6 +10,7 @@
 #include "view_helpers.hpp"
 
 #include "infra/connection.hpp"
+#include "infra/sql_trace.hpp"
 
 #include <QString>
 #include <QSqlQuery>
@@ -22,25 +23,11 @@ using namespace woodworks::infra;
 
 namespace woodworks::domain
 {
-    inline QString CustomCut::createDbSQL()
+    /// Entity cache size, without the image; CustomCut has no Species or location.
+    inline size_t cacheFootprint(const CustomCut &cut)
     {
-        return u8R"(
-            CREATE TABLE IF NOT EXISTS cutlist (
-                id INTEGER PRIMARY KEY AUTOINCREMENT,
-                project TEXT NOT NULL,
-                part TEXT NOT NULL,
-                code TEXT NOT NULL,
-                quantity INTEGER NOT NULL,
-                t INTEGER NOT NULL,
-                w INTEGER NOT NULL,
-                l INTEGER NOT NULL,
-                species TEXT NOT NULL,
-                progress_rough INTEGER NOT NULL,
-                progress_finished INTEGER NOT NULL,
-                notes TEXT,
-                image BLOB
-            )
-        )";
+        return sizeof(CustomCut) + cut.project.capacity() + cut.part.capacity() + cut.code.capacity() +
+               cut.species.capacity() + cut.notes.capacity();
     }
 
     // Individual and group views aren't used and are dummies, but are needed to make the template happy
@@ -245,6 +232,26 @@ namespace woodworks::domain
         query.bindValue(12, cut.id.id);
     }
 
+    inline QString CustomCut::tableName() { return "cutlist"; }
+
+    inline QVariantMap CustomCut::columnValues(const CustomCut &cut)
+    {
+        return QVariantMap{
+            {"project", QString::fromStdString(cut.project)},
+            {"part", QString::fromStdString(cut.part)},
+            {"code", QString::fromStdString(cut.code)},
+            {"quantity", cut.quantity},
+            {"t", cut.t.toTicks()},
+            {"w", cut.w.toTicks()},
+            {"l", cut.l.toTicks()},
+            {"species", QString::fromStdString(cut.species)},
+            {"progress_rough", cut.progress_rough},
+            {"progress_finished", cut.progress_finished},
+            {"notes", QString::fromStdString(cut.notes)},
+            {"image", cut.imageBuffer},
+        };
+    }
+
     inline CustomCut CustomCut::fromRecord(const QSqlRecord &record)
     {
         return CustomCut{
@@ -266,7 +273,7 @@ namespace woodworks::domain
     // Very simple query on the woodworks.db, select all project from cutlist
     inline std::vector<std::string> CustomCut::allProjects()
     {
-        QSqlQuery query;
+        TracedQuery query(QSqlDatabase::database());
         query.prepare("SELECT DISTINCT project FROM cutlist");
         query.exec();
 
@@ -1,78 +1,63 @@
 #pragma once
 #include "domain/firewood.hpp"
 #include "view_helpers.hpp"
+#include "infra/name_table.hpp"
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QString>
 
 namespace woodworks::domain
 {
-    inline QString Firewood::createDbSQL()
-    {
-        return QString::fromStdString(u8R"(
-            CREATE TABLE IF NOT EXISTS firewood (
-                id INTEGER PRIMARY KEY AUTOINCREMENT,
-                species TEXT NOT NULL,
-                cubicFeet REAL NOT NULL,
-                drying INTEGER NOT NULL,
-                cost INTEGER NOT NULL,
-                location TEXT,
-                notes TEXT,
-                image BLOB
-            )
-        )");
-    }
-
     // No individual view for firewood, but we still need to define the function
     inline QString Firewood::individualViewSQL()
     {
         return woodworks::infra::makeIndividualViewSQL(
-            "display_firewood", "firewood",
+            "display_firewood", woodworks::infra::withNames("firewood"),
             QStringList{
-                "id AS 'ID'",
-                "species AS 'Species'",
+                "firewood.id AS 'ID'",
+                "species.name AS 'Species'",
                 "ROUND(cubicFeet,2) AS 'Cubic Feet'",
                 "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying'",
                 "ROUND(cost/100.0,2) AS 'Cost ($)'",
-                "location AS 'Location'",
+                "storage_bins.name AS 'Location'",
                 "notes AS 'Notes'"});
     }
 
     inline QString Firewood::groupedViewSQL()
     {
         return woodworks::infra::makeGroupedViewSQL(
-            "display_firewood_grouped", "firewood",
+            "display_firewood_grouped", woodworks::infra::withNames("firewood"),
             QStringList{
-                "id AS 'ID'",
-                "species AS 'Species'",
-                "location AS 'Location'",
+                "firewood.id AS 'ID'",
+                "species.name AS 'Species'",
+                "storage_bins.name AS 'Location'",
                 "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying'",
                 "ROUND(sum(cubicFeet),2) AS 'Cubic Feet'",
                 "ROUND(sum(cubicFeet)/128.0,2) AS 'Chords'",
                 "ROUND(SUM(cost)/100.0,2) AS 'Cost ($)'"},
             QStringList{
-                "species",
+                "species_id",
                 "drying",
-                "location"});
+                "location_id"});
     }
     inline QString Firewood::insertSQL()
     {
-        return "INSERT INTO firewood (species, cubicFeet, drying, cost, location, notes, image) VALUES (:species, :cubicFeet, :drying, :cost, :location, :notes, :image)";
+        return "INSERT INTO firewood (species_id, cubicFeet, drying, cost, location_id, notes, image) VALUES (:species_id, :cubicFeet, :drying, :cost, :location_id, :notes, :image)";
     }
     inline QString Firewood::updateSQL()
     {
-        return "UPDATE firewood SET species = :species, cubicFeet = :cubicFeet, drying = :drying, cost = :cost, location = :location, notes = :notes, image = :image WHERE id = :id";
+        return "UPDATE firewood SET species_id = :species_id, cubicFeet = :cubicFeet, drying = :drying, cost = :cost, location_id = :location_id, notes = :notes, image = :image WHERE id = :id";
     }
     inline QString Firewood::selectOneSQL() { return u8R"(SELECT * FROM firewood WHERE id=:id)"; }
     inline QString Firewood::selectAllSQL() { return u8R"(SELECT * FROM firewood)"; }
     inline QString Firewood::deleteSQL() { return u8R"(DELETE FROM firewood WHERE id=:id)"; }
     inline void Firewood::bindForInsert(QSqlQuery &q, const Firewood &firewood)
     {
-        q.bindValue(":species", QString::fromStdString(firewood.species.name));
+        q.bindValue(":species_id", woodworks::infra::speciesKey(firewood.species.name));
         q.bindValue(":cubicFeet", firewood.cubicFeet);
         q.bindValue(":drying", static_cast<int>(firewood.drying));
         q.bindValue(":cost", firewood.cost.cents);
-        q.bindValue(":location", QString::fromStdString(firewood.location));
+        q.bindValue(":location_id", woodworks::infra::locationKey(firewood.location));
         q.bindValue(":notes", QString::fromStdString(firewood.notes));
         q.bindValue(":image", firewood.imageBuffer);
     }
@@ -80,24 +65,39 @@ namespace woodworks::domain
     inline void Firewood::bindForUpdate(QSqlQuery &q, const Firewood &firewood)
     {
         q.bindValue(":id", firewood.id.id);
-        q.bindValue(":species", QString::fromStdString(firewood.species.name));
+        q.bindValue(":species_id", woodworks::infra::speciesKey(firewood.species.name));
         q.bindValue(":cubicFeet", firewood.cubicFeet);
         q.bindValue(":drying", static_cast<int>(firewood.drying));
         q.bindValue(":cost", firewood.cost.cents);
-        q.bindValue(":location", QString::fromStdString(firewood.location));
+        q.bindValue(":location_id", woodworks::infra::locationKey(firewood.location));
         q.bindValue(":notes", QString::fromStdString(firewood.notes));
         q.bindValue(":image", firewood.imageBuffer);
     }
 
+    inline QString Firewood::tableName() { return "firewood"; }
+
+    inline QVariantMap Firewood::columnValues(const Firewood &firewood)
+    {
+        return QVariantMap{
+            {"species_id", woodworks::infra::speciesKey(firewood.species.name)},
+            {"cubicFeet", firewood.cubicFeet},
+            {"drying", static_cast<int>(firewood.drying)},
+            {"cost", firewood.cost.cents},
+            {"location_id", woodworks::infra::locationKey(firewood.location)},
+            {"notes", QString::fromStdString(firewood.notes)},
+            {"image", firewood.imageBuffer},
+        };
+    }
+
     inline Firewood Firewood::fromRecord(const QSqlRecord &record)
     {
         Firewood fw;
         fw.id = Id{record.value("id").toInt()};
-        fw.species = Species{record.value("species").toString().toStdString()};
+        fw.species = woodworks::infra::speciesFromKey(record.value("species_id").toInt());
         fw.cubicFeet = record.value("cubicFeet").toDouble();
         fw.drying = static_cast<Drying>(record.value("drying").toInt());
         fw.cost = Dollar{record.value("cost").toInt()};
-        fw.location = record.value("location").toString().toStdString();
+        fw.location = woodworks::infra::NameTable::locations().name(record.value("location_id").toInt());
         fw.notes = record.value("notes").toString().toStdString();
         fw.imageBuffer = record.value("image").toByteArray();
         return fw;
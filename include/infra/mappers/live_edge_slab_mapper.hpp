@@ -2,46 +2,57 @@
 #include "domain/live_edge_slab.hpp"
 #include <QSqlQuery>
 #include <QSqlRecord>
+#include "infra/name_table.hpp"
 
 namespace woodworks::domain
 {
-    inline QString LiveEdgeSlab::createDbSQL()
-    {
-        return u8R"(
-            CREATE TABLE IF NOT EXISTS live_edge_slabs (
-                id INTEGER PRIMARY KEY AUTOINCREMENT,
-                species TEXT NOT NULL,
-                length REAL NOT NULL,
-                width REAL NOT NULL,
-                thickness REAL NOT NULL,
-                drying INTEGER NOT NULL,
-                surfacing INTEGER NOT NULL,
-                worth INTEGER NOT NULL,
-                location TEXT,
-                notes TEXT,
-                image BLOB
-            )
-        )";
-    }
-
     inline QString LiveEdgeSlab::individualViewSQL()
     {
-        return u8R"(CREATE VIEW IF NOT EXISTS display_slabs AS SELECT id AS 'ID', species AS 'Species', ROUND(length/16.0,2) AS 'Length (in)', ROUND(width/16.0,2) AS 'Width (in)', ROUND(thickness/16.0,2) AS 'Thickness (in)', CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying', CASE surfacing WHEN 0 THEN 'RGH' WHEN 1 THEN 'S1S' WHEN 2 THEN 'S2S' END AS 'Surfacing', printf('%.2f',worth/100.0) AS 'Worth ($)', location AS 'Location', notes AS 'Notes' FROM live_edge_slabs)";
+        return woodworks::infra::makeIndividualViewSQL(
+            "display_slabs", woodworks::infra::withNames("live_edge_slabs"),
+            QStringList{
+                "live_edge_slabs.id AS 'ID'",
+                "species.name AS 'Species'",
+                "ROUND(length/16.0,2) AS 'Length (in)'",
+                "ROUND(width/16.0,2) AS 'Width (in)'",
+                "ROUND(thickness/16.0,2) AS 'Thickness (in)'",
+                "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying'",
+                "CASE surfacing WHEN 0 THEN 'RGH' WHEN 1 THEN 'S1S' WHEN 2 THEN 'S2S' END AS 'Surfacing'",
+                "printf('%.2f',worth/100.0) AS 'Worth ($)'",
+                "storage_bins.name AS 'Location'",
+                "notes AS 'Notes'"});
     }
 
     inline QString LiveEdgeSlab::groupedViewSQL()
     {
-        return "CREATE VIEW IF NOT EXISTS display_slabs_grouped AS SELECT COUNT(*) AS 'Count', species AS 'Species', ROUND(length/16.0,2) AS 'Length (in)', ROUND(width/16.0,2) AS 'Width (in)', ROUND(thickness/16.0,2) AS 'Thickness (in)', CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying', CASE surfacing WHEN 0 THEN 'RGH' WHEN 1 THEN 'S1S' WHEN 2 THEN 'S2S' END AS 'Surfacing', ROUND(AVG(worth)/100.0,2) AS 'Avg Worth ($)' FROM live_edge_slabs GROUP BY species, ROUND(length/16.0,2), ROUND(width/16.0,2), ROUND(thickness/16.0,2), drying, surfacing";
+        return woodworks::infra::makeGroupedViewSQL(
+            "display_slabs_grouped", woodworks::infra::withNames("live_edge_slabs"),
+            QStringList{
+                "COUNT(*) AS 'Count'",
+                "species.name AS 'Species'",
+                "ROUND(length/16.0,2) AS 'Length (in)'",
+                "ROUND(width/16.0,2) AS 'Width (in)'",
+                "ROUND(thickness/16.0,2) AS 'Thickness (in)'",
+                "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying'",
+                "CASE surfacing WHEN 0 THEN 'RGH' WHEN 1 THEN 'S1S' WHEN 2 THEN 'S2S' END AS 'Surfacing'",
+                "ROUND(AVG(worth)/100.0,2) AS 'Avg Worth ($)'"},
+            QStringList{
+                "species_id",
+                "ROUND(length/16.0,2)",
+                "ROUND(width/16.0,2)",
+                "ROUND(thickness/16.0,2)",
+                "drying",
+                "surfacing"});
     }
 
     inline QString LiveEdgeSlab::insertSQL()
     {
-        return "INSERT INTO live_edge_slabs (species, length, width, thickness, drying, surfacing, worth, location, notes, image) VALUES (:species, :length, :width, :thickness, :drying, :surfacing, :worth, :location, :notes, :image)";
+        return "INSERT INTO live_edge_slabs (species_id, length, width, thickness, drying, surfacing, worth, location_id, notes, image) VALUES (:species_id, :length, :width, :thickness, :drying, :surfacing, :worth, :location_id, :notes, :image)";
     }
 
     inline QString LiveEdgeSlab::updateSQL()
     {
-        return "UPDATE live_edge_slabs SET species = :species, length = :length, width = :width, thickness = :thickness, drying = :drying, surfacing = :surfacing, worth = :worth, location = :location, notes = :notes, image = :image WHERE id = :id";
+        return "UPDATE live_edge_slabs SET species_id = :species_id, length = :length, width = :width, thickness = :thickness, drying = :drying, surfacing = :surfacing, worth = :worth, location_id = :location_id, notes = :notes, image = :image WHERE id = :id";
     }
 
     inline QString LiveEdgeSlab::selectOneSQL() { return u8R"(SELECT * FROM live_edge_slabs WHERE id=:id)"; }
@@ -52,45 +63,63 @@ namespace woodworks::domain
 
     inline void LiveEdgeSlab::bindForInsert(QSqlQuery &q, const LiveEdgeSlab &slab)
     {
-        q.bindValue(":species", QString::fromStdString(slab.species.name));
+        q.bindValue(":species_id", woodworks::infra::speciesKey(slab.species.name));
         q.bindValue(":length", slab.length.toTicks());
         q.bindValue(":width", slab.width.toTicks());
         q.bindValue(":thickness", slab.thickness.toTicks());
         q.bindValue(":drying", static_cast<int>(slab.drying));
         q.bindValue(":surfacing", static_cast<int>(slab.surfacing));
         q.bindValue(":worth", static_cast<int>(slab.worth.toCents()));
-        q.bindValue(":location", QString::fromStdString(slab.location));
+        q.bindValue(":location_id", woodworks::infra::locationKey(slab.location));
         q.bindValue(":notes", QString::fromStdString(slab.notes));
         q.bindValue(":image", slab.imageBuffer);
     }
 
     inline void LiveEdgeSlab::bindForUpdate(QSqlQuery &q, const LiveEdgeSlab &slab)
     {
-        q.bindValue(":species", QString::fromStdString(slab.species.name));
+        q.bindValue(":species_id", woodworks::infra::speciesKey(slab.species.name));
         q.bindValue(":length", slab.length.toTicks());
         q.bindValue(":width", slab.width.toTicks());
         q.bindValue(":thickness", slab.thickness.toTicks());
         q.bindValue(":drying", static_cast<int>(slab.drying));
         q.bindValue(":surfacing", static_cast<int>(slab.surfacing));
         q.bindValue(":worth", static_cast<int>(slab.worth.toCents()));
-        q.bindValue(":location", QString::fromStdString(slab.location));
+        q.bindValue(":location_id", woodworks::infra::locationKey(slab.location));
         q.bindValue(":notes", QString::fromStdString(slab.notes));
         q.bindValue(":image", slab.imageBuffer);
         q.bindValue(":id", slab.id.id);
     }
 
+    inline QString LiveEdgeSlab::tableName() { return "live_edge_slabs"; }
+
+    inline QVariantMap LiveEdgeSlab::columnValues(const LiveEdgeSlab &slab)
+    {
+        return QVariantMap{
+            {"species_id", woodworks::infra::speciesKey(slab.species.name)},
+            {"length", slab.length.toTicks()},
+            {"width", slab.width.toTicks()},
+            {"thickness", slab.thickness.toTicks()},
+            {"drying", static_cast<int>(slab.drying)},
+            {"surfacing", static_cast<int>(slab.surfacing)},
+            {"worth", static_cast<int>(slab.worth.toCents())},
+            {"location_id", woodworks::infra::locationKey(slab.location)},
+            {"notes", QString::fromStdString(slab.notes)},
+            {"image", slab.imageBuffer},
+        };
+    }
+
     inline LiveEdgeSlab LiveEdgeSlab::fromRecord(const QSqlRecord &record)
     {
         LiveEdgeSlab slab;
         slab.id = Id{record.value("id").toInt()};
-        slab.species = Species{record.value("species").toString().toStdString()};
+        slab.species = woodworks::infra::speciesFromKey(record.value("species_id").toInt());
         slab.length = Length::fromTicks(record.value("length").toDouble());
         slab.width = Length::fromTicks(record.value("width").toDouble());
         slab.thickness = Length::fromTicks(record.value("thickness").toDouble());
         slab.drying = static_cast<Drying>(record.value("drying").toInt());
         slab.surfacing = static_cast<SlabSurfacing>(record.value("surfacing").toInt());
         slab.worth = Dollar{record.value("worth").toInt()};
-        slab.location = record.value("location").toString().toStdString();
+        slab.location = woodworks::infra::NameTable::locations().name(record.value("location_id").toInt());
         slab.notes = record.value("notes").toString().toStdString();
         slab.imageBuffer = record.value("image").toByteArray();
         return slab;
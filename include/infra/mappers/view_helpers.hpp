@@ -1,6 +1,14 @@
 /**
  * @file view_helpers.hpp
  * @brief Provides helper functions and structures for creating and managing database views and filters.
+ *
+ * Views built with makeIndividualViewSQL and makeGroupedViewSQL are remembered
+ * as DisplayView definitions. makeFilteredModel then compiles filters on their
+ * display columns into bound predicates on the base table: a range on
+ * `ROUND(length/192.0,2) AS 'Length (ft)'` becomes a tick range on `length`,
+ * `'Kiln Dried'` on the drying label becomes `drying = 1`, and a species
+ * name becomes `species_id = ?`, so the inventory indexes apply. Filters that cannot be translated are
+ * applied to the view's output, still as bound parameters.
  */
 
 #pragma once
@@ -14,15 +22,54 @@
 #include <QVariant>
 #include <variant>
 #include <optional>
+#include <vector>
+#include <map>
 #include <iostream>
 #include <iomanip>
 
+#include "infra/logging.hpp"
+#include "infra/sql_trace.hpp"
+
 /**
  * @namespace woodworks::infra
  * @brief Contains infrastructure-related classes and utilities.
  */
 namespace woodworks::infra
 {
+    /**
+     * @struct DisplayView
+     * @brief The definition of a display view, kept so filters can be compiled against its base table.
+     */
+    struct DisplayView
+    {
+        QString name;
+        QString table;
+        QStringList columns; ///< Select expressions, each `expr AS 'Alias'`.
+        QStringList groupBy; ///< Empty for individual views.
+    };
+
+    /** @brief Remembers a view's definition; called by the view builders below. */
+    void registerDisplayView(const DisplayView &view);
+
+    /** @brief The definition of an inventory display view, or std::nullopt for other tables and views. */
+    std::optional<DisplayView> displayView(const QString &name);
+
+    /**
+     * @brief The labels a display column shows for stored codes, from its `CASE col WHEN ...` expression.
+     * @return Code to label; empty if the view or column is unknown or is not a CASE.
+     */
+    std::map<int, QString> displayLabels(const QString &view, const QString &alias);
+
+    /**
+     * @brief A table joined to the species and storage_bins names its keys refer to, for display views.
+     * @param table The inventory table.
+     * @return The FROM clause; select `species.name` and `storage_bins.name` for the names.
+     */
+    inline QString withNames(const QString &table)
+    {
+        return QString("%1 JOIN species ON species.id = %1.species_id LEFT JOIN storage_bins ON storage_bins.id = %1.location_id").arg(table);
+    }
+
     /**
      * @brief Creates an SQL statement for an individual view.
      * @param viewName The name of the view.
@@ -32,6 +79,7 @@ namespace woodworks::infra
      */
     inline QString makeIndividualViewSQL(const QString &viewName, const QString &tableName, const QStringList &columns)
     {
+        registerDisplayView(DisplayView{viewName, tableName, columns, {}});
         QString selectCols = columns.join(", ");
         return QString("CREATE VIEW IF NOT EXISTS %1 AS SELECT %2 FROM %3")
             .arg(viewName)
@@ -49,6 +97,7 @@ namespace woodworks::infra
      */
     inline QString makeGroupedViewSQL(const QString &viewName, const QString &tableName, const QStringList &selectExprs, const QStringList &groupByExprs)
     {
+        registerDisplayView(DisplayView{viewName, tableName, selectExprs, groupByExprs});
         QString selectCols = selectExprs.join(", ");
         QString groupBy = groupByExprs.join(", ");
         return QString("CREATE VIEW IF NOT EXISTS %1 AS SELECT %2 FROM %3 GROUP BY %4")
@@ -67,10 +116,10 @@ namespace woodworks::infra
     inline QSqlQueryModel *makeViewModel(const QString &viewName, QObject *parent)
     {
         QSqlQueryModel *model = new QSqlQueryModel(parent);
-        model->setQuery(QString("SELECT * FROM %1").arg(viewName), QSqlDatabase::database());
+        setTracedQuery(model, QString("SELECT * FROM %1").arg(viewName));
         if (model->lastError().isValid())
         {
-            qDebug() << "Query error:" << model->lastError().text();
+            WOODWORKS_LOG_WARN("views", "query error", {{"view", viewName}, {"error", model->lastError().text()}});
         }
         return model;
     }
@@ -204,61 +253,56 @@ namespace woodworks::infra
     };
 
     /**
-     * @brief Creates a filtered QSqlQueryModel based on the provided filters.
-     * @param tableOrView The table or view to query.
-     * @param filters The filters to apply.
-     * @param parent The parent QObject.
-     * @return A pointer to the QSqlQueryModel.
+     * @struct BasePredicate
+     * @brief One compiled filter term on a base-table column, for evaluating filters without SQL.
      */
-    inline QSqlQueryModel *makeFilteredModel(const QString &tableOrView, const QVector<FieldFilter> &filters, QObject *parent = nullptr)
+    struct BasePredicate
     {
-        // ‑‑ Build WHERE clause if we have filters
-        QStringList clauses;
-        clauses.reserve(filters.size());
-
-        for (const FieldFilter &f : filters)
-        {
-            std::visit([&](auto &&r)
-                       {
-            using T = std::decay_t<decltype(r)>;
-
-            if constexpr (std::is_same_v<T, Exact>) {
-                // strings need quoting, others don’t
-                if (r.value.type() == QVariant::String)
-                    clauses << QString("%1 = '%2'").arg(f.column, r.value.toString());
-                else
-                    clauses << QString("%1 = %2").arg(f.column).arg(r.value.toString());
-            }
-            else if constexpr (std::is_same_v<T, Numeric>) {
-                clauses << QString("%1 >= %2").arg(f.column).arg(r.minValue);
-            }
-            else if constexpr (std::is_same_v<T, EnumInc>) {
-                if (r.chosen.has_value())          // only filter if they asked for a specific variant
-                    clauses << QString("%1 = %2").arg(f.column).arg(*r.chosen);
-            }
-            else if constexpr (std::is_same_v<T, Max>) {
-                clauses << QString("%1 <= %2").arg(f.column).arg(r.maxValue);
-            }
-            else if constexpr (std::is_same_v<T, Between>) {
-                clauses << QString("%1 BETWEEN %2 AND %3").arg(f.column).arg(r.minValue).arg(r.maxValue);
-            } }, f.rule);
-        }
-
-        QString where = clauses.isEmpty() ? QString()
-                                          : QStringLiteral(" WHERE ") + clauses.join(" AND ");
-
-        // Final query
-        QString sql = QStringLiteral("SELECT * FROM %1%2").arg(tableOrView, where);
+        QString column;
+        QVariant equals;  ///< Set for `column = ?`; otherwise a range.
+        QVariant atLeast; ///< Inclusive lower bound, if set.
+        QVariant below;   ///< Exclusive upper bound, if set.
+    };
 
-        std::cout << "[makeFilteredModel] SQL:" << sql.toStdString() << std::endl;
+    /**
+     * @struct CompiledFilter
+     * @brief A filtered query with positional placeholders and the values to bind to them.
+     */
+    struct CompiledFilter
+    {
+        QString sql;             ///< Depends only on the filters' shape, not their values.
+        QVector<QVariant> bound; ///< In placeholder order.
+        std::vector<BasePredicate> predicates; ///< The base-table terms of `sql`, in order.
+        bool baseOnly{false};    ///< Every filter became a base-table term, so `predicates` is the whole filter.
+    };
 
-        auto *model = new QSqlQueryModel(parent);
-        model->setQuery(sql, QSqlDatabase::database());
+    /**
+     * @brief Compiles filters into a parameterized query.
+     * @param tableOrView The table or view to query.
+     * @param filters The filters to apply.
+     * @return The statement and its values.
+     */
+    CompiledFilter compileFilters(const QString &tableOrView, const QVector<FieldFilter> &filters);
 
-        if (model->lastError().isValid())
-            qDebug() << "[makeFilteredModel] query error:" << model->lastError().text()
-                     << "\nSQL:" << sql;
+    /**
+     * @brief The base-table columns a display view's filters can compile to.
+     * @return Empty for views that are not inventory display views.
+     */
+    QStringList filterableColumns(const QString &view);
 
-        return model;
-    }
-}
\ No newline at end of file
+    /**
+     * @brief Creates a filtered QSqlQueryModel based on the provided filters.
+     *
+     * The prepared statement is cached per filter shape, so refreshing with new
+     * values rebinds it instead of planning again. Re-running a statement
+     * replaces the result its model reads from, so the cached one is reused
+     * only when its model is gone or is the one being replaced, which is
+     * cleared first. Otherwise the new model gets a freshly prepared statement.
+     * @param tableOrView The table or view to query.
+     * @param filters The filters to apply.
+     * @param parent The parent QObject.
+     * @param replacing The model the new one replaces, if any; it must not be used afterwards.
+     * @return A pointer to the QSqlQueryModel.
+     */
+    QSqlQueryModel *makeFilteredModel(const QString &tableOrView, const QVector<FieldFilter> &filters, QObject *parent = nullptr, QSqlQueryModel *replacing = nullptr);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file migrations.hpp
+ * @brief Provides versioned schema migrations for the application database.
+ *
+ * The schema version lives in SQLite's `PRAGMA user_version`, so checking it
+ * at startup is a header read with no DDL. Each migration runs in its own
+ * transaction, bumps the version and appends a row to `schema_migrations`.
+ *
+ * To change a table or view, add a migration at the end of the list in
+ * migrations.cpp with the next version number; never edit one that has shipped.
+ */
+
+#pragma once
+
+#include <QSqlDatabase>
+
+#include <functional>
+#include <vector>
+
+/**
+ * @namespace woodworks::infra
+ * @brief Contains infrastructure-related classes and utilities.
+ */
+namespace woodworks::infra
+{
+    /**
+     * @struct Migration
+     * @brief One step of the schema's history.
+     */
+    struct Migration
+    {
+        int version;                              ///< Schema version after this step.
+        const char *description;                  ///< Recorded in schema_migrations.
+        std::function<void(QSqlDatabase &)> apply; ///< Throws std::runtime_error on failure.
+    };
+
+    /**
+     * @struct MigrationReport
+     * @brief What a call to SchemaMigrator::migrate did.
+     */
+    struct MigrationReport
+    {
+        int fromVersion{0};
+        int toVersion{0};
+        int applied{0};
+        double seconds{0.0};
+    };
+
+    /**
+     * @class SchemaMigrator
+     * @brief Brings a database up to the latest schema version.
+     */
+    class SchemaMigrator
+    {
+    public:
+        /** @brief Every migration, in version order. */
+        static const std::vector<Migration> &migrations();
+
+        /** @brief The version the code expects. */
+        static int latestVersion();
+
+        /** @brief The version a database is at; 0 for a new or pre-versioning database. */
+        static int currentVersion(QSqlDatabase &db);
+
+        /**
+         * @brief Applies every migration newer than the database's version.
+         * @param db The database to migrate.
+         * @return What was applied.
+         * @throws std::runtime_error if a migration fails; that migration is rolled back.
+         */
+        static MigrationReport migrate(QSqlDatabase &db);
+
+        /**
+         * @brief Applies the migrations newer than the database's version, up to and including a target, e.g. to test the next one against old data.
+         * @param db The database to migrate.
+         * @param targetVersion The last version to apply.
+         * @return What was applied.
+         * @throws std::runtime_error if a migration fails; that migration is rolled back.
+         */
+        static MigrationReport migrate(QSqlDatabase &db, int targetVersion);
+    };
+}
@@ -0,0 +1,126 @@
+/**
+ * @file name_table.hpp
+ * @brief Provides the in-process interning tables behind the species and storage_bins tables.
+ *
+ * Inventory rows store species and locations as integer keys into those two
+ * tables. A NameTable holds every name and key in memory once it has been read,
+ * so mappers turn names into keys and back without a query. Unknown names
+ * are inserted on first use.
+ *
+ * Keys belong to one database, so every connection gets its own pair of
+ * tables. Mappers have no connection at hand; the repository opens a
+ * NameTable::Scope on its connection around the calls it makes into them,
+ * and lookups without a connection use the innermost scope, else the
+ * default connection.
+ *
+ * A rolled-back transaction may have undone keys the tables handed out, so
+ * UnitOfWork clears them, as it does the entity caches.
+ */
+
+#pragma once
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QVariant>
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "domain/types.hpp"
+
+/**
+ * @namespace woodworks::infra
+ * @brief Contains infrastructure-related classes and utilities.
+ */
+namespace woodworks::infra
+{
+    /**
+     * @class NameTable
+     * @brief Maps the names of one dictionary table to their keys and back.
+     */
+    class NameTable
+    {
+    public:
+        /**
+         * @class Scope
+         * @brief Makes a connection the one species() and locations() use on this thread until destroyed.
+         */
+        class Scope
+        {
+        public:
+            explicit Scope(QSqlDatabase &db);
+            ~Scope();
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            QSqlDatabase *previous_;
+        };
+
+        /** @brief Species names, in the species table of a connection. */
+        static NameTable &species(const QSqlDatabase &db);
+
+        /** @brief Storage locations, in the storage_bins table of a connection. */
+        static NameTable &locations(const QSqlDatabase &db);
+
+        /** @brief Species names of the current scope's connection, else the default connection. */
+        static NameTable &species();
+
+        /** @brief Storage locations of the current scope's connection, else the default connection. */
+        static NameTable &locations();
+
+        /** @brief Empties both tables of a connection; the next lookup reads them again. */
+        static void clearAll(const QSqlDatabase &db);
+
+        /** @brief Empties the tables of every connection. */
+        static void clearAll();
+
+        NameTable(const NameTable &) = delete;
+        NameTable &operator=(const NameTable &) = delete;
+
+        /**
+         * @brief The key of a name, inserting the name if it is new.
+         * @throws std::runtime_error if the name cannot be stored.
+         */
+        int intern(const std::string &name);
+
+        /** @brief The key of a name, without inserting it. */
+        std::optional<int> find(const std::string &name);
+
+        /** @brief The name for a key; empty for 0 or an unknown key. */
+        std::string name(int id);
+
+        const QString &table() const { return table_; }
+
+    private:
+        NameTable(QString table, QString connection) : table_(std::move(table)), connection_(std::move(connection)) {}
+
+        static NameTable &of(const QString &table, const QSqlDatabase &db);
+        static QSqlDatabase &current();
+
+        void loadLocked();
+        void clear();
+
+        QString table_;
+        QString connection_; ///< Name of the connection the keys belong to.
+        std::mutex mutex_;
+        bool loaded_{false};
+        std::unordered_map<std::string, int> ids_;
+        std::unordered_map<int, std::string> names_;
+    };
+
+    /** @brief The species key a mapper stores, interning the name. */
+    inline QVariant speciesKey(const std::string &name) { return NameTable::species().intern(name); }
+
+    /** @brief The species a mapper reads back from a key. */
+    inline domain::types::Species speciesFromKey(int id) { return domain::types::Species{NameTable::species().name(id), id}; }
+
+    /** @brief The location key a mapper stores; NULL for no location. */
+    inline QVariant locationKey(const std::string &name)
+    {
+        return name.empty() ? QVariant() : QVariant(NameTable::locations().intern(name));
+    }
+}
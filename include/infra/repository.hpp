@@ -4,10 +4,23 @@
  *
  * This file defines the `QtSqlRepository` template class for performing CRUD operations
  * on database entities and the `RepositoryNotifier` class for signaling repository changes.
+ *
+ * Bulk housekeeping should use the set-based operations (`deleteWhere`,
+ * `updateWhere`, `updateMany`, `removeMany`), which run as one statement or
+ * one transaction and signal one change, instead of looping over `update` and
+ * `remove`. Wrap other multi-step edits in a NotificationBatch.
+ *
+ * Whole-table reads that do not need every entity at once should use
+ * `forEach` or `cursor`, which build one entity per row from a forward-only
+ * query, instead of `list`.
  */
 
 #pragma once
+#include <algorithm>
+#include <iterator>
+#include <memory>
 #include <optional>
+#include <type_traits>
 #include <vector>
 #include <typeindex>
 #include <QSqlQuery>
@@ -17,11 +30,22 @@
 #include <QSqlError>
 #include <QObject>
 #include <functional>
+#include <map>
+#include <mutex>
+#include <QStringList>
+#include <QRegularExpression>
 
 // STD output
 #include <iostream>
 
 #include "infra/connection.hpp"
+#include "infra/entity_cache.hpp"
+#include "infra/logging.hpp"
+#include "infra/sql_trace.hpp"
+#include "infra/unit_of_work.hpp"
+#include "infra/dictionaries.hpp"
+#include "infra/inventory_snapshot.hpp"
+#include "infra/name_table.hpp"
 
 #include "infra/mappers/log_mapper.hpp"
 #include "infra/mappers/cookie_mapper.hpp"
@@ -51,11 +75,54 @@ namespace woodworks::infra
             return inst;
         }
 
+        /**
+         * @brief Emits repositoryChanged, or defers it to the end of the outermost NotificationBatch.
+         */
+        void notifyChanged()
+        {
+            if (held_ > 0)
+            {
+                pending_ = true;
+                return;
+            }
+            emit repositoryChanged();
+        }
+
     signals:
         /**
          * @brief Signal emitted when the repository changes.
          */
         void repositoryChanged();
+
+    private:
+        friend class NotificationBatch;
+
+        int held_{0};         ///< Open NotificationBatch scopes.
+        bool pending_{false}; ///< A change was notified while held.
+    };
+
+    /**
+     * @class NotificationBatch
+     * @brief Folds every change notified while it is alive into one repositoryChanged.
+     *
+     * Declare it before a UnitOfWork, so the signal fires after the commit.
+     */
+    class NotificationBatch
+    {
+    public:
+        NotificationBatch() { ++RepositoryNotifier::instance().held_; }
+        ~NotificationBatch()
+        {
+            auto &notifier = RepositoryNotifier::instance();
+            if (--notifier.held_ == 0 && notifier.pending_)
+            {
+                notifier.pending_ = false;
+                emit notifier.repositoryChanged();
+            }
+        }
+
+        NotificationBatch(const NotificationBatch &) = delete;
+        NotificationBatch &operator=(const NotificationBatch &) = delete;
     };
 
     /**
@@ -70,29 +137,12 @@ namespace woodworks::infra
     public:
         /**
          * @brief Constructs a repository with a given database connection.
+         *
+         * The table and views come from SchemaMigrator, which DbConnection runs
+         * when it opens the database, so constructing a repository is free.
          * @param db The database connection to use.
          */
-        explicit QtSqlRepository(QSqlDatabase &db) : db_(db)
-        {
-            // Create the repo if it does not exist
-            std::cout << "Creating repository for " << typeid(T).name() << std::endl;
-            QSqlQuery q(db_);
-            q.prepare(T::createDbSQL());
-            if (!q.exec())
-            {
-                throw std::runtime_error("Failed to create table: " + q.lastError().text().toStdString());
-            }
-            q.prepare(T::individualViewSQL());
-            if (!q.exec())
-            {
-                throw std::runtime_error("Failed to create view: " + q.lastError().text().toStdString());
-            }
-            q.prepare(T::groupedViewSQL());
-            if (!q.exec())
-            {
-                throw std::runtime_error("Failed to create view: " + q.lastError().text().toStdString());
-            }
-        }
+        explicit QtSqlRepository(QSqlDatabase &db) : db_(db) {}
 
         /**
          * @brief Creates a repository using the default database connection.
@@ -106,37 +156,236 @@ namespace woodworks::infra
 
         /**
          * @brief Retrieves an entity by its ID.
+         *
+         * Served from EntityCache<T> when caching is on; misses are read from
+         * the database and cached.
          * @param id The ID of the entity to retrieve.
          * @return An optional containing the entity if found, or `std::nullopt` otherwise.
          */
         std::optional<T> get(int id)
         {
-            QSqlQuery q(db_);
+            auto &cache = EntityCache<T>::instance();
+            bool cached = cache.enabled();
+            if (cached)
+            {
+                if (auto hit = cache.find(db_, id))
+                {
+                    return hit;
+                }
+            }
+            TracedQuery q(db_);
             q.prepare(T::selectOneSQL());
             q.bindValue(0, QVariant(id));
             if (!q.exec() || !q.next())
             {
                 return std::nullopt;
             }
-            return T::fromRecord(q.record());
+            NameTable::Scope names(db_);
+            T item = T::fromRecord(q.record());
+            StoredColumns<T>::instance().remember(db_, id, T::columnValues(item));
+            if (cached)
+            {
+                cache.put(db_, id, item);
+            }
+            return item;
+        }
+
+        /**
+         * @brief Retrieves several entities by ID, e.g. the rows selected in a table.
+         *
+         * Cached entities are served from EntityCache<T>; the rest are read with
+         * one `IN` query per 500 IDs rather than one lookup each.
+         * @param ids The IDs to retrieve.
+         * @return The entities found, cached ones first.
+         */
+        std::vector<T> getMany(const std::vector<int> &ids)
+        {
+            auto &cache = EntityCache<T>::instance();
+            bool cached = cache.enabled();
+            NameTable::Scope names(db_);
+            std::vector<T> result;
+            std::vector<int> missing;
+            for (int id : ids)
+            {
+                if (auto hit = cached ? cache.find(db_, id) : std::nullopt)
+                {
+                    result.push_back(*hit);
+                }
+                else
+                {
+                    missing.push_back(id);
+                }
+            }
+            const size_t chunk = 500;
+            for (size_t start = 0; start < missing.size(); start += chunk)
+            {
+                size_t count = std::min(chunk, missing.size() - start);
+                QStringList marks;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    marks << "?";
+                }
+                TracedQuery q(db_);
+                if (!q.prepare("SELECT * FROM " + T::tableName() + " WHERE id IN (" + marks.join(", ") + ")"))
+                {
+                    throw std::runtime_error("Failed to prepare select statement: " + q.lastError().text().toStdString());
+                }
+                for (size_t i = 0; i < count; ++i)
+                {
+                    q.bindValue(static_cast<int>(i), missing[start + i]);
+                }
+                if (!q.exec())
+                {
+                    throw std::runtime_error("Failed to read items: " + q.lastError().text().toStdString());
+                }
+                while (q.next())
+                {
+                    T item = T::fromRecord(q.record());
+                    StoredColumns<T>::instance().remember(db_, item.id.id, T::columnValues(item));
+                    if (cached)
+                    {
+                        cache.put(db_, item.id.id, item);
+                    }
+                    result.push_back(std::move(item));
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @class Cursor
+         * @brief A forward-only pass over a table, building one entity per row as it is read.
+         *
+         * Iterate it with range-for or call next(). Nothing is kept once a
+         * row is read, not even its StoredColumns, so memory stays flat
+         * whatever the size of the table. The statement stays open until the
+         * cursor is destroyed or exhausted.
+         */
+        class Cursor
+        {
+        public:
+            /**
+             * @class iterator
+             * @brief Single-pass input iterator; advancing reads the next row.
+             */
+            class iterator
+            {
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = T *;
+                using reference = T &;
+
+                iterator() = default;
+                explicit iterator(Cursor *cursor) : cursor_(cursor) { ++*this; }
+
+                reference operator*() { return *current_; }
+                pointer operator->() { return &*current_; }
+                iterator &operator++()
+                {
+                    current_ = cursor_->next();
+                    if (!current_)
+                    {
+                        cursor_ = nullptr;
+                    }
+                    return *this;
+                }
+                bool operator==(const iterator &other) const { return cursor_ == other.cursor_; }
+                bool operator!=(const iterator &other) const { return cursor_ != other.cursor_; }
+
+            private:
+                Cursor *cursor_{nullptr};
+                std::optional<T> current_;
+            };
+
+            /**
+             * @throws std::runtime_error if the query fails.
+             */
+            Cursor(QSqlDatabase &db, const QString &sql) : db_(&db), query_(std::make_unique<TracedQuery>(db))
+            {
+                // Forward-only, so the driver does not cache rows already read
+                query_->setForwardOnly(true);
+                if (!query_->prepare(sql) || !query_->exec())
+                {
+                    throw std::runtime_error("Failed to read items: " + query_->lastError().text().toStdString());
+                }
+            }
+
+            /** @brief The next entity, or std::nullopt once every row has been read. */
+            std::optional<T> next()
+            {
+                if (!query_ || !query_->next())
+                {
+                    // Reports the statement and releases it before the cursor goes away
+                    query_.reset();
+                    return std::nullopt;
+                }
+                NameTable::Scope names(*db_);
+                return T::fromRecord(query_->record());
+            }
+
+            iterator begin() { return iterator(this); }
+            iterator end() { return iterator(); }
+
+        private:
+            QSqlDatabase *db_;
+            std::unique_ptr<TracedQuery> query_;
+        };
+
+        /**
+         * @brief Opens a forward-only cursor over every entity.
+         * @throws std::runtime_error if the query fails.
+         */
+        Cursor cursor() { return Cursor(db_, T::selectAllSQL()); }
+
+        /**
+         * @brief Streams every entity to a callback, one at a time.
+         *
+         * The entity is passed as an rvalue, so the callback may move it. A
+         * callback that returns bool stops the scan by returning false.
+         * @param fn Called with each entity.
+         * @return The number of entities passed to the callback.
+         * @throws std::runtime_error if the query fails.
+         */
+        template <typename Fn>
+        size_t forEach(Fn fn)
+        {
+            size_t visited = 0;
+            Cursor rows = cursor();
+            while (auto item = rows.next())
+            {
+                ++visited;
+                if constexpr (std::is_same_v<std::invoke_result_t<Fn &, T &&>, bool>)
+                {
+                    if (!fn(std::move(*item)))
+                    {
+                        break;
+                    }
+                }
+                else
+                {
+                    fn(std::move(*item));
+                }
+            }
+            return visited;
         }
 
         /**
          * @brief Retrieves all entities from the database.
-         * @return A vector containing all entities.
+         * @return A vector containing all entities; empty if the query fails.
          */
         std::vector<T> list()
         {
-            QSqlQuery q(db_);
-            q.prepare(T::selectAllSQL());
-            if (!q.exec())
+            std::vector<T> result;
+            try
             {
-                return {};
+                forEach([&result](T &&item)
+                        { result.push_back(std::move(item)); });
             }
-            std::vector<T> result;
-            while (q.next())
+            catch (const std::runtime_error &)
             {
-                result.push_back(T::fromRecord(q.record()));
+                return {};
             }
             return result;
         }
@@ -148,7 +397,8 @@ namespace woodworks::infra
          */
         int add(const T &item)
         {
-            QSqlQuery q(db_);
+            NameTable::Scope names(db_);
+            TracedQuery q(db_);
             if (!q.prepare(T::insertSQL()))
             {
                 throw std::runtime_error("Failed to prepare insert statement" + q.lastError().text().toStdString());
@@ -159,28 +409,97 @@ namespace woodworks::infra
                 throw std::runtime_error(std::string("Failed to insert item: ") + q.lastError().text().toStdString());
             }
             int id = q.lastInsertId().toInt();
-            RepositoryNotifier::instance().repositoryChanged();
+            StoredColumns<T>::instance().remember(db_, id, T::columnValues(item));
+            if (EntityCache<T>::instance().enabled())
+            {
+                T stored = item;
+                stored.id.id = id;
+                EntityCache<T>::instance().put(db_, id, stored);
+            }
+            if (Dictionaries::of(db_).loaded())
+            {
+                Dictionaries::of(db_).added(T::tableName(), T::columnValues(item));
+            }
+            InventorySnapshots::instance().rowsWritten(db_, T::tableName(), {id});
+            RepositoryNotifier::instance().notifyChanged();
             return id;
         }
 
         /**
          * @brief Updates an existing entity in the database.
+         *
+         * Only the columns that differ from the stored row are written, so
+         * renaming an item does not rewrite its image. The stored row comes
+         * from StoredColumns<T> or EntityCache<T> when the entity was fetched
+         * with get() or getMany() or written before, and is read by id
+         * otherwise, e.g. for entities from list() or a cursor. Every column
+         * is written if the row is missing. Nothing is written, and no change
+         * is signalled, if no column differs.
          * @param item The entity to update.
          */
         void update(const T &item)
         {
-            QSqlQuery q(db_);
-            if (!q.prepare(T::updateSQL()))
+            NameTable::Scope names(db_);
+            auto &cache = EntityCache<T>::instance();
+            auto &stored = StoredColumns<T>::instance();
+            QVariantMap after = T::columnValues(item);
+            QStringList columns;
+            std::optional<QVariantMap> before = stored.find(db_, item.id.id);
+            if (!before)
             {
-                throw std::runtime_error("Failed to prepare update statement: " + q.lastError().text().toStdString());
+                if (auto cachedItem = cache.peek(db_, item.id.id))
+                {
+                    before = T::columnValues(*cachedItem);
+                }
             }
-            std::cout << "Updating item with id: " << item.id.id << std::endl;
-            T::bindForUpdate(q, item);
-            if (!q.exec())
+            if (!before)
             {
-                throw std::runtime_error("Failed to update item: " + q.lastError().text().toStdString());
+                before = storedRow(item.id.id);
             }
-            RepositoryNotifier::instance().repositoryChanged();
+            if (before)
+            {
+                for (const QString &column : after.keys())
+                {
+                    if (!sameValue(before->value(column), after.value(column)))
+                    {
+                        columns << column;
+                    }
+                }
+                if (columns.isEmpty())
+                {
+                    return;
+                }
+            }
+            else
+            {
+                columns = after.keys();
+            }
+
+            WOODWORKS_LOG_DEBUG("repository", "update", {{"type", typeid(T).name()}, {"id", item.id.id}, {"columns", columns.join(",")}});
+            {
+                auto statement = updateStatement(columns);
+                TracedQuery &q = *statement.query;
+                bool ok = execUpdate(q, columns, after, item.id.id);
+                // A statement prepared before its connection was closed and reopened has to be prepared again
+                if (!ok && q.prepare(updateSQL(columns)))
+                {
+                    ok = execUpdate(q, columns, after, item.id.id);
+                }
+                q.report();
+                if (!ok)
+                {
+                    throw std::runtime_error("Failed to update item: " + q.lastError().text().toStdString());
+                }
+            }
+            stored.remember(db_, item.id.id, after);
+            cache.put(db_, item.id.id, item);
+            if (before)
+            {
+                Dictionaries::of(db_).removed(T::tableName(), *before);
+                Dictionaries::of(db_).added(T::tableName(), after);
+            }
+            InventorySnapshots::instance().rowsWritten(db_, T::tableName(), {item.id.id});
+            RepositoryNotifier::instance().notifyChanged();
         }
 
         /**
@@ -189,14 +508,138 @@ namespace woodworks::infra
          */
         void remove(int id)
         {
-            QSqlQuery q(db_);
+            NameTable::Scope names(db_);
+            auto before = dictionaryRow(id);
+            TracedQuery q(db_);
             q.prepare(T::deleteSQL());
             q.bindValue(0, id);
             if (!q.exec())
             {
                 throw std::runtime_error(std::string("Failed to delete item: ") + q.lastError().text().toStdString());
             }
-            RepositoryNotifier::instance().repositoryChanged();
+            EntityCache<T>::instance().erase(db_, id);
+            StoredColumns<T>::instance().forget(db_, id);
+            if (before)
+            {
+                Dictionaries::of(db_).removed(T::tableName(), *before);
+            }
+            InventorySnapshots::instance().rowsRemoved(db_, T::tableName(), {id});
+            RepositoryNotifier::instance().notifyChanged();
+        }
+
+        /**
+         * @brief Updates many entities in one transaction, with one change notification.
+         *
+         * Each entity is diffed as by update(), so unchanged ones cost nothing.
+         * @param items The entities to update.
+         */
+        void updateMany(const std::vector<T> &items)
+        {
+            NotificationBatch batch;
+            UnitOfWork uow(db_);
+            for (const auto &item : items)
+            {
+                update(item);
+            }
+            uow.commit();
+        }
+
+        /**
+         * @brief Removes many entities in one transaction, with one change notification.
+         * @param ids The IDs of the entities to remove.
+         */
+        void removeMany(const std::vector<int> &ids)
+        {
+            if (ids.empty())
+            {
+                return;
+            }
+            NameTable::Scope names(db_);
+            UnitOfWork uow(db_);
+            TracedQuery q(db_);
+            if (!q.prepare(T::deleteSQL()))
+            {
+                throw std::runtime_error("Failed to prepare delete statement: " + q.lastError().text().toStdString());
+            }
+            auto &cache = EntityCache<T>::instance();
+            for (int id : ids)
+            {
+                auto before = dictionaryRow(id);
+                q.bindValue(0, id);
+                if (!q.exec())
+                {
+                    throw std::runtime_error(std::string("Failed to delete item: ") + q.lastError().text().toStdString());
+                }
+                cache.erase(db_, id);
+                StoredColumns<T>::instance().forget(db_, id);
+                if (before)
+                {
+                    Dictionaries::of(db_).removed(T::tableName(), *before);
+                }
+            }
+            uow.commit();
+            InventorySnapshots::instance().rowsRemoved(db_, T::tableName(), ids);
+            RepositoryNotifier::instance().notifyChanged();
+        }
+
+        /**
+         * @brief Deletes every row whose columns equal the given values, in one statement.
+         *
+         * `species` and `location` may be given by name for tables that store them as keys.
+         * @param criteria Column name to required value; must not be empty.
+         * @return The number of rows deleted.
+         * @throws std::runtime_error for an unknown column or a failed statement.
+         */
+        int deleteWhere(const QVariantMap &criteria)
+        {
+            QVariantMap bound;
+            TracedQuery q(db_);
+            if (!q.prepare("DELETE FROM " + T::tableName() + " WHERE " + whereClause(criteria, bound)))
+            {
+                throw std::runtime_error("Failed to prepare delete statement: " + q.lastError().text().toStdString());
+            }
+            bindAll(q, bound);
+            if (!q.exec())
+            {
+                throw std::runtime_error(std::string("Failed to delete items: ") + q.lastError().text().toStdString());
+            }
+            return finishBulk(q.numRowsAffected());
+        }
+
+        /**
+         * @brief Sets columns on every row whose columns equal the given values, in one statement.
+         *
+         * `species` and `location` may be given by name, as for deleteWhere().
+         * @param criteria Column name to required value; must not be empty.
+         * @param assignments Column name to new value.
+         * @return The number of rows updated.
+         * @throws std::runtime_error for an unknown column or a failed statement.
+         */
+        int updateWhere(const QVariantMap &criteria, const QVariantMap &assignments)
+        {
+            if (assignments.isEmpty())
+            {
+                return 0;
+            }
+            QVariantMap bound;
+            QStringList sets;
+            for (const QString &column : assignments.keys())
+            {
+                auto [stored, value] = storedColumn(column, assignments.value(column), true);
+                sets << stored + " = :set_" + stored;
+                bound.insert(":set_" + stored, value);
+            }
+            TracedQuery q(db_);
+            if (!q.prepare("UPDATE " + T::tableName() + " SET " + sets.join(", ") + " WHERE " + whereClause(criteria, bound)))
+            {
+                throw std::runtime_error("Failed to prepare update statement: " + q.lastError().text().toStdString());
+            }
+            bindAll(q, bound);
+            if (!q.exec())
+            {
+                throw std::runtime_error("Failed to update items: " + q.lastError().text().toStdString());
+            }
+            return finishBulk(q.numRowsAffected());
         }
 
         /**
@@ -208,12 +651,18 @@ namespace woodworks::infra
         template <typename Predicate>
         std::vector<T> filter(Predicate pred)
         {
-            auto all = list();
+            // Streamed, so rows that do not match are never held
             std::vector<T> result;
-            for (const auto &item : all)
+            try
             {
-                if (pred(item))
-                    result.push_back(item);
+                forEach([&](T &&item)
+                        {
+                    if (pred(static_cast<const T &>(item)))
+                        result.push_back(std::move(item)); });
+            }
+            catch (const std::runtime_error &)
+            {
+                return {};
             }
             return result;
         }
@@ -231,6 +680,224 @@ namespace woodworks::infra
         }
 
     private:
+        /** @brief A cached UPDATE statement, locked for the caller until destroyed. */
+        struct UpdateStatement
+        {
+            std::unique_lock<std::mutex> lock;
+            TracedQuery *query;
+        };
+
+        /**
+         * @brief The UPDATE for a column set, prepared once per connection and reused.
+         * @throws std::runtime_error if the statement cannot be prepared.
+         */
+        UpdateStatement updateStatement(const QStringList &columns)
+        {
+            static std::mutex mutex;
+            // Statements live as long as the process, like makeFilteredModel's
+            static auto *statements = new std::map<QString, std::unique_ptr<TracedQuery>>();
+            std::unique_lock<std::mutex> lock(mutex);
+            auto &statement = (*statements)[db_.connectionName() + '\n' + db_.databaseName() + '\n' + columns.join(",")];
+            if (!statement)
+            {
+                auto prepared = std::make_unique<TracedQuery>(db_);
+                if (!prepared->prepare(updateSQL(columns)))
+                {
+                    throw std::runtime_error("Failed to prepare update statement: " + prepared->lastError().text().toStdString());
+                }
+                statement = std::move(prepared);
+            }
+            return UpdateStatement{std::move(lock), statement.get()};
+        }
+
+        static bool execUpdate(TracedQuery &q, const QStringList &columns, const QVariantMap &values, int id)
+        {
+            for (const QString &column : columns)
+            {
+                q.bindValue(":" + column, values.value(column));
+            }
+            q.bindValue(":id", id);
+            return q.exec();
+        }
+
+        /**
+         * @brief Builds, once per column set, an UPDATE that writes just those columns.
+         * @param columns Column names, in T::columnValues key order.
+         */
+        static QString updateSQL(const QStringList &columns)
+        {
+            static std::mutex mutex;
+            static std::map<QString, QString> statements;
+            QString key = columns.join(",");
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = statements.find(key);
+            if (it == statements.end())
+            {
+                QStringList assignments;
+                for (const QString &column : columns)
+                {
+                    assignments << column + " = :" + column;
+                }
+                it = statements.emplace(key, "UPDATE " + T::tableName() + " SET " + assignments.join(", ") + " WHERE id = :id").first;
+            }
+            return it->second;
+        }
+
+        /** @brief The columns T's insert statement writes, plus id; read once from the SQL text. */
+        static const QStringList &knownColumns()
+        {
+            static const QStringList known = []()
+            {
+                static const QRegularExpression list(R"(INSERT\s+INTO\s+\w+\s*\(([^)]*)\))");
+                QStringList columns{"id"};
+                for (const QString &column : list.match(T::insertSQL()).captured(1).split(','))
+                {
+                    columns << column.trimmed();
+                }
+                return columns;
+            }();
+            return known;
+        }
+
+        /** @brief Returns the column if T has it; criteria and assignments are spliced into SQL, so nothing else passes. */
+        static QString checkedColumn(const QString &column)
+        {
+            if (!knownColumns().contains(column))
+            {
+                throw std::runtime_error("Unknown column for " + T::tableName().toStdString() + ": " + column.toStdString());
+            }
+            return column;
+        }
+
+        /**
+         * @brief The stored column and value for a bulk criterion or assignment.
+         *
+         * Species and locations are stored as keys, but callers name them as
+         * on the entity. A name that was never stored matches nothing; an
+         * assigned one is interned. An empty location is NULL.
+         */
+        std::pair<QString, QVariant> storedColumn(const QString &column, const QVariant &value, bool assigning)
+        {
+            if ((column == "species" || column == "location") && !knownColumns().contains(column) && knownColumns().contains(column + "_id"))
+            {
+                NameTable &names = column == "species" ? NameTable::species(db_) : NameTable::locations(db_);
+                const std::string name = value.toString().toStdString();
+                if (column == "location" && name.empty())
+                {
+                    return {column + "_id", QVariant()};
+                }
+                if (assigning)
+                {
+                    return {column + "_id", names.intern(name)};
+                }
+                auto id = names.find(name);
+                return {column + "_id", id ? QVariant(*id) : QVariant(-1)};
+            }
+            return {checkedColumn(column), value};
+        }
+
+        /** @brief Builds the WHERE terms and adds their placeholders to `bound`. */
+        QString whereClause(const QVariantMap &criteria, QVariantMap &bound)
+        {
+            if (criteria.isEmpty())
+            {
+                throw std::runtime_error("Refusing a bulk statement without criteria on " + T::tableName().toStdString());
+            }
+            QStringList terms;
+            for (const QString &column : criteria.keys())
+            {
+                auto [stored, value] = storedColumn(column, criteria.value(column), false);
+                if (value.isNull())
+                {
+                    terms << stored + " IS NULL";
+                    continue;
+                }
+                terms << stored + " = :where_" + stored;
+                bound.insert(":where_" + stored, value);
+            }
+            return terms.join(" AND ");
+        }
+
+        static void bindAll(QSqlQuery &q, const QVariantMap &bound)
+        {
+            for (const QString &placeholder : bound.keys())
+            {
+                q.bindValue(placeholder, bound.value(placeholder));
+            }
+        }
+
+        // The rows touched are unknown, so the caches, dictionaries and snapshots are dropped rather than patched
+        int finishBulk(int rows)
+        {
+            if (rows > 0)
+            {
+                EntityCache<T>::instance().clear();
+                StoredColumns<T>::instance().clear();
+                Dictionaries::of(db_).invalidate();
+                InventorySnapshots::instance().invalidate();
+                RepositoryNotifier::instance().notifyChanged();
+            }
+            return rows;
+        }
+
+        /**
+         * @brief Reads the columns a row holds now, for update() to diff against.
+         * @return std::nullopt if there is no such row.
+         */
+        std::optional<QVariantMap> storedRow(int id)
+        {
+            TracedQuery q(db_);
+            q.prepare(T::selectOneSQL());
+            q.bindValue(0, QVariant(id));
+            if (!q.exec() || !q.next())
+            {
+                return std::nullopt;
+            }
+            return T::columnValues(T::fromRecord(q.record()));
+        }
+
+        /**
+         * @brief The row's values before a write, for Dictionaries to uncount.
+         * @return std::nullopt if the dictionaries are not loaded or have no columns in T's table.
+         */
+        std::optional<QVariantMap> dictionaryRow(int id)
+        {
+            if (!Dictionaries::of(db_).loaded())
+            {
+                return std::nullopt;
+            }
+            if (auto stored = StoredColumns<T>::instance().find(db_, id))
+            {
+                return stored;
+            }
+            if (auto cached = EntityCache<T>::instance().peek(db_, id))
+            {
+                return T::columnValues(*cached);
+            }
+            return Dictionaries::of(db_).read(db_, T::tableName(), id);
+        }
+
+        /**
+         * @brief Compares a stored column value with a new one.
+         *
+         * Skips the byte compare when two images share one buffer; a stored
+         * image that is only a fingerprint is compared with the new image's.
+         */
+        static bool sameValue(const QVariant &stored, const QVariant &value)
+        {
+            if (stored.type() == QVariant::ByteArray && value.type() == QVariant::ByteArray)
+            {
+                QByteArray left = stored.toByteArray();
+                QByteArray right = value.toByteArray();
+                return left.isSharedWith(right) || left == right;
+            }
+            if (value.type() == QVariant::ByteArray)
+            {
+                return stored == StoredColumns<T>::fingerprint(value);
+            }
+            return stored == value;
+        }
+
         QSqlDatabase &db_; ///< The database connection used by the repository.
     };
 
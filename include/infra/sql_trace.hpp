@@ -0,0 +1,261 @@
+/**
+ * @file sql_trace.hpp
+ * @brief Provides SQL statement tracing with per-statement latency histograms and a slow-query log.
+ *
+ * Queries run through TracedQuery (or setTracedQuery for models) report to the
+ * SqlTracer. Statements are grouped by their normalized text, with literals
+ * replaced by `?`, so the filtered inventory queries for different species
+ * land in the same bucket. Statements slower than the threshold are logged
+ * and get their `EXPLAIN QUERY PLAN` captured.
+ *
+ * Queries run inside an ActionScope are also counted against that UI action,
+ * so a button that quietly issues a hundred lookups shows up as one N+1 entry.
+ *
+ * Tracing is off by default and costs one relaxed atomic load per statement
+ * while off. Set WOODWORKS_SQL_TRACE=1 to start with it on,
+ * WOODWORKS_SQL_SLOW_MS to change the slow-query threshold (default 50 ms) and
+ * WOODWORKS_SQL_N_PLUS_ONE to change how many runs of one statement in one
+ * action count as N+1 (default 10).
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlQueryModel>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/**
+ * @namespace woodworks::infra
+ * @brief Contains infrastructure-related classes and utilities.
+ */
+namespace woodworks::infra
+{
+    /**
+     * @brief Replaces literals with `?` and collapses whitespace, so one statement shape gives one key.
+     * @param sql The statement text.
+     * @return The normalized text.
+     */
+    QString normalizeSql(const QString &sql);
+
+    /**
+     * @struct StatementStats
+     * @brief Everything recorded for one normalized statement.
+     */
+    struct StatementStats
+    {
+        /// Bucket 0 holds executions under 1 us; bucket i holds [2^(i-1), 2^i) us, the last one everything slower.
+        static constexpr size_t HISTOGRAM_BUCKETS = 24;
+
+        QString statement;      ///< Normalized text.
+        size_t count{0};        ///< Executions.
+        size_t errors{0};       ///< Executions that failed.
+        size_t rows{0};         ///< Rows read by SELECTs, or changed by other statements.
+        int64_t prepareNanos{0};
+        int64_t execNanos{0};
+        int64_t maxExecNanos{0};
+        std::array<size_t, HISTOGRAM_BUCKETS> histogram{};
+        QString slowestText; ///< Raw text of the slowest execution.
+        QString plan;        ///< EXPLAIN QUERY PLAN of the slowest execution over the threshold, one step per line.
+
+        double meanMicros() const { return count == 0 ? 0.0 : static_cast<double>(execNanos) / 1000.0 / static_cast<double>(count); }
+
+        /**
+         * @brief Estimates a latency percentile from the histogram.
+         * @param fraction Between 0 and 1, e.g. 0.95.
+         * @return The upper edge of the bucket holding that percentile, in microseconds.
+         */
+        double percentileMicros(double fraction) const;
+    };
+
+    /**
+     * @struct ActionStats
+     * @brief Queries issued by one kind of UI action, over all its invocations.
+     */
+    struct ActionStats
+    {
+        QString action;         ///< e.g. "button: deleteProjectButton".
+        size_t invocations{0};  ///< Times the action ran with tracing on.
+        size_t queries{0};      ///< Statements run, over all invocations.
+        int64_t dbNanos{0};     ///< Time spent in those statements.
+        size_t maxQueries{0};   ///< Most statements run by one invocation.
+        size_t nPlusOne{0};     ///< Invocations that ran one statement at least the N+1 threshold times.
+        /// Statements the busiest invocation ran more than once, with their counts, most repeated first.
+        std::vector<std::pair<QString, size_t>> repeated;
+    };
+
+    /**
+     * @class SqlTracer
+     * @brief Process-wide collector of statement timings.
+     */
+    class SqlTracer
+    {
+    public:
+        /**
+         * @brief Retrieves the singleton tracer.
+         */
+        static SqlTracer &instance();
+
+        SqlTracer(const SqlTracer &) = delete;
+        SqlTracer &operator=(const SqlTracer &) = delete;
+
+        void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+        bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+        /** @brief Executions slower than this are logged and explained. */
+        void setSlowThreshold(std::chrono::microseconds threshold) { slowThreshold_.store(threshold.count(), std::memory_order_relaxed); }
+        std::chrono::microseconds slowThreshold() const { return std::chrono::microseconds(slowThreshold_.load(std::memory_order_relaxed)); }
+
+        /**
+         * @brief Records one execution.
+         * @param sql The statement as run.
+         * @param prepareNanos Time spent preparing it, 0 if it was not prepared separately.
+         * @param execNanos Time spent executing it.
+         * @param rows Rows read or changed.
+         * @param ok Whether it succeeded.
+         * @param explain Returns the query plan; only called for slow executions.
+         */
+        void record(const QString &sql, int64_t prepareNanos, int64_t execNanos, size_t rows, bool ok,
+                    const std::function<QString()> &explain);
+
+        /** @brief An invocation running one statement this many times is flagged as N+1. */
+        void setNPlusOneThreshold(size_t threshold) { nPlusOneThreshold_.store(threshold, std::memory_order_relaxed); }
+        size_t nPlusOneThreshold() const { return nPlusOneThreshold_.load(std::memory_order_relaxed); }
+
+        /** @brief Copies the statistics, slowest total time first. */
+        std::vector<StatementStats> snapshot() const;
+
+        /** @brief Copies the per-action statistics, most database time first. */
+        std::vector<ActionStats> actionSnapshot() const;
+
+        /** @brief Forgets everything recorded so far. */
+        void reset();
+
+        /** @brief The statistics as a JSON document. */
+        QByteArray toJson() const;
+
+        /**
+         * @brief Writes toJson() to a file.
+         * @return False if the file could not be written.
+         */
+        bool writeJson(const QString &path) const;
+
+        /**
+         * @brief Runs EXPLAIN QUERY PLAN for a statement.
+         * @param db The connection to run it on.
+         * @param sql The statement; only SELECT, INSERT, UPDATE, DELETE and WITH statements are explained.
+         * @param bound Values for the statement's placeholders, in order.
+         * @return One plan step per line, indented by depth; empty if it cannot be explained.
+         */
+        static QString explain(const QSqlDatabase &db, const QString &sql, const QVector<QVariant> &bound = {});
+
+    private:
+        friend class ActionScope;
+        struct Invocation;
+
+        SqlTracer();
+        void finishAction(const Invocation &invocation);
+
+        static thread_local Invocation current_; ///< The action running on this thread.
+
+        std::atomic<bool> enabled_{false};
+        std::atomic<int64_t> slowThreshold_{50000};
+        std::atomic<size_t> nPlusOneThreshold_{10};
+        mutable std::mutex mutex_;
+        std::map<QString, StatementStats> stats_;
+        std::map<QString, ActionStats> actions_;
+    };
+
+    /**
+     * @class ActionScope
+     * @brief Attributes the queries run on this thread, until it is destroyed, to a UI action.
+     *
+     * Scopes nest; queries belong to the outermost one, which is the action the
+     * user actually took. Does nothing while tracing is off.
+     *
+     * Usage:
+     *   ActionScope scope("menu: Delete Project");
+     */
+    class ActionScope
+    {
+    public:
+        explicit ActionScope(const QString &action);
+        ~ActionScope();
+
+        ActionScope(const ActionScope &) = delete;
+        ActionScope &operator=(const ActionScope &) = delete;
+
+        /** @brief The outermost action on this thread, or an empty string. */
+        static QString current();
+    };
+
+    /**
+     * @class TracedQuery
+     * @brief A QSqlQuery that reports its prepare and exec times and row count to the SqlTracer.
+     *
+     * Drop-in for QSqlQuery wherever it is used by value. An execution is
+     * reported when the query is prepared or executed again, or destroyed, so
+     * the rows a SELECT returns are the rows actually read with next().
+     */
+    class TracedQuery : public QSqlQuery
+    {
+    public:
+        explicit TracedQuery(const QSqlDatabase &db) : QSqlQuery(db), db_(db) {}
+        ~TracedQuery() { report(); }
+
+        TracedQuery(const TracedQuery &) = delete;
+        TracedQuery &operator=(const TracedQuery &) = delete;
+
+        bool prepare(const QString &sql);
+        bool exec();
+        bool exec(const QString &sql);
+        bool next()
+        {
+            bool more = QSqlQuery::next();
+            rows_ += more ? 1 : 0;
+            return more;
+        }
+
+        /** @brief Reports the latest execution now, for a statement kept prepared between uses. */
+        void report();
+
+    private:
+
+        QSqlDatabase db_;
+        QString sql_;
+        int64_t prepareNanos_{0};
+        int64_t execNanos_{0};
+        size_t rows_{0};
+        bool ok_{false};
+        bool pending_{false};
+    };
+
+    /**
+     * @brief Sets a model's query, reporting the time to run it and load its first rows.
+     * @param model The model to load.
+     * @param sql The statement.
+     * @param db The connection to run it on.
+     */
+    void setTracedQuery(QSqlQueryModel *model, const QString &sql, const QSqlDatabase &db = QSqlDatabase::database());
+
+    /**
+     * @brief Binds and runs a prepared query, hands it to a model and reports it.
+     * @param model The model to load.
+     * @param prepared A query already prepared with positional placeholders.
+     * @param bound Values for the placeholders, in order.
+     * @param db The connection it was prepared on, used to explain slow runs.
+     */
+    void setTracedQuery(QSqlQueryModel *model, QSqlQuery &prepared, const QVector<QVariant> &bound, const QSqlDatabase &db = QSqlDatabase::database());
+}
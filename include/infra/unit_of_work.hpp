@@ -10,10 +10,15 @@
  *       …
  *       uow.commit();   // or omit => automatic rollback
  *   }
+ *
+ * A UnitOfWork opened while another is active on the same connection runs as
+ * a savepoint inside it, so helpers that batch their own writes can be called
+ * from inside a caller's transaction. Rolling it back undoes only its writes.
  */
 
 #pragma once
 #include <QSqlDatabase>
+#include <QString>
 
 /**
  * @namespace woodworks::infra
@@ -61,5 +66,11 @@ namespace woodworks::infra
          * @brief Indicates whether the transaction has been committed.
          */
         bool committed_{false};
+
+        /**
+         * @var UnitOfWork::savepoint_
+         * @brief Name of the savepoint when nested in another UnitOfWork, empty otherwise.
+         */
+        QString savepoint_;
     };
 }
\ No newline at end of file
@@ -11,6 +11,11 @@ namespace Ui
 }
 QT_END_NAMESPACE
 
+namespace woodworks::widgets
+{
+  class RefreshScheduler;
+}
+
 class InventoryPage : public QWidget
 {
   Q_OBJECT
@@ -43,12 +48,16 @@ private slots:
   void firewoodCustomContextMenu(const QPoint &pos);
 
 private:
-  void refreshModels(); // Refreshes all models from the DB.
+  void refreshModels(); // Schedules a refresh of all models and filter widgets from the DB.
+
+  // Re-queries one tab; called by the scheduler
+  void refreshTab(int tab);
 
   // Builds the UI widgets (comboboxes, etc.)
   void buildFilterWidgets();
 
   Ui::InventoryPage *ui;
+  woodworks::widgets::RefreshScheduler *refresh;
 
   // Models for each inventory view type
   QSqlQueryModel *individualLogsModel;
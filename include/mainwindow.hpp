@@ -22,10 +22,15 @@ public:
   explicit MainWindow(QWidget *parent = nullptr);
   ~MainWindow();
 
+protected:
+  bool eventFilter(QObject *watched, QEvent *event) override;
+
 private slots:
   void showInventoryPage();
   void showCutlistPage();
   void showSalesPage();
+  void showYardPlanning();
+  void showSqlDiagnostics();
 
 private:
   Ui::MainWindow *ui;
@@ -2,7 +2,10 @@
 #include <QMainWindow>
 #include "domain/live_edge_slab.hpp"
 #include "domain/lumber_cutter.hpp"
+#include "domain/rip_planner.hpp"
 #include <QDoubleSpinBox>
+#include <QCheckBox>
+#include <QLineEdit>
 #include <QSpinBox>
 #include <QPushButton>
 #include <QLabel>
@@ -21,6 +24,7 @@ namespace woodworks::widgets
         void onTrimWidthChanged(double value);
         void onBoardCountChanged(int count);
         void onBoardWidthChanged(double value);
+        void onRipOptionsChanged();
         void onFinishCuts();
 
     private:
@@ -31,8 +35,14 @@ namespace woodworks::widgets
         QLabel *cutsCountLabel;
         QLabel *boardWidthLabel;
         QPushButton *finishButton;
+        QCheckBox *mixedWidthsCheck;
+        QDoubleSpinBox *kerfSpin;
+        QLineEdit *ripWidthsEdit;
+        QLabel *ripPlanLabel;
+        woodworks::domain::lumber::RipPlan ripPlan;
         void setupUi();
         void updateUi();
+        void planRip();
     };
 
 }
\ No newline at end of file
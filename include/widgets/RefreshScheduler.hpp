@@ -0,0 +1,77 @@
+#pragma once
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+
+#include <functional>
+
+class QTabWidget;
+
+namespace woodworks::widgets
+{
+
+    /**
+     * @class RefreshScheduler
+     * @brief Debounces refresh requests for a tabbed page and runs them only for the visible tab.
+     *
+     * Filter widgets call request() on every keystroke; the refresh runs once
+     * input has been quiet for the debounce interval. Tabs that are not
+     * showing stay stale until they are switched to. The refresh runs under
+     * the ActionScope that was current when it was last requested, so its
+     * queries are traced to the action the user took.
+     */
+    class RefreshScheduler : public QObject
+    {
+    public:
+        /**
+         * @struct Stats
+         * @brief What the scheduler has saved so far.
+         */
+        struct Stats
+        {
+            int requested{0}; ///< Tab refreshes asked for.
+            int refreshed{0}; ///< Tab refreshes actually run.
+
+            /** @brief Requests that were coalesced into another refresh or never needed. */
+            int avoided() const { return requested - refreshed; }
+        };
+
+        /**
+         * @param tabs The tab widget whose pages are refreshed.
+         * @param refreshTab Re-queries one tab; receives the tab index.
+         * @param rebuildFilters Repopulates the filter widgets after the data changed.
+         * @param debounceMs How long input must be quiet before refreshing.
+         */
+        RefreshScheduler(QTabWidget *tabs, std::function<void(int)> refreshTab,
+                         std::function<void()> rebuildFilters, int debounceMs = 250);
+
+        /** @brief The filters of one tab changed. */
+        void request(int tab);
+
+        /** @brief Every tab shows stale results, e.g. after switching between grouped and detailed views. */
+        void requestAll();
+
+        /** @brief The underlying data changed; every tab and the filter widgets are stale. */
+        void dataChanged();
+
+        /** @brief Runs pending work for the visible tab now instead of waiting out the debounce. */
+        void flushNow();
+
+        Stats stats() const { return stats_; }
+
+    private:
+        void flush();
+        void recordAction();
+
+        QTabWidget *tabs_;
+        std::function<void(int)> refreshTab_;
+        std::function<void()> rebuildFilters_;
+        QTimer debounce_;
+        QSet<int> stale_;
+        bool filtersStale_{false};
+        QString action_; ///< The action that asked for the pending refresh.
+        Stats stats_;
+    };
+
+}
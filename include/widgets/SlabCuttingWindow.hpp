@@ -1,5 +1,6 @@
 #include "domain/log.hpp"
 #include "domain/slab_cutter.hpp"
+#include "domain/slab_planner.hpp"
 #include "domain/live_edge_slab.hpp"
 
 using namespace woodworks::domain;
@@ -27,6 +28,9 @@ namespace woodworks::widgets
     private slots:
         void onSquareOffButtonClicked();
         void onAddCutButtonClicked();
+        void onSuggestCutsButtonClicked();
+        void onUndoCutButtonClicked();
+        void onRedoCutButtonClicked();
         void onSlabThicknessChanged();
         void onFinishCutButtonClicked();
 
@@ -0,0 +1,57 @@
+#pragma once
+#include <QMainWindow>
+#include <QTableWidget>
+#include <QPlainTextEdit>
+#include <QCheckBox>
+#include <QDoubleSpinBox>
+#include <QSpinBox>
+#include <QLabel>
+#include <QTimer>
+
+#include "infra/sql_trace.hpp"
+
+#include <vector>
+
+namespace woodworks::widgets
+{
+
+    /**
+     * @class SqlDiagnosticsWindow
+     * @brief Shows the SqlTracer's per-statement timings, histograms and slow-query plans,
+     * and the queries each UI action issued.
+     *
+     * Refreshes once a second while open. Tracing can be switched on and the
+     * slow-query and N+1 thresholds changed from here, and the statistics
+     * exported as JSON.
+     */
+    class SqlDiagnosticsWindow : public QMainWindow
+    {
+        Q_OBJECT
+    public:
+        explicit SqlDiagnosticsWindow(QWidget *parent = nullptr);
+
+    private slots:
+        void onRefresh();
+        void onReset();
+        void onExport();
+        void onSelectionChanged();
+        void onActionSelectionChanged();
+
+    private:
+        QCheckBox *enabledCheck;
+        QDoubleSpinBox *thresholdSpin;
+        QSpinBox *nPlusOneSpin;
+        QLabel *summaryLabel;
+        QTableWidget *statementTable;
+        QPlainTextEdit *detailText;
+        QTableWidget *actionTable;
+        QPlainTextEdit *actionDetailText;
+        QTimer *refreshTimer;
+
+        std::vector<woodworks::infra::StatementStats> statements;
+        std::vector<woodworks::infra::ActionStats> actions;
+
+        void setupUi();
+    };
+
+}
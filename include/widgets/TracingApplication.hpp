@@ -0,0 +1,32 @@
+#pragma once
+#include <QApplication>
+#include <QString>
+
+namespace woodworks::widgets
+{
+
+    /**
+     * @class TracingApplication
+     * @brief A QApplication that tags the queries each click, key press or shortcut causes.
+     *
+     * While SQL tracing is on, every user input event is delivered inside an
+     * infra::ActionScope named after what the user acted on: the menu entry
+     * or context menu entry, the button, or the nearest named widget. Queries
+     * run by slots, notifier refreshes and dialogs opened from that event are
+     * all counted against it in the SQL Diagnostics window.
+     */
+    class TracingApplication : public QApplication
+    {
+    public:
+        TracingApplication(int &argc, char **argv) : QApplication(argc, argv) {}
+
+        bool notify(QObject *receiver, QEvent *event) override;
+
+        /**
+         * @brief Names the action an input event stands for.
+         * @return The action name, or an empty string if the event is not user input.
+         */
+        static QString actionName(QObject *receiver, QEvent *event);
+    };
+
+}
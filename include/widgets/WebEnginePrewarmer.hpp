@@ -0,0 +1,40 @@
+#pragma once
+#include <QPointer>
+#include <QWidget>
+
+class QWebEngineView;
+
+namespace woodworks::widgets
+{
+
+    /**
+     * @class WebEnginePrewarmer
+     * @brief Starts Qt WebEngine in the background so the first HTML preview opens quickly.
+     *
+     * The first QWebEngineView in a process spins up Chromium, which takes
+     * seconds. schedule() does that on an idle timer once the main window is
+     * up, by creating a hidden view on about:blank. take() hands that view to
+     * whoever needs one and starts warming the next.
+     */
+    class WebEnginePrewarmer
+    {
+    public:
+        /**
+         * @brief Warms a view after the given delay, unless one is already warm.
+         * @param delayMs How long to wait; the warm-up itself blocks the GUI thread briefly.
+         */
+        static void schedule(int delayMs);
+
+        /**
+         * @brief Returns a ready view, creating one now if none was warmed.
+         * @param parent The widget the view is reparented into.
+         */
+        static QWebEngineView *take(QWidget *parent);
+
+    private:
+        static void warm();
+
+        static QPointer<QWebEngineView> warm_;
+    };
+
+}
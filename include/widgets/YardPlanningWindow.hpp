@@ -0,0 +1,55 @@
+#pragma once
+#include <QMainWindow>
+#include <QTableWidget>
+#include <QPushButton>
+#include <QLabel>
+
+#include "domain/log.hpp"
+#include "domain/yard_planner.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace woodworks::widgets
+{
+
+    /**
+     * @class YardPlanningWindow
+     * @brief Lets the sawyer enter a demand list and plan every log in the yard against it.
+     *
+     * The planner runs on a worker thread; partial plans are posted back to the
+     * window as they arrive.
+     */
+    class YardPlanningWindow : public QMainWindow
+    {
+        Q_OBJECT
+    public:
+        explicit YardPlanningWindow(QWidget *parent = nullptr);
+        ~YardPlanningWindow();
+
+    private slots:
+        void onAddDemand();
+        void onRemoveDemand();
+        void onPlan();
+        void onCancel();
+
+    private:
+        QTableWidget *demandTable;
+        QTableWidget *resultTable;
+        QLabel *statusLabel;
+        QPushButton *planButton;
+        QPushButton *cancelButton;
+
+        std::vector<woodworks::domain::Log> logs;
+        std::vector<woodworks::domain::yard::Demand> demands;
+        std::thread planThread;
+        std::atomic<bool> cancelled{false};
+        unsigned int planRun = 0; // drops partial plans posted by an earlier run
+
+        void setupUi();
+        void stopPlanning();
+        void showPlan(const woodworks::domain::yard::YardPlan &plan);
+    };
+
+}
@@ -5,27 +5,47 @@
 #include <QDialog>
 #include <QVBoxLayout>
 #include <QComboBox>
+#include <QInputDialog>
 #include <QPushButton>
 #include <QMessageBox>
 
+#include <algorithm>
+#include <optional>
+#include <vector>
+
 namespace woodworks::domain
 {
-    template <typename T>
-    inline void dryingPopUp(T &toDry)
+    // States any of the items may move to, in enum order
+    template <typename T, typename State>
+    inline std::vector<State> transitionsForAny(const std::vector<T> &items, State T::*state)
     {
-        using woodworks::infra::QtSqlRepository;
-        using namespace woodworks::domain::types;
-
-        std::vector<Drying> allowed = allowedTransitions(toDry.drying);
+        std::vector<State> options;
+        for (const auto &item : items)
+        {
+            for (State next : allowedTransitions(item.*state))
+            {
+                if (std::find(options.begin(), options.end(), next) == options.end())
+                {
+                    options.push_back(next);
+                }
+            }
+        }
+        std::sort(options.begin(), options.end());
+        return options;
+    }
 
+    // Asks for one of the given states; std::nullopt if cancelled
+    template <typename State>
+    inline std::optional<State> chooseState(const QString &title, const std::vector<State> &options)
+    {
         QDialog dialog;
-        dialog.setWindowTitle("Dry Item");
+        dialog.setWindowTitle(title);
         dialog.setModal(true);
         dialog.setMinimumSize(300, 200);
         dialog.setLayout(new QVBoxLayout());
 
         QComboBox *comboBox = new QComboBox();
-        for (const auto &state : allowed)
+        for (const auto &state : options)
         {
             comboBox->addItem(QString::fromStdString(toString(state)));
         }
@@ -36,30 +56,128 @@ namespace woodworks::domain
         QPushButton *cancelButton = new QPushButton("Cancel");
         dialog.layout()->addWidget(cancelButton);
 
-        QObject::connect(confirmButton, &QPushButton::clicked, [&dialog, &toDry, &allowed, comboBox]()
-                         {
-        toDry.drying = allowed.at(comboBox->currentIndex());
-        dialog.accept(); });
+        QObject::connect(confirmButton, &QPushButton::clicked, [&dialog]()
+                         { dialog.accept(); });
         QObject::connect(cancelButton, &QPushButton::clicked, [&dialog]()
                          { dialog.reject(); });
 
-        if (dialog.exec() == QDialog::Accepted)
+        if (dialog.exec() != QDialog::Accepted || options.empty())
+        {
+            return std::nullopt;
+        }
+        return options.at(comboBox->currentIndex());
+    }
+
+    /**
+     * Moves every item that allows it to a chosen state and saves them in one transaction.
+     * Items already in that state, or that cannot reach it, are left as they were.
+     * @return The number of items changed.
+     */
+    template <typename T, typename State>
+    inline size_t transitionPopUp(std::vector<T> &items, State T::*state, const QString &title)
+    {
+        auto target = chooseState(title, transitionsForAny(items, state));
+        if (!target)
+        {
+            return 0;
+        }
+        std::vector<T> changed;
+        size_t skipped = 0;
+        for (auto &item : items)
+        {
+            if (item.*state == *target)
+            {
+                continue;
+            }
+            auto allowed = allowedTransitions(item.*state);
+            if (std::find(allowed.begin(), allowed.end(), *target) == allowed.end())
+            {
+                ++skipped;
+                continue;
+            }
+            item.*state = *target;
+            changed.push_back(item);
+        }
+        woodworks::infra::QtSqlRepository<T>::spawn().updateMany(changed);
+        if (skipped > 0)
         {
-            QtSqlRepository<T>::spawn().update(toDry);
+            QMessageBox::information(nullptr, title,
+                                     QString("%1 of the selected items cannot become %2 and were left as they were.")
+                                         .arg(skipped)
+                                         .arg(QString::fromStdString(toString(*target))));
         }
+        return changed.size();
     }
 
     template <typename T>
-    inline void scrapPopUp(const T &entity, QWidget *parent)
+    inline void dryingPopUp(std::vector<T> &toDry)
+    {
+        transitionPopUp(toDry, &T::drying, "Dry Items");
+    }
+
+    template <typename T>
+    inline void dryingPopUp(T &toDry)
+    {
+        std::vector<T> items{toDry};
+        transitionPopUp(items, &T::drying, "Dry Item");
+        toDry = items.front();
+    }
+
+    /**
+     * Asks for a new location and moves every item there in one transaction.
+     * @return True if the items were moved.
+     */
+    template <typename T>
+    inline bool relocatePopUp(std::vector<T> &items, QWidget *parent)
+    {
+        if (items.empty())
+        {
+            return false;
+        }
+        bool ok;
+        QString currentLoc = QString::fromStdString(items.front().location);
+        QString newLoc = QInputDialog::getText(parent, "Relocate", "Enter new location:", QLineEdit::Normal, currentLoc, &ok);
+        if (!ok || newLoc.isEmpty())
+        {
+            return false;
+        }
+        for (auto &item : items)
+        {
+            item.location = newLoc.toStdString();
+        }
+        woodworks::infra::QtSqlRepository<T>::spawn().updateMany(items);
+        return true;
+    }
+
+    template <typename T>
+    inline void scrapPopUp(const std::vector<T> &entities, QWidget *parent)
     {
+        if (entities.empty())
+        {
+            return;
+        }
+        QString question = entities.size() == 1
+                               ? QString("Are you sure you want to delete this item?")
+                               : QString("Are you sure you want to delete these %1 items?").arg(entities.size());
         QMessageBox::StandardButton reply = QMessageBox::question(
             parent,
             "Confirm",
-            "Are you sure you want to delete this item?",
+            question,
             QMessageBox::Yes | QMessageBox::No);
         if (reply == QMessageBox::Yes)
         {
-            QtSqlRepository<T>::spawn().remove(entity.id.id);
+            std::vector<int> ids;
+            for (const auto &entity : entities)
+            {
+                ids.push_back(entity.id.id);
+            }
+            woodworks::infra::QtSqlRepository<T>::spawn().removeMany(ids);
         }
     }
+
+    template <typename T>
+    inline void scrapPopUp(const T &entity, QWidget *parent)
+    {
+        scrapPopUp(std::vector<T>{entity}, parent);
+    }
 }
@@ -1,4 +1,3 @@
-#include <iostream>
 #include <fstream>
 #include <string>
 #include <algorithm>
@@ -6,6 +5,7 @@
 
 #include "csv_importer.hpp"
 #include "domain/log.hpp"
+#include "infra/logging.hpp"
 
 std::vector<std::string> Importer::digestLine(const std::string &line)
 {
@@ -103,7 +103,7 @@ void Importer::importLogs(const std::string &filePath)
     std::ifstream file(filePath);
     if (!file)
     {
-        std::cout << "File could not open at: " << filePath << std::endl;
+        WOODWORKS_LOG_WARN("importer", "file could not open", {{"path", filePath}});
         return;
     }
 
@@ -192,7 +192,7 @@ void Importer::importLogs(const std::string &filePath)
         auto repo = woodworks::infra::QtSqlRepository<woodworks::domain::Log>(db);
         if (!repo.add(log))
         {
-            std::cerr << "Failed to insert log: " + db.lastError().text().toStdString() << std::endl;
+            WOODWORKS_LOG_ERROR("importer", "failed to insert log", {{"path", filePath}, {"error", db.lastError().text()}});
         }
     }
 }
@@ -204,7 +204,7 @@ void Importer::importFirewood(const std::string &filePath)
     std::ifstream file(filePath);
     if (!file)
     {
-        std::cout << "File could not open at: " << filePath << std::endl;
+        WOODWORKS_LOG_WARN("importer", "file could not open", {{"path", filePath}});
         return;
     }
 
@@ -282,7 +282,7 @@ void Importer::importFirewood(const std::string &filePath)
         auto repo = woodworks::infra::QtSqlRepository<woodworks::domain::Firewood>(db);
         if (!repo.add(firewood))
         {
-            std::cerr << "Failed to insert firewood: " + db.lastError().text().toStdString() << std::endl;
+            WOODWORKS_LOG_ERROR("importer", "failed to insert firewood", {{"path", filePath}, {"error", db.lastError().text()}});
         }
     }
 }
@@ -294,7 +294,7 @@ void Importer::importSlabs(const std::string &filePath)
     std::ifstream file(filePath);
     if (!file)
     {
-        std::cout << "File could not open at: " << filePath << std::endl;
+        WOODWORKS_LOG_WARN("importer", "file could not open", {{"path", filePath}});
         return;
     }
 
@@ -381,7 +381,7 @@ void Importer::importSlabs(const std::string &filePath)
         auto repo = woodworks::infra::QtSqlRepository<woodworks::domain::LiveEdgeSlab>(db);
         if (!repo.add(slab))
         {
-            std::cerr << "Failed to insert live edge slab: " + db.lastError().text().toStdString() << std::endl;
+            WOODWORKS_LOG_ERROR("importer", "failed to insert live edge slab", {{"path", filePath}, {"error", db.lastError().text()}});
         }
     }
 }
@@ -393,7 +393,7 @@ void Importer::importCookies(const std::string &filePath)
     std::ifstream file(filePath);
     if (!file)
     {
-        std::cout << "File could not open at: " << filePath << std::endl;
+        WOODWORKS_LOG_WARN("importer", "file could not open", {{"path", filePath}});
         return;
     }
 
@@ -474,7 +474,7 @@ void Importer::importCookies(const std::string &filePath)
         auto repo = woodworks::infra::QtSqlRepository<woodworks::domain::Cookie>(db);
         if (!repo.add(cookie))
         {
-            std::cerr << "Failed to insert cookie: " + db.lastError().text().toStdString() << std::endl;
+            WOODWORKS_LOG_ERROR("importer", "failed to insert cookie", {{"path", filePath}, {"error", db.lastError().text()}});
         }
     }
 }
@@ -487,7 +487,7 @@ void Importer::importLumber(const std::string &filePath)
     std::ifstream file(filePath);
     if (!file)
     {
-        std::cout << "File could not open at: " << filePath << std::endl;
+        WOODWORKS_LOG_WARN("importer", "file could not open", {{"path", filePath}});
         return;
     }
 
@@ -574,7 +574,7 @@ void Importer::importLumber(const std::string &filePath)
         auto repo = woodworks::infra::QtSqlRepository<woodworks::domain::Lumber>(db);
         if (!repo.add(lumber))
         {
-            std::cerr << "Failed to insert lumber: " + db.lastError().text().toStdString() << std::endl;
+            WOODWORKS_LOG_ERROR("importer", "failed to insert lumber", {{"path", filePath}, {"error", db.lastError().text()}});
         }
     }
 }
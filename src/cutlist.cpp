@@ -16,13 +16,16 @@
 #include <QFormLayout>
 #include <QHeaderView>
 #include <QHBoxLayout>
+#include <QVBoxLayout>
 #include <QMenu>
+#include <QTimer>
 
 #include "adjust_log_length_dialog.hpp"
 #include "cutlist.hpp"
 #include "standard_cut_dialog.hpp"
 #include "ui_cutlist.h"
 #include "domain/cutlist.hpp"
+#include "domain/nesting.hpp"
 #include "infra/repository.hpp"
 
 using namespace woodworks::domain;
@@ -37,6 +40,7 @@ CutlistPage::CutlistPage(QWidget *parent) : QWidget(parent), ui(new Ui::CutlistP
     // Link slots
     connect(ui->addPartButton, &QPushButton::clicked, this, &CutlistPage::newPart);
     connect(ui->deleteProjectButton, &QPushButton::clicked, this, &CutlistPage::deleteProject);
+    connect(ui->nestPartsButton, &QPushButton::clicked, this, &CutlistPage::planFromInventory);
     connect(ui->makeCutButton, &QPushButton::clicked, this, &CutlistPage::cutLog);
     connect(ui->markCompleteRoughButton, &QPushButton::clicked, this, &CutlistPage::partCompleteRough);
     connect(ui->markCompleteFinishedButton, &QPushButton::clicked, this, &CutlistPage::partCompleteFinished);
@@ -46,8 +50,8 @@ CutlistPage::CutlistPage(QWidget *parent) : QWidget(parent), ui(new Ui::CutlistP
     connect(&RepositoryNotifier::instance(), &RepositoryNotifier::repositoryChanged,
             this, &CutlistPage::refreshModels);
 
-    updateProjects();
-    refreshModels();
+    // Load after the page has painted; updateProjects also refreshes the tables
+    QTimer::singleShot(0, this, &CutlistPage::updateProjects);
     ui->orderMarkerTable->setContextMenuPolicy(Qt::CustomContextMenu);
     connect(ui->orderMarkerTable, &QWidget::customContextMenuRequested,
             this, &CutlistPage::cutsCustomContextMenu);
@@ -153,17 +157,77 @@ void CutlistPage::deleteProject()
                                        QMessageBox::Yes | QMessageBox::No);
     if (reply != QMessageBox::Yes)
         return;
-    auto repo = QtSqlRepository<CustomCut>::spawn();
-    auto cuts = repo.list();
-    for (const auto &cut : cuts)
+    QtSqlRepository<CustomCut>::spawn().deleteWhere({{"project", currentProject}});
+    updateProjects();
+    refreshModels();
+}
+
+void CutlistPage::planFromInventory()
+{
+    QString currentProject = ui->projectSelectorCombo->currentText();
+    if (currentProject.isEmpty())
+        return;
+
+    auto result = nesting::CutlistNester().nestProject(currentProject.toStdString());
+    if (result.parts.empty())
+    {
+        QMessageBox::information(this, "Plan From Inventory", "Every part in this project has been cut.");
+        return;
+    }
+
+    // Write the plan out board by board
+    QString report;
+    for (const auto &board : result.boards)
     {
-        if (QString::fromStdString(cut.project) == currentProject)
+        report += QString("%1 #%2 (%3 x %4 x %5 in), %6 bf waste\n")
+                      .arg(board.stock.kind == nesting::StockKind::SLAB ? "Slab" : "Lumber")
+                      .arg(board.stock.id.id)
+                      .arg(board.stock.thickness.toInches())
+                      .arg(board.stock.width.toInches())
+                      .arg(board.stock.length.toInches())
+                      .arg(board.wasteBoardFeet, 0, 'f', 2);
+        for (const auto &placement : board.placements)
         {
-            repo.remove(cut.id.id);
+            const auto &part = result.parts[placement.part];
+            report += QString("    %1: %2 x %3 in at %4 in along, %5 in across\n")
+                          .arg(QString::fromStdString(part.name))
+                          .arg(part.width.toInches())
+                          .arg(part.length.toInches())
+                          .arg(placement.alongLength.toInches())
+                          .arg(placement.acrossWidth.toInches());
         }
     }
-    updateProjects();
-    refreshModels();
+    if (!result.unplaced.empty())
+    {
+        report += "\nNo stock for:\n";
+        for (size_t index : result.unplaced)
+        {
+            const auto &part = result.parts[index];
+            report += QString("    %1 (%2, %3 x %4 x %5 in)\n")
+                          .arg(QString::fromStdString(part.name))
+                          .arg(QString::fromStdString(part.species))
+                          .arg(part.thickness.toInches())
+                          .arg(part.width.toInches())
+                          .arg(part.length.toInches());
+        }
+    }
+    report += QString("\n%1 boards, %2% utilization, %3 bf waste")
+                  .arg(result.boards.size())
+                  .arg(result.utilization * 100.0, 0, 'f', 1)
+                  .arg(result.wasteBoardFeet, 0, 'f', 2);
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("Plan From Inventory: " + currentProject);
+    QVBoxLayout layout(&dialog);
+    auto *text = new QTextEdit(&dialog);
+    text->setReadOnly(true);
+    text->setPlainText(report);
+    layout.addWidget(text);
+    QDialogButtonBox buttonBox(QDialogButtonBox::Close, Qt::Horizontal, &dialog);
+    layout.addWidget(&buttonBox);
+    QObject::connect(&buttonBox, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    dialog.resize(600, 500);
+    dialog.exec();
 }
 
 void CutlistPage::cutLog()
@@ -244,7 +308,7 @@ void CutlistPage::refreshModels()
     auto query = CustomCut::cutlistViewSQLQuery(currentProject);
     // Set the model for the custom parts table
     auto model = new QSqlQueryModel(this);
-    model->setQuery(query);
+    woodworks::infra::setTracedQuery(model, query);
     ui->orderMarkerTable->setModel(model);
 
     ui->orderMarkerTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
@@ -2,8 +2,10 @@
 #include "domain/cookie.hpp"
 #include "domain/units.hpp"
 #include "domain/types.hpp"
+#include "domain/geometry_kernels.hpp"
 #include "infra/repository.hpp"
 #include "infra/connection.hpp"
+#include "infra/logging.hpp"
 
 #include <cmath>
 
@@ -19,19 +21,13 @@ namespace woodworks::domain
         // Update the worth
         // Calculate the ratio of the cut length to the original length
         Length newLength = length - cutLength;
-        std::cout << "Cut length: " << cutLength.toInches() << " inches" << std::endl;
-        std::cout << "Old length: " << length.toInches() << " inches" << std::endl;
-        std::cout << "New length: " << newLength.toInches() << " inches" << std::endl;
-
         double ratio = static_cast<double>(newLength.toTicks()) / static_cast<double>(length.toTicks());
-        std::cout << "Ratio: " << ratio << std::endl;
         // Update the cost based on the ratio
         auto oldCost = cost;
         cost = Dollar(static_cast<int>(cost.toCents() * ratio));
+        WOODWORKS_LOG_DEBUG("log", "cut", {{"id", id.id}, {"cutInches", cutLength.toInches()}, {"oldInches", length.toInches()}, {"newInches", newLength.toInches()}, {"ratio", ratio}, {"oldCents", oldCost.toCents()}, {"newCents", cost.toCents()}});
         // Update the length
         length = newLength;
-        std::cout << "New cost: " << cost.toCents() << " cents" << std::endl;
-        std::cout << "Saved Length: " << length.toInches() << " inches" << std::endl;
 
         // Check if the log shoudl be deleted
         auto &deebee = woodworks::infra::DbConnection::instance();
@@ -40,7 +36,7 @@ namespace woodworks::domain
         {
             // Log is empty, delete it
             repo.remove(id.id);
-            std::cout << "Log is empty, deleting it" << std::endl;
+            WOODWORKS_LOG_DEBUG("log", "log is empty, deleted it", {{"id", id.id}});
             return Dollar(0);
         }
 
@@ -86,7 +82,7 @@ namespace woodworks::domain
     Firewood Log::cutFirewood(Length cutLength)
     {
         // Check if the length is valid
-        if (length > this->length)
+        if (cutLength > this->length)
         {
             throw std::invalid_argument("Cut length is greater than log length");
         }
@@ -94,7 +90,7 @@ namespace woodworks::domain
 
         // Create the firewood. We give, in general, 120% of the cut length's volume to the firewood
         // to account for air
-        double firewoodVolume = cutLength.toFeet() * pow((this->diameter.toFeet() / 2), 2) * 3.14159 * 1.2;
+        double firewoodVolume = geometry::cylinderCubicFeet(this->diameter, cutLength) * 1.2;
         auto firewood = Firewood::uninitialized();
         firewood.species = species;
         firewood.cubicFeet = firewoodVolume;
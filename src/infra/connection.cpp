@@ -1,8 +1,49 @@
+#include <QSettings>
 #include <QSqlError>
 #include <QSqlQuery>
+#include <chrono>
 #include <mutex>
 
 #include "infra/connection.hpp"
+#include "infra/logging.hpp"
+#include "infra/migrations.hpp"
+
+namespace
+{
+    // Every connection that opens this URI shares the one in-memory database
+    const char *const MEMORY_URI = "file:woodworks?mode=memory&cache=shared";
+    const char *const TEMPLATE_CONNECTION = "woodworks_template";
+
+    QString setting(const char *environment, const char *key, const QString &fallback)
+    {
+        QString value = qEnvironmentVariable(environment);
+        if (!value.isEmpty())
+        {
+            return value;
+        }
+        return QSettings("WoodWorks", "WoodWorks").value(key, fallback).toString();
+    }
+
+    // VACUUM INTO writes a consistent copy of the template straight into the shared in-memory database
+    void copyTemplate(const QString &templatePath)
+    {
+        {
+            QSqlDatabase source = QSqlDatabase::addDatabase("QSQLITE", TEMPLATE_CONNECTION);
+            source.setDatabaseName(templatePath);
+            source.setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_OPEN_URI");
+            if (!source.open())
+            {
+                throw std::runtime_error("Failed to open database template " + templatePath.toStdString() + ": " + source.lastError().text().toStdString());
+            }
+            QSqlQuery copy(source);
+            if (!copy.exec(QString("VACUUM INTO '%1'").arg(MEMORY_URI)))
+            {
+                throw std::runtime_error("Failed to copy database template " + templatePath.toStdString() + ": " + copy.lastError().text().toStdString());
+            }
+        }
+        QSqlDatabase::removeDatabase(TEMPLATE_CONNECTION);
+    }
+}
 
 namespace woodworks::infra
 {
@@ -10,12 +51,54 @@ namespace woodworks::infra
     {
         std::call_once(initFlag_, []
                        {
+            auto start = std::chrono::steady_clock::now();
+            QString file = path();
+            QString seed = file == IN_MEMORY ? templatePath() : QString();
             db_ = QSqlDatabase::addDatabase("QSQLITE");
-            db_.setDatabaseName("woodworks.db");
+            if (file == IN_MEMORY) {
+                db_.setDatabaseName(MEMORY_URI);
+                db_.setConnectOptions("QSQLITE_OPEN_URI");
+            } else {
+                db_.setDatabaseName(file);
+            }
             if (!db_.open()) {
                 throw std::runtime_error("Failed to open database" + db_.lastError().text().toStdString());
             }
-            db_.exec("PRAGMA foreign_keys = ON;"); });
+            opened_ = true;
+            // The in-memory database lives as long as db_ is open, so it is copied into only now
+            if (file == IN_MEMORY && !seed.isEmpty()) {
+                copyTemplate(seed);
+            }
+            db_.exec("PRAGMA foreign_keys = ON;");
+            double openMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            // Only runs DDL when the schema version is behind
+            auto report = SchemaMigrator::migrate(db_);
+            WOODWORKS_LOG_INFO("database", "ready", {{"path", file}, {"template", seed}, {"version", report.toVersion}, {"migrations", report.applied}, {"openMs", openMs}, {"migrateMs", report.seconds * 1000.0}}); });
         return db_;
     }
-}
\ No newline at end of file
+
+    void DbConnection::configure(const QString &path, const QString &templatePath)
+    {
+        if (opened_)
+        {
+            throw std::runtime_error("Database already opened at " + DbConnection::path().toStdString());
+        }
+        path_ = path;
+        templatePath_ = templatePath;
+    }
+
+    QString DbConnection::path()
+    {
+        return path_.isEmpty() ? setting("WOODWORKS_DB", "database/path", "woodworks.db") : path_;
+    }
+
+    QString DbConnection::templatePath()
+    {
+        if (!path_.isEmpty())
+        {
+            return templatePath_;
+        }
+        return setting("WOODWORKS_DB_TEMPLATE", "database/template", QString());
+    }
+}
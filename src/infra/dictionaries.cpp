@@ -0,0 +1,233 @@
+#include "infra/dictionaries.hpp"
+
+#include <QSqlError>
+#include <QSqlRecord>
+
+#include "infra/connection.hpp"
+#include "infra/logging.hpp"
+#include "infra/name_table.hpp"
+#include "infra/sql_trace.hpp"
+#include "infra/mappers/view_helpers.hpp"
+
+using namespace woodworks::infra;
+
+namespace
+{
+    struct Source
+    {
+        const char *table;
+        const char *column;
+        Dictionaries::Kind kind;
+    };
+
+    const Source sources[] = {
+        {"logs", "species_id", Dictionaries::SPECIES},
+        {"cookies", "species_id", Dictionaries::SPECIES},
+        {"live_edge_slabs", "species_id", Dictionaries::SPECIES},
+        {"lumber", "species_id", Dictionaries::SPECIES},
+        {"firewood", "species_id", Dictionaries::SPECIES},
+        {"logs", "location_id", Dictionaries::LOCATIONS},
+        {"cookies", "location_id", Dictionaries::LOCATIONS},
+        {"live_edge_slabs", "location_id", Dictionaries::LOCATIONS},
+        {"lumber", "location_id", Dictionaries::LOCATIONS},
+        {"firewood", "location_id", Dictionaries::LOCATIONS},
+        {"logs", "drying", Dictionaries::DRYING},
+        {"cookies", "drying", Dictionaries::DRYING},
+        {"live_edge_slabs", "drying", Dictionaries::DRYING},
+        {"lumber", "drying", Dictionaries::DRYING},
+        {"firewood", "drying", Dictionaries::DRYING},
+        {"live_edge_slabs", "surfacing", Dictionaries::SLAB_SURFACING},
+        {"lumber", "surfacing", Dictionaries::LUMBER_SURFACING},
+        {"lumber", "thickness", Dictionaries::LUMBER_THICKNESS},
+    };
+
+    // A label list as the display view renders it, so combo text matches the filtered column
+    QString label(const QString &view, const QString &alias, int code)
+    {
+        static std::mutex mutex;
+        static std::map<QString, std::map<int, QString>> labels;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = labels.find(view);
+        if (it == labels.end())
+        {
+            it = labels.emplace(view, displayLabels(view, alias)).first;
+        }
+        auto found = it->second.find(code);
+        return found == it->second.end() ? QString::number(code) : found->second;
+    }
+
+    std::pair<qint64, QString> entryFor(const QSqlDatabase &db, Dictionaries::Kind kind, const QVariant &raw)
+    {
+        switch (kind)
+        {
+        case Dictionaries::DRYING:
+            return {raw.toInt(), label("display_logs", "Drying", raw.toInt())};
+        case Dictionaries::SLAB_SURFACING:
+            return {raw.toInt(), label("display_slabs", "Surfacing", raw.toInt())};
+        case Dictionaries::LUMBER_SURFACING:
+            return {raw.toInt(), label("display_lumber", "Surfacing", raw.toInt())};
+        case Dictionaries::LUMBER_THICKNESS:
+        {
+            // Truncated like the view's printf('%d/4', thickness/4)
+            auto quarters = static_cast<qint64>(raw.toDouble() / 4);
+            return {quarters, QString("%1/4").arg(quarters)};
+        }
+        case Dictionaries::SPECIES:
+            return {0, QString::fromStdString(NameTable::species(db).name(raw.toInt()))};
+        case Dictionaries::LOCATIONS:
+            return {0, QString::fromStdString(NameTable::locations(db).name(raw.toInt()))};
+        default:
+            return {0, raw.toString()};
+        }
+    }
+}
+
+Dictionaries &Dictionaries::instance()
+{
+    return of(DbConnection::instance());
+}
+
+Dictionaries &Dictionaries::of(const QSqlDatabase &db)
+{
+    static std::mutex mutex;
+    static std::map<QString, std::unique_ptr<Dictionaries>> all;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &slot = all[db.connectionName() + '\n' + db.databaseName()];
+    if (!slot)
+    {
+        slot.reset(new Dictionaries(db.connectionName()));
+    }
+    return *slot;
+}
+
+QStringList Dictionaries::values(Kind kind)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!loaded_)
+    {
+        load();
+    }
+    QStringList out;
+    for (const auto &[entry, count] : counts_[kind])
+    {
+        out << entry.second;
+    }
+    return out;
+}
+
+bool Dictionaries::loaded() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return loaded_;
+}
+
+std::optional<QVariantMap> Dictionaries::read(QSqlDatabase &db, const QString &table, int id) const
+{
+    if (!loaded())
+    {
+        return std::nullopt;
+    }
+    QStringList columns;
+    for (const auto &source : sources)
+    {
+        if (table == source.table)
+        {
+            columns << source.column;
+        }
+    }
+    if (columns.isEmpty())
+    {
+        return std::nullopt;
+    }
+    TracedQuery q(db);
+    q.prepare(QString("SELECT %1 FROM %2 WHERE id = ?").arg(columns.join(", "), table));
+    q.bindValue(0, id);
+    if (!q.exec() || !q.next())
+    {
+        return std::nullopt;
+    }
+    QVariantMap row;
+    for (int i = 0; i < columns.size(); ++i)
+    {
+        row.insert(columns[i], q.value(i));
+    }
+    return row;
+}
+
+void Dictionaries::added(const QString &table, const QVariantMap &row)
+{
+    apply(table, row, 1);
+}
+
+void Dictionaries::removed(const QString &table, const QVariantMap &row)
+{
+    apply(table, row, -1);
+}
+
+void Dictionaries::invalidate()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!loaded_)
+    {
+        return;
+    }
+    loaded_ = false;
+    for (auto &counts : counts_)
+    {
+        counts.clear();
+    }
+    ++stats_.invalidations;
+}
+
+DictionaryStats Dictionaries::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void Dictionaries::load()
+{
+    QSqlDatabase db = QSqlDatabase::database(connection_, false);
+    for (const auto &source : sources)
+    {
+        TracedQuery q(db);
+        // A row without a location has no entry, rather than a blank one
+        if (!q.exec(QString("SELECT %1, COUNT(*) FROM %2 WHERE %1 IS NOT NULL GROUP BY %1").arg(source.column, source.table)))
+        {
+            WOODWORKS_LOG_WARN("dictionaries", "load failed", {{"table", source.table}, {"column", source.column}, {"error", q.lastError().text()}});
+            continue;
+        }
+        while (q.next())
+        {
+            counts_[source.kind][entryFor(db, source.kind, q.value(0))] += q.value(1).toInt();
+        }
+    }
+    loaded_ = true;
+    ++stats_.loads;
+}
+
+void Dictionaries::apply(const QString &table, const QVariantMap &row, int delta)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!loaded_)
+    {
+        return;
+    }
+    const QSqlDatabase db = QSqlDatabase::database(connection_, false);
+    for (const auto &source : sources)
+    {
+        if (table != source.table || !row.contains(source.column) || row.value(source.column).isNull())
+        {
+            continue;
+        }
+        auto &counts = counts_[source.kind];
+        auto entry = entryFor(db, source.kind, row.value(source.column));
+        int &count = counts[entry];
+        count += delta;
+        if (count <= 0)
+        {
+            counts.erase(entry);
+        }
+    }
+    ++stats_.rowsApplied;
+}
@@ -0,0 +1,93 @@
+#include "infra/entity_cache.hpp"
+
+#include <cstdlib>
+
+using namespace woodworks::infra;
+
+namespace
+{
+    struct Registered
+    {
+        std::function<void(size_t)> setCapacity;
+        std::function<void()> clear;
+        std::function<CacheStats()> stats;
+    };
+
+    struct Registry
+    {
+        std::mutex mutex;
+        std::vector<Registered> caches;
+        std::vector<std::function<void()>> stored;
+        size_t capacity{0};
+
+        Registry()
+        {
+            if (const char *env = std::getenv("WOODWORKS_ENTITY_CACHE_KB"))
+            {
+                capacity = std::strtoul(env, nullptr, 10) * 1024;
+            }
+        }
+    };
+
+    Registry &registry()
+    {
+        static Registry instance;
+        return instance;
+    }
+}
+
+void EntityCaches::setCapacity(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    registry().capacity = bytes;
+    for (auto &cache : registry().caches)
+    {
+        cache.setCapacity(bytes);
+        if (bytes == 0)
+        {
+            cache.clear();
+        }
+    }
+}
+
+size_t EntityCaches::capacity()
+{
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    return registry().capacity;
+}
+
+void EntityCaches::clearAll()
+{
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    for (auto &cache : registry().caches)
+    {
+        cache.clear();
+    }
+    for (auto &clear : registry().stored)
+    {
+        clear();
+    }
+}
+
+std::vector<CacheStats> EntityCaches::stats()
+{
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    std::vector<CacheStats> all;
+    for (auto &cache : registry().caches)
+    {
+        all.push_back(cache.stats());
+    }
+    return all;
+}
+
+void EntityCaches::registerCache(std::function<void(size_t)> setCapacity, std::function<void()> clear, std::function<CacheStats()> stats)
+{
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    registry().caches.push_back(Registered{std::move(setCapacity), std::move(clear), std::move(stats)});
+}
+
+void EntityCaches::registerStoredColumns(std::function<void()> clear)
+{
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    registry().stored.push_back(std::move(clear));
+}
@@ -0,0 +1,306 @@
+#include "infra/inventory_generator.hpp"
+
+#include <QSqlError>
+#include <QSqlQuery>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "domain/geometry_kernels.hpp"
+#include "domain/slab_cutter.hpp"
+#include "domain/slab_planner.hpp"
+#include "domain/lumber_cutter.hpp"
+#include "infra/connection.hpp"
+#include "infra/repository.hpp"
+#include "infra/unit_of_work.hpp"
+
+using namespace woodworks::infra;
+using namespace woodworks::domain;
+
+namespace
+{
+    // Share of each species in a typical yard, out of 100
+    const std::pair<const char *, uint32_t> SPECIES_MIX[] = {
+        {"Oak", 30}, {"Maple", 20}, {"Walnut", 15}, {"Cherry", 15}, {"Ash", 10}, {"Elm", 10}};
+    const char *const LOCATIONS[] = {"Yard", "Barn", "Kiln", "Shop", "Showroom"};
+    const char *const PARTS[] = {"Leg", "Apron", "Top", "Shelf", "Rail", "Stile", "Panel", "Drawer Front"};
+    const int SLAB_QUARTERS[] = {8, 8, 8, 10, 12, 12, 16};
+    const int LUMBER_QUARTERS[] = {4, 4, 4, 5, 6, 8};
+    const int LUMBER_INCHES[] = {4, 4, 6, 6, 8, 10, 12};
+
+    // Cookies cut from a lineage log, and the boards ripped from its slabs
+    const Length COOKIE_THICKNESS = Length::fromInches(2);
+    const Length RIP_WIDTH = Length::fromInches(4);
+
+    template <typename T, size_t N>
+    constexpr uint32_t choices(const T (&)[N]) { return static_cast<uint32_t>(N); }
+}
+
+InventoryGenerator::InventoryGenerator(uint32_t seed) : rng_(seed) {}
+
+GeneratorStats InventoryGenerator::generate(const GeneratorOptions &options)
+{
+    auto start = std::chrono::steady_clock::now();
+    imageBytes_ = options.imageBytes;
+    images_.clear();
+
+    GeneratorStats stats;
+    stats.logs += insertMany<Log>(options.logs, options.batchSize, [&]()
+                                  { return makeLog(); });
+    cutLineage(options.lineageLogs, stats);
+    stats.slabs += insertMany<LiveEdgeSlab>(options.slabs, options.batchSize, [&]()
+                                            { return makeSlab(); });
+    stats.lumber += insertMany<Lumber>(options.lumber, options.batchSize, [&]()
+                                       { return makeLumber(); });
+    stats.cookies += insertMany<Cookie>(options.cookies, options.batchSize, [&]()
+                                        { return makeCookie(); });
+    stats.firewood += insertMany<Firewood>(options.firewood, options.batchSize, [&]()
+                                           { return makeFirewood(); });
+    stats.customCuts += insertMany<CustomCut>(options.customCuts, options.batchSize, [&]()
+                                              { return makeCustomCut(); });
+
+    // One notification for the whole run instead of one per row; most rows bypassed the repositories
+    Dictionaries::instance().invalidate();
+    InventorySnapshots::instance().invalidate();
+    RepositoryNotifier::instance().notifyChanged();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+template <typename T, typename Make>
+size_t InventoryGenerator::insertMany(size_t total, size_t batchSize, Make make)
+{
+    if (total == 0)
+    {
+        return 0;
+    }
+    auto &db = DbConnection::instance();
+    QSqlQuery q(db);
+    if (!q.prepare(T::insertSQL()))
+    {
+        throw std::runtime_error("Failed to prepare insert statement: " + q.lastError().text().toStdString());
+    }
+    size_t written = 0;
+    while (written < total)
+    {
+        UnitOfWork uow(db);
+        size_t end = std::min(total, written + std::max<size_t>(batchSize, 1));
+        for (; written < end; ++written)
+        {
+            T::bindForInsert(q, make());
+            if (!q.exec())
+            {
+                throw std::runtime_error("Failed to insert item: " + q.lastError().text().toStdString());
+            }
+        }
+        uow.commit();
+    }
+    return written;
+}
+
+void InventoryGenerator::cutLineage(size_t total, GeneratorStats &stats)
+{
+    if (total == 0)
+    {
+        return;
+    }
+    auto &db = DbConnection::instance();
+    auto logs = QtSqlRepository<Log>::spawn();
+
+    slabs::SlabPlannerOptions planOptions;
+    for (int quarters : {8, 12})
+    {
+        planOptions.thicknesses.push_back(slabs::ThicknessOption{Length::fromQuarters(quarters), 1.0});
+    }
+    planOptions.minWidth = Length::fromInches(6);
+    planOptions.objective = slabs::PlanObjective::YIELD;
+    planOptions.maxPlans = 1;
+    slabs::SlabPlanner planner(planOptions);
+
+    UnitOfWork uow(db);
+    for (size_t i = 0; i < total; ++i)
+    {
+        Log log = makeLog();
+        log.id = Id{logs.add(log)};
+        ++stats.logs;
+
+        // Saw a section into slabs, leaving at least two feet of log for a cookie
+        slabs::SlabCutter cutter(log);
+        Length section = Length::fromFeet(4 + below(static_cast<uint32_t>(log.length.toFeet()) - 5));
+        auto plans = planner.plan(cutter);
+        std::vector<LiveEdgeSlab> cut;
+        if (!plans.empty())
+        {
+            plans.front().applyTo(cutter);
+            cut = cutter.completeCuts(section, location(), "From log #" + std::to_string(log.id.id));
+            stats.slabs += cut.size();
+        }
+        cutter.log.cutCookie(COOKIE_THICKNESS);
+        ++stats.cookies;
+
+        // Rip every other slab into boards
+        for (size_t s = 0; s < cut.size(); s += 2)
+        {
+            if (cut[s].width < RIP_WIDTH + Length::fromInches(1))
+            {
+                continue;
+            }
+            lumber::LumberCutter ripper(cut[s]);
+            ripper.setTrimWidth(Length::fromInches(0.5));
+            ripper.setBoardWidth(RIP_WIDTH);
+            ripper.planCuts();
+            stats.slabs -= 1;
+            stats.lumber += ripper.finalizeCuts(cut[s].location, "From slab #" + std::to_string(cut[s].id.id)).size();
+        }
+    }
+    uow.commit();
+}
+
+uint32_t InventoryGenerator::below(uint32_t bound)
+{
+    return bound == 0 ? 0 : static_cast<uint32_t>(rng_() % bound);
+}
+
+double InventoryGenerator::bell(double mean, double spread, double low, double high)
+{
+    // Irwin-Hall: the sum of four uniforms is close to normal, with a standard deviation of 1/sqrt(3)
+    double sum = 0.0;
+    for (int i = 0; i < 4; ++i)
+    {
+        sum += static_cast<double>(rng_()) / 4294967296.0;
+    }
+    double value = mean + spread * (sum - 2.0) * 1.7320508075688772;
+    return std::clamp(value, low, high);
+}
+
+std::string InventoryGenerator::species()
+{
+    uint32_t roll = below(100);
+    for (const auto &[name, share] : SPECIES_MIX)
+    {
+        if (roll < share)
+        {
+            return name;
+        }
+        roll -= share;
+    }
+    return SPECIES_MIX[0].first;
+}
+
+std::string InventoryGenerator::location()
+{
+    return LOCATIONS[below(choices(LOCATIONS))];
+}
+
+QByteArray InventoryGenerator::image()
+{
+    if (imageBytes_ == 0)
+    {
+        return QByteArray();
+    }
+    // A small pool of distinct blobs; QByteArray shares them between rows
+    if (images_.empty())
+    {
+        const char signature[] = "\x89PNG\r\n\x1a\n";
+        for (int i = 0; i < 16; ++i)
+        {
+            QByteArray blob(static_cast<int>(imageBytes_), '\0');
+            char *data = blob.data();
+            for (size_t b = 0; b < imageBytes_; ++b)
+            {
+                data[b] = b < sizeof(signature) - 1 ? signature[b] : static_cast<char>(rng_());
+            }
+            images_.push_back(blob);
+        }
+    }
+    return images_[below(static_cast<uint32_t>(images_.size()))];
+}
+
+Log InventoryGenerator::makeLog()
+{
+    Log log = Log::uninitialized();
+    log.species = Species{species()};
+    log.length = Length::fromInches(std::round(bell(10.0, 2.0, 6.0, 16.0) * 12.0));
+    log.diameter = Length::fromInches(std::round(bell(20.0, 6.0, 8.0, 40.0)));
+    log.quality = Quality{static_cast<int>(std::round(bell(3.0, 1.0, 1.0, 5.0)))};
+    log.drying = below(10) < 7 ? Drying::GREEN : Drying::AIR_DRIED;
+    double centsPerCubicFoot = 150.0 + below(250);
+    log.cost = Dollar{static_cast<int>(geometry::cylinderCubicFeet(log.diameter, log.length) * centsPerCubicFoot)};
+    log.location = location();
+    log.imageBuffer = image();
+    return log;
+}
+
+LiveEdgeSlab InventoryGenerator::makeSlab()
+{
+    LiveEdgeSlab slab = LiveEdgeSlab::uninitialized();
+    slab.species = Species{species()};
+    slab.length = Length::fromInches(std::round(bell(8.0, 2.0, 4.0, 14.0) * 12.0));
+    slab.width = Length::fromInches(std::round(bell(18.0, 6.0, 6.0, 40.0)));
+    slab.thickness = Length::fromQuarters(SLAB_QUARTERS[below(choices(SLAB_QUARTERS))]);
+    slab.drying = static_cast<Drying>(below(4));
+    slab.surfacing = static_cast<SlabSurfacing>(below(3));
+    double centsPerBoardFoot = 800.0 + below(1200);
+    slab.worth = Dollar{static_cast<int>(geometry::boardFeet(slab.thickness, slab.width, slab.length) * centsPerBoardFoot)};
+    slab.location = location();
+    slab.imageBuffer = image();
+    return slab;
+}
+
+Lumber InventoryGenerator::makeLumber()
+{
+    Lumber board = Lumber::uninitialized();
+    board.species = Species{species()};
+    board.length = Length::fromInches(std::round(bell(8.0, 2.0, 4.0, 16.0) * 12.0));
+    board.width = Length::fromInches(LUMBER_INCHES[below(choices(LUMBER_INCHES))]);
+    board.thickness = Length::fromQuarters(LUMBER_QUARTERS[below(choices(LUMBER_QUARTERS))]);
+    board.drying = below(10) < 6 ? Drying::KILN_DRIED : static_cast<Drying>(below(4));
+    board.surfacing = below(10) < 7 ? LumberSurfacing::S4S : static_cast<LumberSurfacing>(below(5));
+    double centsPerBoardFoot = 400.0 + below(600);
+    board.worth = Dollar{static_cast<int>(geometry::boardFeet(board.thickness, board.width, board.length) * centsPerBoardFoot)};
+    board.location = location();
+    board.imageBuffer = image();
+    return board;
+}
+
+Cookie InventoryGenerator::makeCookie()
+{
+    Cookie cookie = Cookie::uninitialized();
+    cookie.species = Species{species()};
+    cookie.length = Length::fromQuarters(4 + below(9));
+    cookie.diameter = Length::fromInches(std::round(bell(16.0, 5.0, 6.0, 36.0)));
+    cookie.drying = static_cast<Drying>(below(4));
+    cookie.worth = Dollar{static_cast<int>(1500 + below(6500))};
+    cookie.location = location();
+    cookie.imageBuffer = image();
+    return cookie;
+}
+
+Firewood InventoryGenerator::makeFirewood()
+{
+    Firewood firewood = Firewood::uninitialized();
+    firewood.species = Species{species()};
+    firewood.cubicFeet = std::round(bell(64.0, 24.0, 8.0, 128.0));
+    firewood.drying = below(2) == 0 ? Drying::GREEN : Drying::AIR_DRIED;
+    firewood.cost = Dollar{static_cast<int>(firewood.cubicFeet * (200 + below(200)))};
+    firewood.location = location();
+    firewood.imageBuffer = image();
+    return firewood;
+}
+
+CustomCut InventoryGenerator::makeCustomCut()
+{
+    CustomCut cut = CustomCut::uninitialized();
+    uint32_t project = below(50);
+    cut.project = "Project " + std::to_string(project + 1);
+    cut.part = PARTS[below(choices(PARTS))];
+    cut.code = std::string(1, static_cast<char>('A' + project % 26)) + std::to_string(1 + below(20));
+    cut.quantity = static_cast<int>(1 + below(8));
+    cut.t = Length::fromQuarters(LUMBER_QUARTERS[below(choices(LUMBER_QUARTERS))]);
+    cut.w = Length::fromInches(2 + below(22));
+    cut.l = Length::fromInches(12 + below(84));
+    cut.species = species();
+    cut.imageBuffer = image();
+    return cut;
+}
@@ -0,0 +1,429 @@
+#include "infra/inventory_snapshot.hpp"
+
+#include <QRegularExpression>
+#include <QSqlError>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "infra/connection.hpp"
+#include "infra/logging.hpp"
+#include "infra/sql_trace.hpp"
+
+using namespace woodworks::infra;
+
+std::shared_ptr<InventorySnapshot> InventorySnapshot::load(QSqlDatabase &db, const QString &view)
+{
+    auto definition = displayView(view);
+    if (!definition || !definition->groupBy.isEmpty())
+    {
+        return nullptr;
+    }
+    static const QRegularExpression aliased(R"(^(.*) AS '([^']*)'$)");
+
+    auto snapshot = std::make_shared<InventorySnapshot>();
+    snapshot->view_ = view;
+    snapshot->table_ = definition->table.section(' ', 0, 0);
+    snapshot->baseColumns_ = filterableColumns(view);
+    for (const QString &column : definition->columns)
+    {
+        auto m = aliased.match(column);
+        snapshot->headers_ << (m.hasMatch() ? m.captured(2) : column);
+    }
+    snapshot->cells_.resize(definition->columns.size());
+    for (const QString &column : snapshot->baseColumns_)
+    {
+        snapshot->base_[column];
+    }
+    // The id comes last, so the display and base columns keep their positions
+    QStringList selected = definition->columns;
+    for (const QString &column : snapshot->baseColumns_)
+    {
+        selected << column;
+    }
+    selected << snapshot->table_ + ".id";
+    snapshot->source_ = QString("SELECT %1 FROM %2").arg(selected.join(", "), definition->table);
+    snapshot->read(db, QString(), {});
+    return snapshot;
+}
+
+int InventorySnapshot::read(QSqlDatabase &db, const QString &where, const QVector<QVariant> &bound)
+{
+    TracedQuery q(db);
+    q.setForwardOnly(true);
+    if (!q.prepare(where.isEmpty() ? source_ : source_ + " WHERE " + where))
+    {
+        throw std::runtime_error("Failed to read " + view_.toStdString() + ": " + q.lastError().text().toStdString());
+    }
+    for (int i = 0; i < bound.size(); ++i)
+    {
+        q.bindValue(i, bound[i]);
+    }
+    if (!q.exec())
+    {
+        throw std::runtime_error("Failed to read " + view_.toStdString() + ": " + q.lastError().text().toStdString());
+    }
+    const int displayed = static_cast<int>(cells_.size());
+    const int idColumn = displayed + static_cast<int>(baseColumns_.size());
+    std::vector<BaseColumn *> base;
+    for (const QString &column : baseColumns_)
+    {
+        base.push_back(&base_[column]);
+    }
+    int read = 0;
+    while (q.next())
+    {
+        const int id = q.value(idColumn).toInt();
+        auto known = rowOf_.find(id);
+        const bool append = known == rowOf_.end();
+        const size_t row = append ? static_cast<size_t>(rows_) : static_cast<size_t>(known->second);
+        for (int c = 0; c < displayed; ++c)
+        {
+            if (append)
+                cells_[c].push_back(q.value(c));
+            else
+                cells_[c][row] = q.value(c);
+        }
+        for (size_t b = 0; b < base.size(); ++b)
+        {
+            QVariant value = q.value(displayed + static_cast<int>(b));
+            bool ok = true;
+            double number = value.isNull() ? std::numeric_limits<double>::quiet_NaN() : value.toDouble(&ok);
+            base[b]->numeric = base[b]->numeric && ok;
+            if (append)
+                base[b]->values.push_back(number);
+            else
+                base[b]->values[row] = number;
+        }
+        if (append)
+        {
+            alive_.push_back(1);
+            rowOf_.emplace(id, rows_);
+            ++rows_;
+        }
+        else if (!alive_[row])
+        {
+            alive_[row] = 1;
+            --dead_;
+        }
+        ++read;
+    }
+    return read;
+}
+
+int InventorySnapshot::reload(QSqlDatabase &db, const std::set<int> &ids)
+{
+    std::vector<int> all(ids.begin(), ids.end());
+    // Whatever is not read back was deleted, or no longer belongs to the view
+    kill(all);
+    int read = 0;
+    const size_t chunk = 500;
+    for (size_t start = 0; start < all.size(); start += chunk)
+    {
+        size_t count = std::min(chunk, all.size() - start);
+        QStringList marks;
+        QVector<QVariant> bound;
+        for (size_t i = 0; i < count; ++i)
+        {
+            marks << "?";
+            bound << all[start + i];
+        }
+        read += this->read(db, QString("%1.id IN (%2)").arg(table_, marks.join(", ")), bound);
+    }
+    return read;
+}
+
+void InventorySnapshot::kill(const std::vector<int> &ids)
+{
+    for (int id : ids)
+    {
+        auto it = rowOf_.find(id);
+        if (it != rowOf_.end() && alive_[static_cast<size_t>(it->second)])
+        {
+            alive_[static_cast<size_t>(it->second)] = 0;
+            ++dead_;
+        }
+    }
+}
+
+std::optional<std::vector<int>> InventorySnapshot::match(const QVector<FieldFilter> &filters) const
+{
+    CompiledFilter compiled = compileFilters(view_, filters);
+    if (!compiled.baseOnly)
+    {
+        return std::nullopt;
+    }
+
+    // One pass per predicate over a contiguous column, without branches, so the compiler can vectorize it
+    std::vector<uint8_t> keep(alive_);
+    for (const BasePredicate &predicate : compiled.predicates)
+    {
+        auto column = base_.find(predicate.column);
+        if (column == base_.end() || !column->second.numeric)
+        {
+            return std::nullopt;
+        }
+        const double *values = column->second.values.data();
+        uint8_t *kept = keep.data();
+        const size_t n = keep.size();
+        if (predicate.equals.isValid())
+        {
+            bool ok = false;
+            const double wanted = predicate.equals.toDouble(&ok);
+            if (!ok)
+            {
+                return std::nullopt;
+            }
+            for (size_t i = 0; i < n; ++i)
+            {
+                kept[i] &= static_cast<uint8_t>(values[i] == wanted);
+            }
+        }
+        else
+        {
+            const double low = predicate.atLeast.isValid() ? predicate.atLeast.toDouble() : -std::numeric_limits<double>::infinity();
+            const double high = predicate.below.isValid() ? predicate.below.toDouble() : std::numeric_limits<double>::infinity();
+            for (size_t i = 0; i < n; ++i)
+            {
+                kept[i] &= static_cast<uint8_t>((values[i] >= low) & (values[i] < high));
+            }
+        }
+    }
+
+    std::vector<int> rows;
+    for (int i = 0; i < rows_; ++i)
+    {
+        if (keep[static_cast<size_t>(i)])
+        {
+            rows.push_back(i);
+        }
+    }
+    return rows;
+}
+
+InventorySnapshots &InventorySnapshots::instance()
+{
+    static InventorySnapshots snapshots;
+    return snapshots;
+}
+
+InventorySnapshots::InventorySnapshots()
+{
+    if (const char *env = std::getenv("WOODWORKS_SNAPSHOT_FILTERS"))
+    {
+        enabled_ = std::string(env) != "0";
+    }
+}
+
+bool InventorySnapshots::patchable(const QSqlDatabase &db)
+{
+    const QSqlDatabase &snapshotted = DbConnection::instance();
+    return db.connectionName() == snapshotted.connectionName() && db.databaseName() == snapshotted.databaseName();
+}
+
+bool InventorySnapshots::enabled() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return enabled_;
+}
+
+void InventorySnapshots::setEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    enabled_ = enabled;
+    if (!enabled_)
+    {
+        snapshots_.clear();
+    }
+}
+
+std::shared_ptr<const InventorySnapshot> InventorySnapshots::get(const QString &view)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_)
+    {
+        return nullptr;
+    }
+    auto it = snapshots_.find(view);
+    if (it != snapshots_.end())
+    {
+        Entry &entry = it->second;
+        if (!entry.snapshot)
+        {
+            return nullptr;
+        }
+        bool patched = true;
+        if (!entry.pending.empty())
+        {
+            try
+            {
+                entry.snapshot->reload(DbConnection::instance(), entry.pending);
+                stats_.rowsPatched += entry.pending.size();
+                entry.pending.clear();
+            }
+            catch (const std::runtime_error &e)
+            {
+                WOODWORKS_LOG_WARN("snapshot", "patch failed", {{"view", view}, {"error", e.what()}});
+                patched = false;
+            }
+        }
+        // Dead rows still cost a scan each; past a quarter of the view it is cheaper to read it again
+        if (patched && entry.snapshot->deadRows() <= std::max(64, entry.snapshot->rowCount() / 4))
+        {
+            return entry.snapshot;
+        }
+        snapshots_.erase(it);
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<InventorySnapshot> snapshot;
+    try
+    {
+        snapshot = InventorySnapshot::load(DbConnection::instance(), view);
+    }
+    catch (const std::runtime_error &e)
+    {
+        WOODWORKS_LOG_WARN("snapshot", "load failed", {{"view", view}, {"error", e.what()}});
+    }
+    // Views that cannot be snapshotted are remembered as nullptr, so they are not tried on every keystroke
+    snapshots_[view] = Entry{snapshot, {}};
+    if (snapshot)
+    {
+        ++stats_.loads;
+        WOODWORKS_LOG_DEBUG("snapshot", "loaded", {{"view", view}, {"rows", snapshot->rowCount()}, {"ms", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()}});
+    }
+    return snapshot;
+}
+
+void InventorySnapshots::invalidate()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    invalidateLocked();
+}
+
+void InventorySnapshots::invalidateLocked()
+{
+    if (snapshots_.empty())
+    {
+        return;
+    }
+    snapshots_.clear();
+    ++stats_.invalidations;
+}
+
+void InventorySnapshots::rowsWritten(const QSqlDatabase &db, const QString &table, const std::vector<int> &ids)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!patchable(db))
+    {
+        invalidateLocked();
+        return;
+    }
+    for (auto &[view, entry] : snapshots_)
+    {
+        if (entry.snapshot && entry.snapshot->table() == table)
+        {
+            entry.pending.insert(ids.begin(), ids.end());
+        }
+    }
+}
+
+void InventorySnapshots::rowsRemoved(const QSqlDatabase &db, const QString &table, const std::vector<int> &ids)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!patchable(db))
+    {
+        invalidateLocked();
+        return;
+    }
+    for (auto &[view, entry] : snapshots_)
+    {
+        if (entry.snapshot && entry.snapshot->table() == table)
+        {
+            for (int id : ids)
+            {
+                entry.pending.erase(id);
+            }
+            entry.snapshot->kill(ids);
+            stats_.rowsPatched += ids.size();
+        }
+    }
+}
+
+void InventorySnapshots::recordScan(double ms)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.scans;
+    stats_.lastScanMs = ms;
+}
+
+void InventorySnapshots::recordFallback()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.fallbacks;
+}
+
+SnapshotStats InventorySnapshots::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+SnapshotModel::SnapshotModel(std::shared_ptr<const InventorySnapshot> snapshot, std::vector<int> rows, QObject *parent)
+    : QAbstractTableModel(parent), snapshot_(std::move(snapshot)), rows_(std::move(rows))
+{
+}
+
+int SnapshotModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(rows_.size());
+}
+
+int SnapshotModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : snapshot_->columnCount();
+}
+
+QVariant SnapshotModel::data(const QModelIndex &index, int role) const
+{
+    if (role != Qt::DisplayRole || !index.isValid() || index.row() >= static_cast<int>(rows_.size()))
+    {
+        return QVariant();
+    }
+    return snapshot_->cell(rows_[static_cast<size_t>(index.row())], index.column());
+}
+
+QVariant SnapshotModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal || section < 0 || section >= snapshot_->headers().size())
+    {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    return snapshot_->headers()[section];
+}
+
+SnapshotModel *woodworks::infra::makeSnapshotModel(const QString &view, const QVector<FieldFilter> &filters, QObject *parent)
+{
+    auto &snapshots = InventorySnapshots::instance();
+    auto snapshot = snapshots.get(view);
+    if (!snapshot)
+    {
+        return nullptr;
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto rows = snapshot->match(filters);
+    if (!rows)
+    {
+        snapshots.recordFallback();
+        return nullptr;
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    snapshots.recordScan(ms);
+    WOODWORKS_LOG_DEBUG("snapshot", "filtered", {{"view", view}, {"rows", static_cast<int>(rows->size())}, {"of", snapshot->rowCount()}, {"ms", ms}});
+    return new SnapshotModel(std::move(snapshot), std::move(*rows), parent);
+}
@@ -0,0 +1,360 @@
+#include "infra/legacy_import.hpp"
+
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QVariant>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+#include "infra/dictionaries.hpp"
+#include "infra/entity_cache.hpp"
+#include "infra/inventory_snapshot.hpp"
+#include "infra/logging.hpp"
+#include "infra/name_table.hpp"
+#include "infra/unit_of_work.hpp"
+
+using namespace woodworks::infra;
+
+namespace
+{
+    /**
+     * How one legacy table maps onto the current schema. `select` lists one
+     * expression per `columns` entry, over the legacy row `s` and `joins`.
+     */
+    struct TableSpec
+    {
+        const char *source;
+        const char *target;
+        const char *columns;
+        const char *select;
+        const char *joins;
+        const char *filter;
+        const char *measure;       ///< Legacy expression checked against `targetMeasure`.
+        const char *targetMeasure; ///< Main dimension in the target, in ticks.
+        const char *blob;          ///< Legacy BLOB column checked against `image`, or NULL.
+    };
+
+    // Old drying codes share the current enum's order; lumber's column defaulted to the text 'Wet'
+#define LEGACY_DRYING "CASE WHEN s.drying BETWEEN 0 AND 3 THEN s.drying ELSE 0 END"
+    // What a slab or board's partial cut took from its log, split between the products it made
+    // Names are interned up front by internLegacyNames
+#define LEGACY_SPECIES "(SELECT id FROM main.species WHERE name = s.species)"
+#define LEGACY_LOCATION "(SELECT id FROM main.storage_bins WHERE name = s.location)"
+#define LEGACY_PARTIAL_WORTH "COALESCE(p.len_quarters * l.cost_cents_quarters / MAX(p.num_products_made, 1), 0)"
+
+    // Logs first, so a product's from_log refers to a log that is already there
+    const TableSpec TABLES[] = {
+        {"logs", "logs",
+         "id, species_id, length, diameter, quality, drying, cost, location_id, notes, image",
+         "s.id, " LEGACY_SPECIES ", (s.len_quarters - COALESCE(t.quarters, 0)) * 4, s.diameter_quarters * 4, "
+         "COALESCE(s.quality, -1), " LEGACY_DRYING ", (s.len_quarters - COALESCE(t.quarters, 0)) * s.cost_cents_quarters, "
+         LEGACY_LOCATION ", s.notes, s.media",
+         "LEFT JOIN temp.legacy_taken t ON t.from_log = s.id",
+         "s.scrapped = 0 AND s.len_quarters - COALESCE(t.quarters, 0) > 0",
+         "(s.len_quarters - COALESCE(t.quarters, 0)) * 4", "length", "s.media"},
+        {"cookies", "cookies",
+         "id, species_id, length, diameter, drying, worth, location_id, notes, image, from_log",
+         "s.id, " LEGACY_SPECIES ", s.thickness_quarters * 4, s.diameter_quarters * 4, " LEGACY_DRYING ", "
+         "s.thickness_quarters * COALESCE(l.cost_cents_quarters, 0), " LEGACY_LOCATION ", s.notes, s.media, s.from_log",
+         "LEFT JOIN legacy.logs l ON l.id = s.from_log",
+         "1",
+         "s.thickness_quarters * 4", "length", "s.media"},
+        {"slabs", "live_edge_slabs",
+         "id, species_id, length, width, thickness, drying, surfacing, worth, location_id, notes, image, from_log",
+         // A smoothed slab was flattened on both faces
+         "s.id, " LEGACY_SPECIES ", s.len_quarters * 4, s.width_eights * 2, s.thickness_eights * 2, " LEGACY_DRYING ", "
+         "CASE s.smoothed WHEN 1 THEN 2 ELSE 0 END, " LEGACY_PARTIAL_WORTH ", " LEGACY_LOCATION ", s.notes, s.media, s.from_log",
+         "LEFT JOIN legacy.partial_cuts p ON p.id = s.cut LEFT JOIN legacy.logs l ON l.id = s.from_log",
+         "1",
+         "s.len_quarters * 4", "length", "s.media"},
+        {"lumber", "lumber",
+         "id, species_id, length, width, thickness, drying, surfacing, worth, location_id, notes, image, from_log",
+         "s.id, " LEGACY_SPECIES ", s.len_inches * 16, s.width_quarters * 4, s.thickness_quarters * 4, " LEGACY_DRYING ", "
+         "CASE WHEN s.surfacing BETWEEN 0 AND 4 THEN s.surfacing ELSE 0 END, " LEGACY_PARTIAL_WORTH ", "
+         LEGACY_LOCATION ", s.notes, s.media, s.from_log",
+         "LEFT JOIN legacy.partial_cuts p ON p.id = s.cut LEFT JOIN legacy.logs l ON l.id = s.from_log",
+         "1",
+         "s.len_inches * 16", "length", "s.media"},
+        {"firewood", "firewood",
+         "id, species_id, cubicFeet, drying, cost, location_id, notes, image, from_log",
+         "s.id, " LEGACY_SPECIES ", s.feet_3, " LEGACY_DRYING ", s.taken_len_quarters * COALESCE(l.cost_cents_quarters, 0), "
+         LEGACY_LOCATION ", s.notes, s.media, s.from_log",
+         "LEFT JOIN legacy.logs l ON l.id = s.from_log",
+         "1",
+         "s.feet_3", "cubicFeet", "s.media"},
+        {"cutlist", "cutlist",
+         "id, project, part, code, quantity, t, w, l, species, progress_rough, progress_finished, notes, from_log",
+         "s.id, s.project, COALESCE(s.part, ''), COALESCE(s.code, ''), s.quantity, s.t * 2, s.w * 2, s.l * 2, "
+         "COALESCE(s.species, ''), COALESCE(s.progress_rough, 0), COALESCE(s.progress_finished, 0), s.notes, c.from_log",
+         "LEFT JOIN legacy.custom_cuts c ON c.id = s.cut",
+         "1",
+         "s.l * 2", "l", "NULL"},
+    };
+
+#undef LEGACY_DRYING
+#undef LEGACY_SPECIES
+#undef LEGACY_LOCATION
+#undef LEGACY_PARTIAL_WORTH
+
+    void run(QSqlDatabase &db, const QString &sql)
+    {
+        QSqlQuery q(db);
+        if (!q.exec(sql))
+        {
+            throw std::runtime_error("Legacy import statement failed: " + q.lastError().text().toStdString() + " in: " + sql.toStdString());
+        }
+    }
+
+    void execOrThrow(QSqlQuery &q)
+    {
+        if (!q.exec())
+        {
+            throw std::runtime_error("Legacy import statement failed: " + q.lastError().text().toStdString() + " in: " + q.lastQuery().toStdString());
+        }
+    }
+
+    // ATTACH and DETACH cannot run inside a transaction, so this wraps the whole import
+    class Attachment
+    {
+    public:
+        Attachment(QSqlDatabase &db, const QString &path) : db_(db)
+        {
+            QSqlQuery q(db_);
+            q.prepare("ATTACH DATABASE ? AS legacy");
+            q.addBindValue(path);
+            execOrThrow(q);
+            // Refuse anything that is not the old schema before touching the target
+            QSqlQuery probe(db_);
+            if (!probe.exec("SELECT 1 FROM legacy.sqlite_master WHERE type = 'table' AND name = 'logs' AND sql LIKE '%len_quarters%'") || !probe.next())
+            {
+                QSqlQuery(db_).exec("DETACH DATABASE legacy");
+                throw std::runtime_error("Not a legacy WoodWorks database: " + path.toStdString());
+            }
+        }
+        ~Attachment() { QSqlQuery(db_).exec("DETACH DATABASE legacy"); }
+
+        Attachment(const Attachment &) = delete;
+        Attachment &operator=(const Attachment &) = delete;
+
+    private:
+        QSqlDatabase &db_;
+    };
+
+    // Quarter inches cut from each log, computed once instead of per log; the old
+    // taken_len_all view used UNION, which dropped identical cuts from the same log
+    void buildTakenLengths(QSqlDatabase &db)
+    {
+        run(db, "CREATE TEMP TABLE IF NOT EXISTS legacy_taken (from_log INTEGER PRIMARY KEY, quarters INTEGER NOT NULL)");
+        run(db, "DELETE FROM temp.legacy_taken");
+        run(db, "INSERT INTO temp.legacy_taken (from_log, quarters) "
+                "SELECT from_log, SUM(quarters) FROM ("
+                "SELECT from_log, thickness_quarters AS quarters FROM legacy.cookies "
+                "UNION ALL SELECT from_log, len_quarters FROM legacy.custom_cuts "
+                "UNION ALL SELECT from_log, taken_len_quarters FROM legacy.firewood "
+                "UNION ALL SELECT from_log, len_quarters FROM legacy.partial_cuts"
+                ") WHERE from_log IS NOT NULL GROUP BY from_log");
+    }
+
+    // The inventory tables key species and locations, so every legacy name needs a key before rows are copied
+    void internLegacyNames(QSqlDatabase &db)
+    {
+        UnitOfWork uow(db);
+        for (const auto &spec : TABLES)
+        {
+            if (QString(spec.target) == "cutlist")
+            {
+                continue; // Cut lists keep species as text
+            }
+            run(db, QString("INSERT OR IGNORE INTO main.species (name) SELECT DISTINCT species FROM legacy.%1 WHERE species IS NOT NULL").arg(spec.source));
+            run(db, QString("INSERT OR IGNORE INTO main.storage_bins (name) SELECT DISTINCT location FROM legacy.%1 "
+                            "WHERE location IS NOT NULL AND location <> ''")
+                        .arg(spec.source));
+        }
+        uow.commit();
+    }
+
+    struct Progress
+    {
+        bool found{false};
+        qint64 lastId{0};
+        size_t copied{0};
+        size_t skipped{0};
+        bool done{false};
+    };
+
+    Progress readProgress(QSqlDatabase &db, const char *source)
+    {
+        QSqlQuery q(db);
+        q.prepare("SELECT last_id, copied, skipped, done FROM legacy_import_progress WHERE source = ?");
+        q.addBindValue(QString(source));
+        execOrThrow(q);
+        Progress progress;
+        if (q.next())
+        {
+            progress.found = true;
+            progress.lastId = q.value(0).toLongLong();
+            progress.copied = static_cast<size_t>(q.value(1).toLongLong());
+            progress.skipped = static_cast<size_t>(q.value(2).toLongLong());
+            progress.done = q.value(3).toBool();
+        }
+        return progress;
+    }
+
+    void writeProgress(QSqlDatabase &db, const char *source, const Progress &progress)
+    {
+        QSqlQuery q(db);
+        q.prepare("INSERT OR REPLACE INTO legacy_import_progress (source, last_id, copied, skipped, done) VALUES (?, ?, ?, ?, ?)");
+        q.addBindValue(QString(source));
+        q.addBindValue(progress.lastId);
+        q.addBindValue(static_cast<qint64>(progress.copied));
+        q.addBindValue(static_cast<qint64>(progress.skipped));
+        q.addBindValue(progress.done ? 1 : 0);
+        execOrThrow(q);
+    }
+
+    LegacyTableReport importTable(QSqlDatabase &db, const TableSpec &spec, const LegacyImportOptions &options)
+    {
+        LegacyTableReport report;
+        report.source = spec.source;
+        report.target = spec.target;
+
+        Progress progress = readProgress(db, spec.source);
+        report.resumed = progress.found;
+        if (!progress.found)
+        {
+            // Ids are kept, so rows from anywhere else would collide
+            QSqlQuery existing(db);
+            if (!existing.exec(QString("SELECT EXISTS (SELECT 1 FROM main.%1)").arg(spec.target)) || !existing.next())
+            {
+                throw std::runtime_error("Failed to inspect " + std::string(spec.target) + ": " + existing.lastError().text().toStdString());
+            }
+            if (existing.value(0).toBool())
+            {
+                throw std::runtime_error("Cannot import legacy " + std::string(spec.source) + ": " + spec.target + " already has rows");
+            }
+        }
+
+        QSqlQuery bound(db);
+        bound.prepare(QString("SELECT MAX(id), COUNT(*) FROM (SELECT id FROM legacy.%1 WHERE id > :last ORDER BY id LIMIT :limit)").arg(spec.source));
+        QSqlQuery copy(db);
+        copy.prepare(QString("INSERT INTO main.%1 (%2) SELECT %3 FROM legacy.%4 s %5 WHERE s.id > :last AND s.id <= :upper AND (%6)")
+                         .arg(spec.target, spec.columns, spec.select, spec.source, spec.joins, spec.filter));
+
+        while (!progress.done)
+        {
+            bound.bindValue(":last", progress.lastId);
+            bound.bindValue(":limit", static_cast<qint64>(options.batchSize));
+            execOrThrow(bound);
+            bound.next();
+            size_t inBatch = static_cast<size_t>(bound.value(1).toLongLong());
+            qint64 upper = bound.value(0).toLongLong();
+            bound.finish();
+
+            UnitOfWork uow(db);
+            if (inBatch == 0)
+            {
+                progress.done = true;
+            }
+            else
+            {
+                copy.bindValue(":last", progress.lastId);
+                copy.bindValue(":upper", upper);
+                execOrThrow(copy);
+                size_t copied = static_cast<size_t>(std::max(copy.numRowsAffected(), 0));
+                progress.copied += copied;
+                progress.skipped += inBatch - copied;
+                progress.lastId = upper;
+            }
+            // Committed with the batch, so a rerun never copies a row twice
+            writeProgress(db, spec.source, progress);
+            uow.commit();
+            ++report.batches;
+
+            if (options.progress && !progress.done)
+            {
+                options.progress(spec.target, progress.copied);
+            }
+        }
+
+        report.copied = progress.copied;
+        report.skipped = progress.skipped;
+        return report;
+    }
+}
+
+bool LegacyCheck::ok() const
+{
+    return expectedRows == actualRows && std::abs(expectedMeasure - actualMeasure) < 0.5 && expectedBlobBytes == actualBlobBytes;
+}
+
+std::vector<LegacyTableReport> LegacyImporter::run(QSqlDatabase &db, const QString &legacyPath, const LegacyImportOptions &options)
+{
+    if (options.batchSize == 0)
+    {
+        throw std::invalid_argument("Legacy import batch size must be positive");
+    }
+    auto start = std::chrono::steady_clock::now();
+    Attachment attachment(db, legacyPath);
+    buildTakenLengths(db);
+    internLegacyNames(db);
+
+    std::vector<LegacyTableReport> reports;
+    for (const auto &spec : TABLES)
+    {
+        reports.push_back(importTable(db, spec, options));
+        const auto &report = reports.back();
+        WOODWORKS_LOG_INFO("legacy", "table imported", {{"source", report.source}, {"target", report.target}, {"copied", report.copied}, {"skipped", report.skipped}, {"batches", report.batches}, {"resumed", report.resumed}});
+    }
+    // The copies bypassed the repositories
+    EntityCaches::clearAll();
+    NameTable::clearAll(db);
+    Dictionaries::of(db).invalidate();
+    InventorySnapshots::instance().invalidate();
+    WOODWORKS_LOG_INFO("legacy", "import finished", {{"path", legacyPath}, {"seconds", std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()}});
+    return reports;
+}
+
+std::vector<LegacyCheck> LegacyImporter::verify(QSqlDatabase &db, const QString &legacyPath)
+{
+    Attachment attachment(db, legacyPath);
+    buildTakenLengths(db);
+
+    std::vector<LegacyCheck> checks;
+    for (const auto &spec : TABLES)
+    {
+        // Rows the application added since have ids past the last imported one
+        Progress progress = readProgress(db, spec.source);
+        LegacyCheck check;
+        check.target = spec.target;
+
+        QSqlQuery expected(db);
+        expected.prepare(QString("SELECT COUNT(*), TOTAL(%1), TOTAL(LENGTH(%2)) FROM legacy.%3 s %4 WHERE s.id <= :last AND (%5)")
+                             .arg(spec.measure, spec.blob, spec.source, spec.joins, spec.filter));
+        expected.bindValue(":last", progress.lastId);
+        execOrThrow(expected);
+        expected.next();
+        check.expectedRows = expected.value(0).toLongLong();
+        check.expectedMeasure = expected.value(1).toDouble();
+        check.expectedBlobBytes = expected.value(2).toLongLong();
+
+        QSqlQuery actual(db);
+        actual.prepare(QString("SELECT COUNT(*), TOTAL(%1), TOTAL(LENGTH(image)) FROM main.%2 WHERE id <= :last")
+                           .arg(spec.targetMeasure, spec.target));
+        actual.bindValue(":last", progress.lastId);
+        execOrThrow(actual);
+        actual.next();
+        check.actualRows = actual.value(0).toLongLong();
+        check.actualMeasure = actual.value(1).toDouble();
+        check.actualBlobBytes = actual.value(2).toLongLong();
+
+        if (!check.ok())
+        {
+            WOODWORKS_LOG_WARN("legacy", "verification mismatch", {{"target", check.target}, {"expectedRows", check.expectedRows}, {"actualRows", check.actualRows}, {"expectedMeasure", check.expectedMeasure}, {"actualMeasure", check.actualMeasure}, {"expectedBlobBytes", check.expectedBlobBytes}, {"actualBlobBytes", check.actualBlobBytes}});
+        }
+        checks.push_back(check);
+    }
+    return checks;
+}
@@ -0,0 +1,278 @@
+#include "infra/logging.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+using namespace woodworks::infra::logging;
+
+namespace
+{
+    constexpr size_t BUFFER_CAPACITY = 16384;
+    // The drain thread also wakes on its own this often
+    constexpr std::chrono::milliseconds DRAIN_INTERVAL{50};
+
+    void printToStderr(const Record &record)
+    {
+        std::string line = Logger::format(record);
+        line += '\n';
+        std::fwrite(line.data(), 1, line.size(), stderr);
+    }
+}
+
+namespace woodworks::infra::logging
+{
+    const char *toString(Level level)
+    {
+        switch (level)
+        {
+        case Level::Trace:
+            return "TRACE";
+        case Level::Debug:
+            return "DEBUG";
+        case Level::Info:
+            return "INFO";
+        case Level::Warn:
+            return "WARN";
+        case Level::Error:
+            return "ERROR";
+        default:
+            return "OFF";
+        }
+    }
+
+    Level parseLevel(const std::string &name, Level fallback)
+    {
+        std::string lower = name;
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c)
+                       { return static_cast<char>(std::tolower(c)); });
+        for (Level level : {Level::Trace, Level::Debug, Level::Info, Level::Warn, Level::Error, Level::Off})
+        {
+            std::string candidate = toString(level);
+            std::transform(candidate.begin(), candidate.end(), candidate.begin(), [](unsigned char c)
+                           { return static_cast<char>(std::tolower(c)); });
+            if (lower == candidate)
+            {
+                return level;
+            }
+        }
+        return fallback;
+    }
+
+    // -------------- RingBuffer -------------- //
+
+    RingBuffer::RingBuffer(size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        slots_ = std::make_unique<Slot[]>(size);
+        mask_ = size - 1;
+        for (size_t i = 0; i < size; ++i)
+        {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool RingBuffer::push(Record &&record)
+    {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        Slot *slot;
+        while (true)
+        {
+            slot = &slots_[pos & mask_];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            if (sequence == pos)
+            {
+                // Free slot; claim it
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (sequence < pos)
+            {
+                // The consumer has not freed this slot yet, so the buffer is full
+                return false;
+            }
+            else
+            {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->record = std::move(record);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool RingBuffer::pop(Record &out)
+    {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        Slot &slot = slots_[pos & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+        {
+            return false;
+        }
+        out = std::move(slot.record);
+        slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        tail_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // -------------- Logger -------------- //
+
+    Logger &Logger::instance()
+    {
+        static Logger logger;
+        return logger;
+    }
+
+    Logger::Logger() : level_(Level::Info), buffer_(BUFFER_CAPACITY), sink_(printToStderr)
+    {
+        if (const char *env = std::getenv("WOODWORKS_LOG_LEVEL"))
+        {
+            level_.store(parseLevel(env, Level::Info), std::memory_order_relaxed);
+        }
+        thread_ = std::thread([this]()
+                              { drain(); });
+    }
+
+    Logger::~Logger()
+    {
+        stopping_.store(true);
+        wake_.notify_one();
+        thread_.join();
+    }
+
+    void Logger::write(Level level, const char *category, std::string message, std::initializer_list<Field> fields)
+    {
+        Record record;
+        record.level = level;
+        record.category = category;
+        record.message = std::move(message);
+        record.fields.assign(fields.begin(), fields.end());
+        record.time = std::chrono::system_clock::now();
+
+        if (!buffer_.push(std::move(record)))
+        {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            wake_.notify_one();
+            return;
+        }
+        size_t queued = queued_.fetch_add(1, std::memory_order_release) + 1;
+        // Errors go out promptly; otherwise only wake the drain thread once a backlog builds up
+        if (level >= Level::Error || queued - drained_.load(std::memory_order_relaxed) > buffer_.capacity() / 8)
+        {
+            wake_.notify_one();
+        }
+    }
+
+    void Logger::setSink(Sink sink)
+    {
+        flush();
+        std::lock_guard<std::mutex> lock(mutex_);
+        sink_ = sink ? std::move(sink) : Sink(printToStderr);
+    }
+
+    void Logger::flush()
+    {
+        size_t target = queued_.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.notify_one();
+        drainedSignal_.wait(lock, [&]()
+                            { return drained_.load() >= target; });
+    }
+
+    std::string Logger::format(const Record &record)
+    {
+        std::time_t seconds = std::chrono::system_clock::to_time_t(record.time);
+        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(record.time.time_since_epoch()).count() % 1000;
+        std::tm local{};
+#if defined(_WIN32)
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+        char stamp[32];
+        std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+
+        std::string line = stamp;
+        line += '.';
+        line += std::to_string(1000 + millis).substr(1);
+        line += ' ';
+        line += toString(record.level);
+        line += ' ';
+        line += record.category;
+        line += ": ";
+        line += record.message;
+        for (const auto &field : record.fields)
+        {
+            line += ' ';
+            line += field.key;
+            line += '=';
+            bool quote = field.value.empty() || field.value.find_first_of(" \"=") != std::string::npos;
+            if (quote)
+            {
+                line += '"';
+                for (char c : field.value)
+                {
+                    if (c == '"' || c == '\\')
+                    {
+                        line += '\\';
+                    }
+                    line += c;
+                }
+                line += '"';
+            }
+            else
+            {
+                line += field.value;
+            }
+        }
+        return line;
+    }
+
+    void Logger::drain()
+    {
+        Record record;
+        size_t reportedDrops = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            bool stopping = stopping_.load();
+            size_t count = 0;
+            while (buffer_.pop(record))
+            {
+                sink_(record);
+                ++count;
+            }
+            size_t drops = dropped_.load(std::memory_order_relaxed);
+            if (drops != reportedDrops)
+            {
+                Record notice;
+                notice.level = Level::Warn;
+                notice.category = "logging";
+                notice.message = "records dropped, buffer full";
+                notice.fields.emplace_back("count", drops - reportedDrops);
+                notice.time = std::chrono::system_clock::now();
+                sink_(notice);
+                reportedDrops = drops;
+            }
+            if (count > 0)
+            {
+                std::fflush(stderr);
+                drained_.fetch_add(count);
+            }
+            drainedSignal_.notify_all();
+            if (stopping)
+            {
+                return;
+            }
+            wake_.wait_for(lock, DRAIN_INTERVAL);
+        }
+    }
+}
@@ -0,0 +1,489 @@
+#include "infra/migrations.hpp"
+
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QVariant>
+
+#include <chrono>
+#include <stdexcept>
+
+#include "infra/logging.hpp"
+#include "infra/unit_of_work.hpp"
+#include "infra/mappers/log_mapper.hpp"
+#include "infra/mappers/cookie_mapper.hpp"
+#include "infra/mappers/live_edge_slab_mapper.hpp"
+#include "infra/mappers/lumber_mapper.hpp"
+#include "infra/mappers/firewood_mapper.hpp"
+#include "infra/mappers/cutlist_mapper.hpp"
+
+using namespace woodworks::infra;
+using namespace woodworks::domain;
+
+namespace
+{
+    void run(QSqlDatabase &db, const QString &sql)
+    {
+        QSqlQuery q(db);
+        if (!q.exec(sql))
+        {
+            throw std::runtime_error("Migration statement failed: " + q.lastError().text().toStdString() + " in: " + sql.toStdString());
+        }
+    }
+
+    // Shipped migrations must not change, so versions 1 and 2 keep the schema as it was then rather than read the mappers
+    const char *const V1_TABLES[] = {
+        "CREATE TABLE IF NOT EXISTS logs ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+            "species TEXT NOT NULL, "
+            "length REAL NOT NULL, "
+            "diameter REAL NOT NULL, "
+            "quality INTEGER NOT NULL, "
+            "drying INTEGER NOT NULL, "
+            "cost INTEGER NOT NULL, "
+            "location TEXT, "
+            "notes TEXT, "
+            "image BLOB"
+            ")",
+        "CREATE TABLE IF NOT EXISTS cookies ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+            "species TEXT NOT NULL, "
+            "length REAL NOT NULL, "
+            "diameter REAL NOT NULL, "
+            "drying INTEGER NOT NULL, "
+            "worth INTEGER NOT NULL, "
+            "location TEXT, "
+            "notes TEXT, "
+            "image BLOB"
+            ")",
+        "CREATE TABLE IF NOT EXISTS live_edge_slabs ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+            "species TEXT NOT NULL, "
+            "length REAL NOT NULL, "
+            "width REAL NOT NULL, "
+            "thickness REAL NOT NULL, "
+            "drying INTEGER NOT NULL, "
+            "surfacing INTEGER NOT NULL, "
+            "worth INTEGER NOT NULL, "
+            "location TEXT, "
+            "notes TEXT, "
+            "image BLOB"
+            ")",
+        "CREATE TABLE IF NOT EXISTS lumber ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+            "species TEXT NOT NULL, "
+            "length REAL NOT NULL, "
+            "width REAL NOT NULL, "
+            "thickness REAL NOT NULL, "
+            "drying INTEGER NOT NULL, "
+            "surfacing INTEGER NOT NULL, "
+            "worth INTEGER NOT NULL, "
+            "location TEXT, "
+            "notes TEXT, "
+            "image BLOB"
+            ")",
+        "CREATE TABLE IF NOT EXISTS firewood ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+            "species TEXT NOT NULL, "
+            "cubicFeet REAL NOT NULL, "
+            "drying INTEGER NOT NULL, "
+            "cost INTEGER NOT NULL, "
+            "location TEXT, "
+            "notes TEXT, "
+            "image BLOB"
+            ")",
+        "CREATE TABLE IF NOT EXISTS cutlist ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+            "project TEXT NOT NULL, "
+            "part TEXT NOT NULL, "
+            "code TEXT NOT NULL, "
+            "quantity INTEGER NOT NULL, "
+            "t INTEGER NOT NULL, "
+            "w INTEGER NOT NULL, "
+            "l INTEGER NOT NULL, "
+            "species TEXT NOT NULL, "
+            "progress_rough INTEGER NOT NULL, "
+            "progress_finished INTEGER NOT NULL, "
+            "notes TEXT, "
+            "image BLOB"
+            ")",
+    };
+
+    const char *const V2_VIEWS[] = {
+        "CREATE VIEW IF NOT EXISTS display_logs AS SELECT "
+            "id AS 'ID', "
+            "species AS 'Species', "
+            "ROUND(length/192.0,2) AS 'Length (ft)', "
+            "ROUND(diameter/16.0,2) AS 'Diameter (in)', "
+            "quality AS 'Quality', "
+            "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying', "
+            "printf('%.2f',cost/100.0) AS 'Cost ($)', "
+            "location AS 'Location', "
+            "notes AS 'Notes'"
+            " FROM logs",
+        "CREATE VIEW IF NOT EXISTS display_logs_grouped AS SELECT "
+            "COUNT(*) AS 'Count', "
+            "species AS 'Species', "
+            "ROUND(length/192.0,2) AS 'Length (ft)', "
+            "ROUND(diameter/16.0,2) AS 'Diameter (in)', "
+            "quality AS 'Quality', "
+            "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying', "
+            "ROUND(AVG(cost)/100.0,2) AS 'Avg Cost ($)'"
+            " FROM logs GROUP BY species, ROUND(length/192.0,2), ROUND(diameter/16.0,2), quality, drying",
+        "CREATE VIEW IF NOT EXISTS display_cookies AS SELECT "
+            "id AS 'ID', "
+            "species AS 'Species', "
+            "ROUND(length/16.0,2) AS 'Thickness (in)', "
+            "ROUND(diameter/16.0,2) AS 'Diameter (in)', "
+            "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying', "
+            "printf('%.2f',worth/100.0) AS 'Worth ($)', "
+            "location AS 'Location', "
+            "notes AS 'Notes'"
+            " FROM cookies",
+        "CREATE VIEW IF NOT EXISTS display_cookies_grouped AS SELECT "
+            "COUNT(*) AS 'Count', "
+            "species AS 'Species', "
+            "ROUND(length/16.0,2) AS 'Thickness (in)', "
+            "ROUND(diameter/16.0,2) AS 'Diameter (in)', "
+            "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying', "
+            "ROUND(AVG(worth)/100.0,2) AS 'Avg Worth ($)'"
+            " FROM cookies GROUP BY species, ROUND(length/16.0,2), ROUND(diameter/16.0,2), drying",
+        "CREATE VIEW IF NOT EXISTS display_slabs AS SELECT "
+            "id AS 'ID', "
+            "species AS 'Species', "
+            "ROUND(length/16.0,2) AS 'Length (in)', "
+            "ROUND(width/16.0,2) AS 'Width (in)', "
+            "ROUND(thickness/16.0,2) AS 'Thickness (in)', "
+            "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying', "
+            "CASE surfacing WHEN 0 THEN 'RGH' WHEN 1 THEN 'S1S' WHEN 2 THEN 'S2S' END AS 'Surfacing', "
+            "printf('%.2f',worth/100.0) AS 'Worth ($)', "
+            "location AS 'Location', "
+            "notes AS 'Notes'"
+            " FROM live_edge_slabs",
+        "CREATE VIEW IF NOT EXISTS display_slabs_grouped AS SELECT "
+            "COUNT(*) AS 'Count', "
+            "species AS 'Species', "
+            "ROUND(length/16.0,2) AS 'Length (in)', "
+            "ROUND(width/16.0,2) AS 'Width (in)', "
+            "ROUND(thickness/16.0,2) AS 'Thickness (in)', "
+            "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying', "
+            "CASE surfacing WHEN 0 THEN 'RGH' WHEN 1 THEN 'S1S' WHEN 2 THEN 'S2S' END AS 'Surfacing', "
+            "ROUND(AVG(worth)/100.0,2) AS 'Avg Worth ($)'"
+            " FROM live_edge_slabs GROUP BY species, ROUND(length/16.0,2), ROUND(width/16.0,2), ROUND(thickness/16.0,2), drying, surfacing",
+        "CREATE VIEW IF NOT EXISTS display_lumber AS SELECT "
+            "id AS 'ID', "
+            "species AS 'Species', "
+            "ROUND(length/16.0) AS 'Length (in)', "
+            "printf('%d/4', thickness/4) AS 'Thickness', "
+            "ROUND(width/16.0) AS 'Width (in)', "
+            "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying', "
+            "CASE surfacing WHEN 0 THEN 'RGH' WHEN 1 THEN 'S1S' WHEN 2 THEN 'S2S' WHEN 3 THEN 'S3S' WHEN 4 THEN 'S4S' END AS 'Surfacing', "
+            "printf('%.2f',worth/100.0) AS 'Cost ($)', "
+            "location AS 'Location', "
+            "notes AS 'Notes'"
+            " FROM lumber",
+        "CREATE VIEW IF NOT EXISTS display_lumber_grouped AS SELECT "
+            "COUNT(*) AS 'Count', "
+            "species AS 'Species', "
+            "ROUND(length/16.0) AS 'Length (in)', "
+            "printf('%d/4', thickness/4) AS 'Thickness', "
+            "ROUND(width/16.0) AS 'Width (in)', "
+            "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying', "
+            "CASE surfacing WHEN 0 THEN 'RGH' WHEN 1 THEN 'S1S' WHEN 2 THEN 'S2S' WHEN 3 THEN 'S3S' WHEN 4 THEN 'S4S' END AS 'Surfacing', "
+            "ROUND(AVG(worth)/100.0,2) AS 'Avg Cost ($)'"
+            " FROM lumber GROUP BY species, ROUND(length/16.0), printf('%d/4', thickness/4), ROUND(width/16.0), drying, surfacing",
+        "CREATE VIEW IF NOT EXISTS display_firewood AS SELECT "
+            "id AS 'ID', "
+            "species AS 'Species', "
+            "ROUND(cubicFeet,2) AS 'Cubic Feet', "
+            "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying', "
+            "ROUND(cost/100.0,2) AS 'Cost ($)', "
+            "location AS 'Location', "
+            "notes AS 'Notes'"
+            " FROM firewood",
+        "CREATE VIEW IF NOT EXISTS display_firewood_grouped AS SELECT "
+            "id AS 'ID', "
+            "species AS 'Species', "
+            "location AS 'Location', "
+            "CASE drying WHEN 0 THEN 'Green' WHEN 1 THEN 'Kiln Dried' WHEN 2 THEN 'Air Dried' WHEN 3 THEN 'Kiln & Air Dried' END AS 'Drying', "
+            "ROUND(sum(cubicFeet),2) AS 'Cubic Feet', "
+            "ROUND(sum(cubicFeet)/128.0,2) AS 'Chords', "
+            "ROUND(SUM(cost)/100.0,2) AS 'Cost ($)'"
+            " FROM firewood GROUP BY species, drying, location",
+        "CREATE VIEW IF NOT EXISTS cutlist_individual AS SELECT "
+            "*"
+            " FROM cutlist",
+        "CREATE VIEW IF NOT EXISTS cutlist_grouped AS SELECT "
+            "*"
+            " FROM cutlist",
+    };
+
+    template <typename T>
+    void createViews(QSqlDatabase &db)
+    {
+        run(db, T::individualViewSQL());
+        run(db, T::groupedViewSQL());
+    }
+
+    void dropViews(QSqlDatabase &db)
+    {
+        QStringList views;
+        {
+            QSqlQuery q(db);
+            if (!q.exec("SELECT name FROM sqlite_master WHERE type = 'view'"))
+            {
+                throw std::runtime_error("Failed to list views: " + q.lastError().text().toStdString());
+            }
+            while (q.next())
+            {
+                views << q.value(0).toString();
+            }
+        }
+        for (const QString &view : views)
+        {
+            run(db, QString("DROP VIEW IF EXISTS \"%1\"").arg(view));
+        }
+    }
+
+    /**
+     * Views hold no data, so any change to a mapper's view SQL is applied by
+     * dropping and recreating them all. Only the newest migration that
+     * rebuilds views may call this; once a later one ships, copy the SQL it
+     * produced into that migration as fixed text, as V2_VIEWS was.
+     */
+    void rebuildViews(QSqlDatabase &db)
+    {
+        dropViews(db);
+        createViews<Log>(db);
+        createViews<Cookie>(db);
+        createViews<LiveEdgeSlab>(db);
+        createViews<Lumber>(db);
+        createViews<Firewood>(db);
+        createViews<CustomCut>(db);
+    }
+
+    /**
+     * Rebuilds an inventory table with species and location as keys into the
+     * species and storage_bins tables. SQLite cannot change a column's type in
+     * place, so the table is copied column by column into a new one, keeping
+     * ids and the AUTOINCREMENT counter.
+     */
+    void internNames(QSqlDatabase &db, const QString &table)
+    {
+        QStringList definitions, columns, values;
+        {
+            QSqlQuery q(db);
+            if (!q.exec(QString("PRAGMA table_info(%1)").arg(table)))
+            {
+                throw std::runtime_error("Failed to read columns of " + table.toStdString() + ": " + q.lastError().text().toStdString());
+            }
+            while (q.next())
+            {
+                QString name = q.value(1).toString();
+                if (name == "id")
+                {
+                    definitions << "id INTEGER PRIMARY KEY AUTOINCREMENT";
+                    columns << name;
+                    values << name;
+                }
+                else if (name == "species")
+                {
+                    definitions << "species_id INTEGER NOT NULL REFERENCES species (id)";
+                    columns << "species_id";
+                    values << QString("(SELECT id FROM species WHERE name = %1.species)").arg(table);
+                }
+                else if (name == "location")
+                {
+                    definitions << "location_id INTEGER REFERENCES storage_bins (id)";
+                    columns << "location_id";
+                    values << QString("(SELECT id FROM storage_bins WHERE name = %1.location)").arg(table);
+                }
+                else
+                {
+                    QString definition = name + " " + q.value(2).toString();
+                    if (q.value(3).toBool())
+                    {
+                        definition += " NOT NULL";
+                    }
+                    if (!q.value(4).isNull())
+                    {
+                        definition += " DEFAULT " + q.value(4).toString();
+                    }
+                    definitions << definition;
+                    columns << name;
+                    values << name;
+                }
+            }
+        }
+
+        QVariant sequence;
+        {
+            QSqlQuery q(db);
+            if (q.exec(QString("SELECT seq FROM sqlite_sequence WHERE name = '%1'").arg(table)) && q.next())
+            {
+                sequence = q.value(0);
+            }
+        }
+
+        const QString rebuilt = table + "_interned";
+        run(db, QString("CREATE TABLE %1 (%2)").arg(rebuilt, definitions.join(", ")));
+        run(db, QString("INSERT INTO %1 (%2) SELECT %3 FROM %4").arg(rebuilt, columns.join(", "), values.join(", "), table));
+        run(db, QString("DROP TABLE %1").arg(table));
+        run(db, QString("ALTER TABLE %1 RENAME TO %2").arg(rebuilt, table));
+        if (sequence.isValid())
+        {
+            run(db, QString("UPDATE sqlite_sequence SET seq = MAX(seq, %1) WHERE name = '%2'").arg(sequence.toLongLong()).arg(table));
+        }
+    }
+}
+
+const std::vector<Migration> &SchemaMigrator::migrations()
+{
+    static const std::vector<Migration> list = {
+        {1, "Create inventory tables and migration history", [](QSqlDatabase &db)
+         {
+             run(db, "CREATE TABLE IF NOT EXISTS schema_migrations ("
+                     "version INTEGER PRIMARY KEY, "
+                     "description TEXT NOT NULL, "
+                     "applied_at TEXT NOT NULL DEFAULT CURRENT_TIMESTAMP)");
+             // IF NOT EXISTS, since databases from before versioning already have these
+             for (const char *table : V1_TABLES)
+             {
+                 run(db, table);
+             }
+         }},
+        {2, "Rebuild display views", [](QSqlDatabase &db)
+         {
+             dropViews(db);
+             for (const char *view : V2_VIEWS)
+             {
+                 run(db, view);
+             }
+         }},
+        {3, "Add log lineage and legacy import progress", [](QSqlDatabase &db)
+         {
+             // No foreign key: lineage outlives the log, which is deleted once fully cut
+             for (const char *table : {"cookies", "live_edge_slabs", "lumber", "firewood", "cutlist"})
+             {
+                 run(db, QString("ALTER TABLE %1 ADD COLUMN from_log INTEGER").arg(table));
+             }
+             run(db, "CREATE TABLE legacy_import_progress ("
+                     "source TEXT PRIMARY KEY, "
+                     "last_id INTEGER NOT NULL, "
+                     "copied INTEGER NOT NULL, "
+                     "skipped INTEGER NOT NULL, "
+                     "done INTEGER NOT NULL)");
+         }},
+        {4, "Add inventory filter indexes", [](QSqlDatabase &db)
+         {
+             // Leading on species, since the filter bar almost always narrows by it first
+             run(db, "CREATE INDEX IF NOT EXISTS idx_logs_species_length ON logs (species, length)");
+             run(db, "CREATE INDEX IF NOT EXISTS idx_logs_diameter ON logs (diameter)");
+             run(db, "CREATE INDEX IF NOT EXISTS idx_cookies_species_length ON cookies (species, length)");
+             run(db, "CREATE INDEX IF NOT EXISTS idx_cookies_diameter ON cookies (diameter)");
+             run(db, "CREATE INDEX IF NOT EXISTS idx_slabs_species_length ON live_edge_slabs (species, length)");
+             run(db, "CREATE INDEX IF NOT EXISTS idx_slabs_width ON live_edge_slabs (width)");
+             run(db, "CREATE INDEX IF NOT EXISTS idx_slabs_thickness ON live_edge_slabs (thickness)");
+             run(db, "CREATE INDEX IF NOT EXISTS idx_lumber_species_length ON lumber (species, length)");
+             run(db, "CREATE INDEX IF NOT EXISTS idx_lumber_width ON lumber (width)");
+             run(db, "CREATE INDEX IF NOT EXISTS idx_lumber_thickness ON lumber (thickness)");
+             run(db, "CREATE INDEX IF NOT EXISTS idx_firewood_species_drying ON firewood (species, drying)");
+         }},
+        {5, "Intern species and storage locations", [](QSqlDatabase &db)
+         {
+             run(db, "CREATE TABLE species (id INTEGER PRIMARY KEY, name TEXT NOT NULL UNIQUE)");
+             run(db, "CREATE TABLE storage_bins (id INTEGER PRIMARY KEY, name TEXT NOT NULL UNIQUE)");
+             const QStringList tables{"logs", "cookies", "live_edge_slabs", "lumber", "firewood"};
+             for (const QString &table : tables)
+             {
+                 run(db, QString("INSERT OR IGNORE INTO species (name) SELECT DISTINCT species FROM %1").arg(table));
+                 run(db, QString("INSERT OR IGNORE INTO storage_bins (name) SELECT DISTINCT location FROM %1 "
+                                 "WHERE location IS NOT NULL AND location <> ''")
+                             .arg(table));
+             }
+             // A rename rechecks every view, and the old ones name the dropped columns
+             dropViews(db);
+             for (const QString &table : tables)
+             {
+                 internNames(db, table);
+             }
+             // The migration 4 indexes went with the old tables
+             run(db, "CREATE INDEX idx_logs_species_length ON logs (species_id, length)");
+             run(db, "CREATE INDEX idx_logs_diameter ON logs (diameter)");
+             run(db, "CREATE INDEX idx_cookies_species_length ON cookies (species_id, length)");
+             run(db, "CREATE INDEX idx_cookies_diameter ON cookies (diameter)");
+             run(db, "CREATE INDEX idx_slabs_species_length ON live_edge_slabs (species_id, length)");
+             run(db, "CREATE INDEX idx_slabs_width ON live_edge_slabs (width)");
+             run(db, "CREATE INDEX idx_slabs_thickness ON live_edge_slabs (thickness)");
+             run(db, "CREATE INDEX idx_lumber_species_length ON lumber (species_id, length)");
+             run(db, "CREATE INDEX idx_lumber_width ON lumber (width)");
+             run(db, "CREATE INDEX idx_lumber_thickness ON lumber (thickness)");
+             run(db, "CREATE INDEX idx_firewood_species_drying ON firewood (species_id, drying)");
+             rebuildViews(db);
+         }},
+    };
+    return list;
+}
+
+int SchemaMigrator::latestVersion()
+{
+    return migrations().empty() ? 0 : migrations().back().version;
+}
+
+int SchemaMigrator::currentVersion(QSqlDatabase &db)
+{
+    QSqlQuery q(db);
+    if (!q.exec("PRAGMA user_version") || !q.next())
+    {
+        throw std::runtime_error("Failed to read schema version: " + q.lastError().text().toStdString());
+    }
+    return q.value(0).toInt();
+}
+
+MigrationReport SchemaMigrator::migrate(QSqlDatabase &db)
+{
+    return migrate(db, latestVersion());
+}
+
+MigrationReport SchemaMigrator::migrate(QSqlDatabase &db, int targetVersion)
+{
+    auto start = std::chrono::steady_clock::now();
+    MigrationReport report;
+    report.fromVersion = report.toVersion = currentVersion(db);
+    if (report.fromVersion > latestVersion())
+    {
+        throw std::runtime_error("Database schema version " + std::to_string(report.fromVersion) +
+                                 " is newer than this build supports (" + std::to_string(latestVersion()) + ")");
+    }
+
+    for (const auto &migration : migrations())
+    {
+        if (migration.version <= report.toVersion)
+        {
+            continue;
+        }
+        if (migration.version > targetVersion)
+        {
+            break;
+        }
+        WOODWORKS_LOG_INFO("schema", "migrating", {{"version", migration.version}, {"description", migration.description}});
+        UnitOfWork uow(db);
+        migration.apply(db);
+        QSqlQuery history(db);
+        history.prepare("INSERT OR REPLACE INTO schema_migrations (version, description) VALUES (?, ?)");
+        history.addBindValue(migration.version);
+        history.addBindValue(QString(migration.description));
+        if (!history.exec())
+        {
+            throw std::runtime_error("Failed to record migration: " + history.lastError().text().toStdString());
+        }
+        // user_version is part of the transaction, so a failed migration leaves it unchanged
+        run(db, QString("PRAGMA user_version = %1").arg(migration.version));
+        uow.commit();
+        report.toVersion = migration.version;
+        ++report.applied;
+    }
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
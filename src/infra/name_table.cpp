@@ -0,0 +1,162 @@
+#include "infra/name_table.hpp"
+
+#include <QSqlError>
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+
+#include "infra/connection.hpp"
+#include "infra/sql_trace.hpp"
+
+using namespace woodworks::infra;
+
+namespace
+{
+    thread_local QSqlDatabase *scoped = nullptr;
+
+    std::mutex registryMutex;
+    std::map<QString, std::unique_ptr<NameTable>> &registry()
+    {
+        static std::map<QString, std::unique_ptr<NameTable>> tables;
+        return tables;
+    }
+
+    // A connection name can be reopened on another file, whose keys differ
+    QString connectionKey(const QSqlDatabase &db)
+    {
+        return db.connectionName() + '\n' + db.databaseName();
+    }
+}
+
+NameTable::Scope::Scope(QSqlDatabase &db) : previous_(scoped)
+{
+    scoped = &db;
+}
+
+NameTable::Scope::~Scope()
+{
+    scoped = previous_;
+}
+
+NameTable &NameTable::of(const QString &table, const QSqlDatabase &db)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto &slot = registry()[table + '\n' + connectionKey(db)];
+    if (!slot)
+    {
+        slot.reset(new NameTable(table, db.connectionName()));
+    }
+    return *slot;
+}
+
+QSqlDatabase &NameTable::current()
+{
+    return scoped ? *scoped : DbConnection::instance();
+}
+
+NameTable &NameTable::species(const QSqlDatabase &db)
+{
+    return of("species", db);
+}
+
+NameTable &NameTable::locations(const QSqlDatabase &db)
+{
+    return of("storage_bins", db);
+}
+
+NameTable &NameTable::species()
+{
+    return species(current());
+}
+
+NameTable &NameTable::locations()
+{
+    return locations(current());
+}
+
+void NameTable::clearAll(const QSqlDatabase &db)
+{
+    species(db).clear();
+    locations(db).clear();
+}
+
+void NameTable::clearAll()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto &[key, table] : registry())
+    {
+        table->clear();
+    }
+}
+
+int NameTable::intern(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    loadLocked();
+    auto it = ids_.find(name);
+    if (it != ids_.end())
+    {
+        return it->second;
+    }
+    TracedQuery q(QSqlDatabase::database(connection_, false));
+    q.prepare(QString("INSERT INTO %1 (name) VALUES (?)").arg(table_));
+    q.bindValue(0, QString::fromStdString(name));
+    if (!q.exec())
+    {
+        throw std::runtime_error("Failed to add " + name + " to " + table_.toStdString() + ": " + q.lastError().text().toStdString());
+    }
+    int id = q.lastInsertId().toInt();
+    ids_.emplace(name, id);
+    names_.emplace(id, name);
+    return id;
+}
+
+std::optional<int> NameTable::find(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    loadLocked();
+    auto it = ids_.find(name);
+    if (it == ids_.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::string NameTable::name(int id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    loadLocked();
+    auto it = names_.find(id);
+    return it == names_.end() ? std::string() : it->second;
+}
+
+void NameTable::loadLocked()
+{
+    if (loaded_)
+    {
+        return;
+    }
+    TracedQuery q(QSqlDatabase::database(connection_, false));
+    if (!q.exec(QString("SELECT id, name FROM %1").arg(table_)))
+    {
+        throw std::runtime_error("Failed to read " + table_.toStdString() + ": " + q.lastError().text().toStdString());
+    }
+    while (q.next())
+    {
+        int id = q.value(0).toInt();
+        std::string name = q.value(1).toString().toStdString();
+        ids_.emplace(name, id);
+        names_.emplace(id, std::move(name));
+    }
+    loaded_ = true;
+}
+
+void NameTable::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    loaded_ = false;
+    ids_.clear();
+    names_.clear();
+}
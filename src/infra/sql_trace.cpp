@@ -0,0 +1,572 @@
+#include "infra/sql_trace.hpp"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QSqlRecord>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include "infra/logging.hpp"
+
+using namespace woodworks::infra;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    int64_t nanosSince(Clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    }
+
+    size_t bucketFor(int64_t nanos)
+    {
+        size_t bucket = 0;
+        for (int64_t micros = nanos / 1000; micros > 0 && bucket + 1 < StatementStats::HISTOGRAM_BUCKETS; micros >>= 1)
+        {
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    bool isIdentifierChar(char c)
+    {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    }
+
+    double toMillis(int64_t nanos)
+    {
+        return static_cast<double>(nanos) / 1e6;
+    }
+}
+
+namespace woodworks::infra
+{
+    QString normalizeSql(const QString &sql)
+    {
+        const std::string text = sql.toStdString();
+        std::string out;
+        out.reserve(text.size());
+        for (size_t i = 0; i < text.size();)
+        {
+            char c = text[i];
+            if (std::isspace(static_cast<unsigned char>(c)))
+            {
+                while (i < text.size() && std::isspace(static_cast<unsigned char>(text[i])))
+                {
+                    ++i;
+                }
+                if (!out.empty() && i < text.size())
+                {
+                    out += ' ';
+                }
+            }
+            else if (c == '\'')
+            {
+                // String literal, with '' as an escaped quote
+                for (++i; i < text.size(); ++i)
+                {
+                    if (text[i] == '\'')
+                    {
+                        if (i + 1 < text.size() && text[i + 1] == '\'')
+                        {
+                            ++i;
+                            continue;
+                        }
+                        ++i;
+                        break;
+                    }
+                }
+                out += '?';
+            }
+            else if (c == '"' || c == '`' || c == '[')
+            {
+                // Quoted identifier, kept as is
+                char close = c == '[' ? ']' : c;
+                size_t end = text.find(close, i + 1);
+                end = end == std::string::npos ? text.size() : end + 1;
+                out.append(text, i, end - i);
+                i = end;
+            }
+            else if (std::isdigit(static_cast<unsigned char>(c)) && (out.empty() || !isIdentifierChar(out.back())))
+            {
+                // Numeric literal, including a leading minus sign
+                while (i < text.size() && (std::isalnum(static_cast<unsigned char>(text[i])) || text[i] == '.'))
+                {
+                    ++i;
+                }
+                if (out.size() >= 2 && out.back() == '-' && !isIdentifierChar(out[out.size() - 2]) && out[out.size() - 2] != ')')
+                {
+                    out.pop_back();
+                }
+                out += '?';
+            }
+            else
+            {
+                out += c;
+                ++i;
+            }
+        }
+
+        // Lists of placeholders, like IN (?, ?, ?), collapse to one
+        std::string collapsed;
+        collapsed.reserve(out.size());
+        for (size_t i = 0; i < out.size(); ++i)
+        {
+            collapsed += out[i];
+            if (out[i] == '?')
+            {
+                size_t j = i + 1;
+                while (true)
+                {
+                    size_t k = j;
+                    while (k < out.size() && out[k] == ' ')
+                    {
+                        ++k;
+                    }
+                    if (k >= out.size() || out[k] != ',')
+                    {
+                        break;
+                    }
+                    ++k;
+                    while (k < out.size() && out[k] == ' ')
+                    {
+                        ++k;
+                    }
+                    if (k >= out.size() || out[k] != '?')
+                    {
+                        break;
+                    }
+                    j = k + 1;
+                }
+                if (j != i + 1 && collapsed.size() >= 2 && collapsed[collapsed.size() - 2] == '(')
+                {
+                    i = j - 1;
+                }
+            }
+        }
+        return QString::fromStdString(collapsed);
+    }
+
+    double StatementStats::percentileMicros(double fraction) const
+    {
+        if (count == 0)
+        {
+            return 0.0;
+        }
+        auto target = static_cast<size_t>(std::ceil(fraction * static_cast<double>(count)));
+        size_t seen = 0;
+        for (size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket)
+        {
+            seen += histogram[bucket];
+            if (seen >= std::max<size_t>(target, 1))
+            {
+                return static_cast<double>(1ull << bucket);
+            }
+        }
+        return static_cast<double>(1ull << (HISTOGRAM_BUCKETS - 1));
+    }
+
+    // -------------- SqlTracer -------------- //
+
+    struct SqlTracer::Invocation
+    {
+        int depth{0};
+        bool active{false};
+        QString action;
+        std::map<QString, size_t> counts;
+        size_t queries{0};
+        int64_t nanos{0};
+    };
+
+    thread_local SqlTracer::Invocation SqlTracer::current_;
+
+    SqlTracer &SqlTracer::instance()
+    {
+        static SqlTracer tracer;
+        return tracer;
+    }
+
+    SqlTracer::SqlTracer()
+    {
+        if (const char *env = std::getenv("WOODWORKS_SQL_TRACE"))
+        {
+            enabled_.store(std::string(env) != "0" && std::string(env) != "", std::memory_order_relaxed);
+        }
+        if (const char *env = std::getenv("WOODWORKS_SQL_SLOW_MS"))
+        {
+            slowThreshold_.store(static_cast<int64_t>(std::atof(env) * 1000.0), std::memory_order_relaxed);
+        }
+        if (const char *env = std::getenv("WOODWORKS_SQL_N_PLUS_ONE"))
+        {
+            nPlusOneThreshold_.store(std::max<size_t>(std::strtoul(env, nullptr, 10), 2), std::memory_order_relaxed);
+        }
+    }
+
+    void SqlTracer::record(const QString &sql, int64_t prepareNanos, int64_t execNanos, size_t rows, bool ok,
+                           const std::function<QString()> &explainPlan)
+    {
+        QString key = normalizeSql(sql);
+        if (current_.active)
+        {
+            ++current_.counts[key];
+            ++current_.queries;
+            current_.nanos += prepareNanos + execNanos;
+        }
+        bool slow = execNanos > slowThreshold_.load(std::memory_order_relaxed) * 1000;
+        bool slowest = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            StatementStats &stats = stats_[key];
+            if (stats.count == 0)
+            {
+                stats.statement = key;
+            }
+            ++stats.count;
+            stats.errors += ok ? 0 : 1;
+            stats.rows += rows;
+            stats.prepareNanos += prepareNanos;
+            stats.execNanos += execNanos;
+            ++stats.histogram[bucketFor(execNanos)];
+            if (execNanos > stats.maxExecNanos)
+            {
+                stats.maxExecNanos = execNanos;
+                stats.slowestText = sql;
+                slowest = true;
+            }
+        }
+        if (!slow)
+        {
+            return;
+        }
+
+        // Explain outside the lock; only the slowest run of a statement keeps its plan
+        QString plan = slowest && explainPlan ? explainPlan() : QString();
+        if (!plan.isEmpty())
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = stats_.find(key);
+            if (it != stats_.end() && it->second.maxExecNanos == execNanos)
+            {
+                it->second.plan = plan;
+            }
+        }
+        WOODWORKS_LOG_WARN("sql", "slow query", {{"ms", toMillis(execNanos)}, {"rows", rows}, {"sql", key}, {"action", current_.action}, {"plan", QString(plan).replace(QChar('\n'), QString("; "))}});
+    }
+
+    void SqlTracer::finishAction(const Invocation &invocation)
+    {
+        std::vector<std::pair<QString, size_t>> repeated;
+        for (const auto &[statement, count] : invocation.counts)
+        {
+            if (count > 1)
+            {
+                repeated.emplace_back(statement, count);
+            }
+        }
+        std::sort(repeated.begin(), repeated.end(), [](const auto &a, const auto &b)
+                  { return a.second > b.second; });
+        bool nPlusOne = !repeated.empty() && repeated.front().second >= nPlusOneThreshold();
+
+        WOODWORKS_LOG_DEBUG("sql", "action", {{"action", invocation.action}, {"queries", invocation.queries}, {"ms", toMillis(invocation.nanos)}});
+        if (nPlusOne)
+        {
+            WOODWORKS_LOG_WARN("sql", "possible N+1", {{"action", invocation.action}, {"count", repeated.front().second}, {"queries", invocation.queries}, {"sql", repeated.front().first}});
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        ActionStats &stats = actions_[invocation.action];
+        stats.action = invocation.action;
+        ++stats.invocations;
+        stats.queries += invocation.queries;
+        stats.dbNanos += invocation.nanos;
+        stats.nPlusOne += nPlusOne ? 1 : 0;
+        if (invocation.queries >= stats.maxQueries)
+        {
+            stats.maxQueries = invocation.queries;
+            stats.repeated = std::move(repeated);
+        }
+    }
+
+    std::vector<StatementStats> SqlTracer::snapshot() const
+    {
+        std::vector<StatementStats> result;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            result.reserve(static_cast<size_t>(stats_.size()));
+            for (const auto &entry : stats_)
+            {
+                result.push_back(entry.second);
+            }
+        }
+        std::sort(result.begin(), result.end(), [](const StatementStats &a, const StatementStats &b)
+                  { return a.execNanos + a.prepareNanos > b.execNanos + b.prepareNanos; });
+        return result;
+    }
+
+    std::vector<ActionStats> SqlTracer::actionSnapshot() const
+    {
+        std::vector<ActionStats> result;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            result.reserve(actions_.size());
+            for (const auto &entry : actions_)
+            {
+                result.push_back(entry.second);
+            }
+        }
+        std::sort(result.begin(), result.end(), [](const ActionStats &a, const ActionStats &b)
+                  { return a.dbNanos > b.dbNanos; });
+        return result;
+    }
+
+    void SqlTracer::reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.clear();
+        actions_.clear();
+    }
+
+    QByteArray SqlTracer::toJson() const
+    {
+        QJsonArray statements;
+        for (const auto &stats : snapshot())
+        {
+            QJsonObject entry;
+            entry["statement"] = stats.statement;
+            entry["count"] = static_cast<qint64>(stats.count);
+            entry["errors"] = static_cast<qint64>(stats.errors);
+            entry["rows"] = static_cast<qint64>(stats.rows);
+            entry["prepare_ms"] = toMillis(stats.prepareNanos);
+            entry["exec_ms"] = toMillis(stats.execNanos);
+            entry["mean_us"] = stats.meanMicros();
+            entry["p50_us"] = stats.percentileMicros(0.50);
+            entry["p95_us"] = stats.percentileMicros(0.95);
+            entry["p99_us"] = stats.percentileMicros(0.99);
+            entry["max_ms"] = toMillis(stats.maxExecNanos);
+            QJsonArray histogram;
+            for (size_t count : stats.histogram)
+            {
+                histogram.append(static_cast<qint64>(count));
+            }
+            entry["histogram_log2_us"] = histogram;
+            entry["slowest"] = stats.slowestText;
+            entry["plan"] = stats.plan;
+            statements.append(entry);
+        }
+        QJsonArray actions;
+        for (const auto &stats : actionSnapshot())
+        {
+            QJsonObject entry;
+            entry["action"] = stats.action;
+            entry["invocations"] = static_cast<qint64>(stats.invocations);
+            entry["queries"] = static_cast<qint64>(stats.queries);
+            entry["db_ms"] = toMillis(stats.dbNanos);
+            entry["max_queries"] = static_cast<qint64>(stats.maxQueries);
+            entry["n_plus_one"] = static_cast<qint64>(stats.nPlusOne);
+            QJsonArray repeated;
+            for (const auto &[statement, count] : stats.repeated)
+            {
+                QJsonObject repeat;
+                repeat["statement"] = statement;
+                repeat["count"] = static_cast<qint64>(count);
+                repeated.append(repeat);
+            }
+            entry["repeated"] = repeated;
+            actions.append(entry);
+        }
+        QJsonObject root;
+        root["slow_threshold_ms"] = static_cast<double>(slowThreshold().count()) / 1000.0;
+        root["n_plus_one_threshold"] = static_cast<qint64>(nPlusOneThreshold());
+        root["statements"] = statements;
+        root["actions"] = actions;
+        return QJsonDocument(root).toJson(QJsonDocument::Indented);
+    }
+
+    bool SqlTracer::writeJson(const QString &path) const
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            return false;
+        }
+        QByteArray json = toJson();
+        return file.write(json) == json.size();
+    }
+
+    QString SqlTracer::explain(const QSqlDatabase &db, const QString &sql, const QVector<QVariant> &bound)
+    {
+        QString verb = sql.trimmed().section(' ', 0, 0).toUpper();
+        if (verb != "SELECT" && verb != "INSERT" && verb != "UPDATE" && verb != "DELETE" && verb != "WITH")
+        {
+            return QString();
+        }
+        QSqlQuery plan(db);
+        if (!plan.prepare("EXPLAIN QUERY PLAN " + sql))
+        {
+            return QString();
+        }
+        int position = 0;
+        for (const auto &value : bound)
+        {
+            plan.bindValue(position++, value);
+        }
+        if (!plan.exec())
+        {
+            return QString();
+        }
+        // Columns are id, parent, notused, detail; indent each step under its parent
+        QMap<int, int> depth;
+        QStringList lines;
+        while (plan.next())
+        {
+            int id = plan.value(0).toInt();
+            int level = depth.value(plan.value(1).toInt(), -1) + 1;
+            depth[id] = level;
+            lines << QString(level * 2, ' ') + plan.value(3).toString();
+        }
+        return lines.join('\n');
+    }
+
+    // -------------- ActionScope -------------- //
+
+    ActionScope::ActionScope(const QString &action)
+    {
+        auto &invocation = SqlTracer::current_;
+        if (invocation.depth++ == 0 && SqlTracer::instance().enabled())
+        {
+            invocation.active = true;
+            invocation.action = action;
+            invocation.counts.clear();
+            invocation.queries = 0;
+            invocation.nanos = 0;
+        }
+    }
+
+    ActionScope::~ActionScope()
+    {
+        auto &invocation = SqlTracer::current_;
+        if (--invocation.depth == 0 && invocation.active)
+        {
+            invocation.active = false;
+            SqlTracer::instance().finishAction(invocation);
+            invocation.action.clear();
+        }
+    }
+
+    QString ActionScope::current()
+    {
+        return SqlTracer::current_.active ? SqlTracer::current_.action : QString();
+    }
+
+    // -------------- TracedQuery -------------- //
+
+    bool TracedQuery::prepare(const QString &sql)
+    {
+        report();
+        sql_ = sql;
+        if (!SqlTracer::instance().enabled())
+        {
+            return QSqlQuery::prepare(sql);
+        }
+        auto start = Clock::now();
+        bool ok = QSqlQuery::prepare(sql);
+        prepareNanos_ = nanosSince(start);
+        return ok;
+    }
+
+    bool TracedQuery::exec()
+    {
+        report();
+        if (!SqlTracer::instance().enabled())
+        {
+            return QSqlQuery::exec();
+        }
+        auto start = Clock::now();
+        ok_ = QSqlQuery::exec();
+        execNanos_ = nanosSince(start);
+        pending_ = true;
+        return ok_;
+    }
+
+    bool TracedQuery::exec(const QString &sql)
+    {
+        report();
+        sql_ = sql;
+        if (!SqlTracer::instance().enabled())
+        {
+            return QSqlQuery::exec(sql);
+        }
+        auto start = Clock::now();
+        ok_ = QSqlQuery::exec(sql);
+        execNanos_ = nanosSince(start);
+        pending_ = true;
+        return ok_;
+    }
+
+    void TracedQuery::report()
+    {
+        if (!pending_)
+        {
+            rows_ = 0;
+            return;
+        }
+        pending_ = false;
+        size_t rows = isSelect() ? rows_ : static_cast<size_t>(std::max(numRowsAffected(), 0));
+        QString sql = sql_.isEmpty() ? lastQuery() : sql_;
+        SqlTracer::instance().record(sql, prepareNanos_, execNanos_, rows, ok_, [&]()
+                                     {
+            QVector<QVariant> bound;
+            int count = static_cast<int>(boundValues().size());
+            for (int i = 0; i < count; ++i)
+            {
+                bound.append(boundValue(i));
+            }
+            return SqlTracer::explain(db_, sql, bound); });
+        // A prepared statement may run again; its prepare time counts once
+        prepareNanos_ = 0;
+        rows_ = 0;
+    }
+
+    void setTracedQuery(QSqlQueryModel *model, const QString &sql, const QSqlDatabase &db)
+    {
+        if (!SqlTracer::instance().enabled())
+        {
+            model->setQuery(sql, db);
+            return;
+        }
+        auto start = Clock::now();
+        model->setQuery(sql, db);
+        int64_t nanos = nanosSince(start);
+        SqlTracer::instance().record(sql, 0, nanos, static_cast<size_t>(std::max(model->rowCount(), 0)), !model->lastError().isValid(), [&]()
+                                     { return SqlTracer::explain(db, sql); });
+    }
+
+    void setTracedQuery(QSqlQueryModel *model, QSqlQuery &prepared, const QVector<QVariant> &bound, const QSqlDatabase &db)
+    {
+        bool tracing = SqlTracer::instance().enabled();
+        auto start = Clock::now();
+        for (int i = 0; i < bound.size(); ++i)
+        {
+            prepared.bindValue(i, bound[i]);
+        }
+        prepared.exec();
+        // Takes an inactive query too, and reports its error through lastError()
+        model->setQuery(prepared);
+        if (!tracing)
+        {
+            return;
+        }
+        int64_t nanos = nanosSince(start);
+        QString sql = prepared.lastQuery();
+        SqlTracer::instance().record(sql, 0, nanos, static_cast<size_t>(std::max(model->rowCount(), 0)), !model->lastError().isValid(), [&]()
+                                     { return SqlTracer::explain(db, sql, bound); });
+    }
+}
@@ -0,0 +1,56 @@
+#include "infra/startup_timeline.hpp"
+
+#include <QStringList>
+
+#include "infra/logging.hpp"
+
+using namespace woodworks::infra;
+
+namespace
+{
+    double millisBetween(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+    {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+}
+
+StartupTimeline &StartupTimeline::instance()
+{
+    static StartupTimeline timeline;
+    return timeline;
+}
+
+void StartupTimeline::mark(const QString &phase)
+{
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    phases_.push_back({phase, millisBetween(last_, now), millisBetween(start_, now)});
+    last_ = now;
+}
+
+std::vector<StartupPhase> StartupTimeline::phases() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return phases_;
+}
+
+QString StartupTimeline::summary() const
+{
+    auto all = phases();
+    QStringList parts;
+    for (const auto &phase : all)
+    {
+        parts << QString("%1 %2 ms").arg(phase.name).arg(phase.millis, 0, 'f', 0);
+    }
+    double total = all.empty() ? 0.0 : all.back().atMillis;
+    return QString("%1 (total %2 ms)").arg(parts.join(", ")).arg(total, 0, 'f', 0);
+}
+
+void StartupTimeline::report() const
+{
+    for (const auto &phase : phases())
+    {
+        WOODWORKS_LOG_DEBUG("startup", "phase", {{"phase", phase.name}, {"ms", phase.millis}, {"atMs", phase.atMillis}});
+    }
+    WOODWORKS_LOG_INFO("startup", summary().toStdString());
+}
@@ -1,13 +1,61 @@
 #include "infra/unit_of_work.hpp"
+#include "infra/entity_cache.hpp"
+#include "infra/dictionaries.hpp"
+#include "infra/name_table.hpp"
+#include "infra/inventory_snapshot.hpp"
+#include <map>
+#include <mutex>
 #include <stdexcept>
 #include <QSqlError>
+#include <QSqlQuery>
 
 using namespace woodworks::infra;
 
+namespace
+{
+    std::mutex depthMutex;
+    std::map<QString, int> depths; ///< Open units of work per connection name.
+
+    int enter(const QSqlDatabase &db)
+    {
+        std::lock_guard<std::mutex> lock(depthMutex);
+        return depths[db.connectionName()]++;
+    }
+
+    void leave(const QSqlDatabase &db)
+    {
+        std::lock_guard<std::mutex> lock(depthMutex);
+        if (--depths[db.connectionName()] == 0)
+        {
+            depths.erase(db.connectionName());
+        }
+    }
+
+    // Returns the error text, empty on success
+    QString run(QSqlDatabase &db, const QString &sql)
+    {
+        QSqlQuery q(db);
+        return q.exec(sql) ? QString() : q.lastError().text();
+    }
+}
+
 UnitOfWork::UnitOfWork(QSqlDatabase &db) : db_(db)
 {
+    int depth = enter(db_);
+    if (depth > 0)
+    {
+        savepoint_ = QString("uow_%1").arg(depth);
+        QString error = run(db_, "SAVEPOINT " + savepoint_);
+        if (!error.isEmpty())
+        {
+            leave(db_);
+            throw std::runtime_error("Failed to start savepoint: " + error.toStdString());
+        }
+        return;
+    }
     if (!db_.transaction())
     {
+        leave(db_);
         throw std::runtime_error("Failed to start transaction: " + db_.lastError().text().toStdString());
     }
 }
@@ -16,15 +64,42 @@ UnitOfWork::~UnitOfWork()
 {
     if (!committed_)
     {
-        db_.rollback();
+        if (savepoint_.isEmpty())
+        {
+            db_.rollback();
+        }
+        else
+        {
+            run(db_, "ROLLBACK TO " + savepoint_);
+            run(db_, "RELEASE " + savepoint_);
+        }
+        // Repositories wrote through to the caches, name tables, dictionaries and snapshots inside this transaction
+        EntityCaches::clearAll();
+        NameTable::clearAll(db_);
+        Dictionaries::of(db_).invalidate();
+        InventorySnapshots::instance().invalidate();
+        leave(db_);
     }
 }
 
 void UnitOfWork::commit()
 {
-    if (!db_.commit())
+    if (savepoint_.isEmpty())
+    {
+        if (!db_.commit())
+        {
+            throw std::runtime_error("Failed to commit transaction: " + db_.lastError().text().toStdString());
+        }
+    }
+    else
     {
-        throw std::runtime_error("Failed to commit transaction: " + db_.lastError().text().toStdString());
+        QString error = run(db_, "RELEASE " + savepoint_);
+        if (!error.isEmpty())
+        {
+            throw std::runtime_error("Failed to release savepoint: " + error.toStdString());
+        }
     }
     committed_ = true;
-}
\ No newline at end of file
+    // A committed unit of work may stay in scope; it no longer encloses later ones
+    leave(db_);
+}
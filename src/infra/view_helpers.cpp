@@ -0,0 +1,461 @@
+#include "infra/mappers/view_helpers.hpp"
+
+#include <QPointer>
+#include <QRegularExpression>
+#include <QSqlQuery>
+
+#include <cmath>
+#include <map>
+#include <mutex>
+
+#include "infra/mappers/log_mapper.hpp"
+#include "infra/mappers/cookie_mapper.hpp"
+#include "infra/mappers/live_edge_slab_mapper.hpp"
+#include "infra/mappers/lumber_mapper.hpp"
+#include "infra/mappers/firewood_mapper.hpp"
+#include "infra/name_table.hpp"
+
+using namespace woodworks::infra;
+
+namespace
+{
+    std::mutex viewsMutex;
+
+    std::map<QString, DisplayView> &views()
+    {
+        static std::map<QString, DisplayView> registered;
+        return registered;
+    }
+
+    // The views are registered as a side effect of building their SQL, which
+    // migrations only do once per database, so build them here on first use
+    void registerInventoryViews()
+    {
+        static std::once_flag once;
+        std::call_once(once, []()
+                       {
+            using namespace woodworks::domain;
+            Log::individualViewSQL();
+            Log::groupedViewSQL();
+            Cookie::individualViewSQL();
+            Cookie::groupedViewSQL();
+            LiveEdgeSlab::individualViewSQL();
+            LiveEdgeSlab::groupedViewSQL();
+            Lumber::individualViewSQL();
+            Lumber::groupedViewSQL();
+            Firewood::individualViewSQL();
+            Firewood::groupedViewSQL(); });
+    }
+
+    /**
+     * How a display column maps back to its base column.
+     *
+     * Scaled:    `ROUND(col/divisor,decimals)`; a display range becomes a half-open raw range.
+     * Truncated: `printf('%d/N', col/divisor)`; "8/4" becomes [8, 9) * divisor.
+     * Labels:    `CASE col WHEN 0 THEN 'Green' ...`; a label becomes its code.
+     * Interned:  `species.name` joined on the key column; a name becomes its key.
+     */
+    struct Translation
+    {
+        enum Kind
+        {
+            None,
+            Same,
+            Scaled,
+            Truncated,
+            Labels,
+            Interned
+        };
+        Kind kind{None};
+        QString column;
+        double divisor{1.0};
+        int decimals{0};
+        std::map<QString, int> labels;
+        NameTable *names{nullptr};
+    };
+
+    QString unquote(QString name)
+    {
+        name = name.trimmed();
+        if (name.size() >= 2 && (name.startsWith("\"") || name.startsWith("'")))
+        {
+            name = name.mid(1, name.size() - 2);
+        }
+        return name.toLower();
+    }
+
+    Translation translationFor(const QString &expression)
+    {
+        static const QRegularExpression interned(R"(^(species|storage_bins)\.name$)");
+        static const QRegularExpression same(R"(^([\w.]+)$)");
+        static const QRegularExpression scaled(R"(^ROUND\((\w+)(?:/([\d.]+))?(?:,\s*(\d+))?\)$)");
+        static const QRegularExpression truncated(R"(^printf\('%d/\d+', (\w+)/([\d.]+)\)$)");
+        static const QRegularExpression labels(R"(^CASE (\w+) ((?:WHEN \d+ THEN '[^']*' ?)+)END$)");
+        static const QRegularExpression label(R"(WHEN (\d+) THEN '([^']*)')");
+
+        Translation t;
+        if (auto m0 = interned.match(expression); m0.hasMatch())
+        {
+            bool species = m0.captured(1) == "species";
+            t.kind = Translation::Interned;
+            t.column = species ? "species_id" : "location_id";
+            t.names = species ? &NameTable::species() : &NameTable::locations();
+        }
+        else if (auto m = same.match(expression); m.hasMatch())
+        {
+            t.kind = Translation::Same;
+            t.column = m.captured(1);
+        }
+        else if (auto m2 = scaled.match(expression); m2.hasMatch())
+        {
+            t.kind = Translation::Scaled;
+            t.column = m2.captured(1);
+            t.divisor = m2.captured(2).isEmpty() ? 1.0 : m2.captured(2).toDouble();
+            t.decimals = m2.captured(3).isEmpty() ? 0 : m2.captured(3).toInt();
+        }
+        else if (auto m3 = truncated.match(expression); m3.hasMatch())
+        {
+            t.kind = Translation::Truncated;
+            t.column = m3.captured(1);
+            t.divisor = m3.captured(2).toDouble();
+        }
+        else if (auto m4 = labels.match(expression); m4.hasMatch())
+        {
+            t.kind = Translation::Labels;
+            t.column = m4.captured(1);
+            auto it = label.globalMatch(m4.captured(2));
+            while (it.hasNext())
+            {
+                auto l = it.next();
+                t.labels[l.captured(2)] = l.captured(1).toInt();
+            }
+        }
+        return t;
+    }
+
+    // The translation for a filtered display column; None if the filter has to stay on the view's output
+    Translation translate(const DisplayView &view, const QString &filterColumn)
+    {
+        static const QRegularExpression aliased(R"(^(.*) AS '([^']*)'$)");
+        const QString wanted = unquote(filterColumn);
+        for (const QString &column : view.columns)
+        {
+            auto m = aliased.match(column);
+            if (!m.hasMatch() || m.captured(2).toLower() != wanted)
+            {
+                continue;
+            }
+            QString expression = m.captured(1).trimmed();
+            Translation t = translationFor(expression);
+            // Filtering rows before grouping only matches filtering groups after it on a grouping key
+            if (!view.groupBy.isEmpty() && !view.groupBy.contains(expression) && !view.groupBy.contains(t.column))
+            {
+                return Translation{};
+            }
+            return t;
+        }
+        return Translation{};
+    }
+
+    // Raw values whose display value rounds into [low, high]
+    std::pair<double, double> rawRange(const Translation &t, double low, double high)
+    {
+        double half = 0.5 * std::pow(10.0, -t.decimals);
+        return {(low - half) * t.divisor, (high + half) * t.divisor};
+    }
+
+    struct Compiler
+    {
+        QStringList base;
+        QStringList display;
+        QVector<QVariant> baseValues;
+        QVector<QVariant> displayValues;
+        std::vector<BasePredicate> predicates;
+
+        void equal(const QString &column, const QVariant &value)
+        {
+            onBase(column + " = ?", {value});
+            predicates.push_back(BasePredicate{column, value, {}, {}});
+        }
+
+        // Half-open [low, high); an invalid bound is left open
+        void range(const QString &column, const QVariant &low, const QVariant &high)
+        {
+            if (low.isValid() && high.isValid())
+                onBase(column + " >= ? AND " + column + " < ?", {low, high});
+            else if (low.isValid())
+                onBase(column + " >= ?", {low});
+            else
+                onBase(column + " < ?", {high});
+            predicates.push_back(BasePredicate{column, {}, low, high});
+        }
+
+        void onBase(const QString &term, std::initializer_list<QVariant> values)
+        {
+            base << term;
+            for (const auto &v : values)
+            {
+                baseValues << v;
+            }
+        }
+
+        void onDisplay(const QString &term, std::initializer_list<QVariant> values)
+        {
+            display << term;
+            for (const auto &v : values)
+            {
+                displayValues << v;
+            }
+        }
+
+        // Applies the rule to the view's output
+        void untranslated(const FieldFilter &f)
+        {
+            std::visit([&](auto &&r)
+                       {
+                using R = std::decay_t<decltype(r)>;
+                if constexpr (std::is_same_v<R, Exact>)
+                    onDisplay(f.column + " = ?", {r.value});
+                else if constexpr (std::is_same_v<R, Numeric>)
+                    onDisplay(f.column + " >= ?", {r.minValue});
+                else if constexpr (std::is_same_v<R, EnumInc>)
+                {
+                    if (r.chosen.has_value())
+                        onDisplay(f.column + " = ?", {*r.chosen});
+                }
+                else if constexpr (std::is_same_v<R, Max>)
+                    onDisplay(f.column + " <= ?", {r.maxValue});
+                else if constexpr (std::is_same_v<R, Between>)
+                    onDisplay(f.column + " BETWEEN ? AND ?", {r.minValue, r.maxValue}); }, f.rule);
+        }
+
+        // Returns false if the rule has no base-column equivalent
+        bool translated(const Translation &t, const FieldFilter &f)
+        {
+            const QString &c = t.column;
+            return std::visit([&](auto &&r) -> bool
+                              {
+                using R = std::decay_t<decltype(r)>;
+                if constexpr (std::is_same_v<R, EnumInc>)
+                {
+                    // The chosen value is the stored code
+                    if (t.kind != Translation::Same && t.kind != Translation::Labels)
+                        return false;
+                    if (r.chosen.has_value())
+                        equal(c, *r.chosen);
+                    return true;
+                }
+                else if constexpr (std::is_same_v<R, Exact>)
+                {
+                    switch (t.kind)
+                    {
+                    case Translation::Same:
+                        equal(c, r.value);
+                        return true;
+                    case Translation::Scaled:
+                    {
+                        bool ok = false;
+                        double v = r.value.toDouble(&ok);
+                        if (!ok)
+                            return false;
+                        auto [low, high] = rawRange(t, v, v);
+                        range(c, low, high);
+                        return true;
+                    }
+                    case Translation::Truncated:
+                    {
+                        bool ok = false;
+                        int whole = r.value.toString().section('/', 0, 0).toInt(&ok);
+                        if (!ok)
+                            return false;
+                        range(c, whole * t.divisor, (whole + 1) * t.divisor);
+                        return true;
+                    }
+                    case Translation::Labels:
+                    {
+                        auto it = t.labels.find(r.value.toString());
+                        if (it == t.labels.end())
+                            return false;
+                        equal(c, it->second);
+                        return true;
+                    }
+                    case Translation::Interned:
+                    {
+                        // A name that was never stored matches no key
+                        auto id = t.names->find(r.value.toString().toStdString());
+                        equal(c, id.value_or(-1));
+                        return true;
+                    }
+                    case Translation::None:
+                        return false;
+                    }
+                    return false;
+                }
+                else
+                {
+                    if (t.kind != Translation::Scaled)
+                        return false;
+                    if constexpr (std::is_same_v<R, Numeric>)
+                        range(c, rawRange(t, r.minValue, r.minValue).first, {});
+                    else if constexpr (std::is_same_v<R, Max>)
+                        range(c, {}, rawRange(t, r.maxValue, r.maxValue).second);
+                    else if constexpr (std::is_same_v<R, Between>)
+                    {
+                        auto [low, high] = rawRange(t, r.minValue, r.maxValue);
+                        range(c, low, high);
+                    }
+                    return true;
+                } }, f.rule);
+        }
+    };
+
+    struct CachedStatement
+    {
+        QSqlQuery query;
+        QPointer<QSqlQueryModel> owner; ///< The model the statement's current result belongs to.
+    };
+}
+
+void woodworks::infra::registerDisplayView(const DisplayView &view)
+{
+    std::lock_guard<std::mutex> lock(viewsMutex);
+    views()[view.name] = view;
+}
+
+std::optional<DisplayView> woodworks::infra::displayView(const QString &name)
+{
+    registerInventoryViews();
+    std::lock_guard<std::mutex> lock(viewsMutex);
+    auto it = views().find(name);
+    if (it == views().end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::map<int, QString> woodworks::infra::displayLabels(const QString &view, const QString &alias)
+{
+    std::map<int, QString> codes;
+    if (auto definition = displayView(view))
+    {
+        for (const auto &[label, code] : translate(*definition, alias).labels)
+        {
+            codes[code] = label;
+        }
+    }
+    return codes;
+}
+
+CompiledFilter woodworks::infra::compileFilters(const QString &tableOrView, const QVector<FieldFilter> &filters)
+{
+    Compiler compiler;
+    auto view = displayView(tableOrView);
+    for (const FieldFilter &f : filters)
+    {
+        if (!view || !compiler.translated(translate(*view, f.column), f))
+        {
+            compiler.untranslated(f);
+        }
+    }
+
+    CompiledFilter compiled;
+    QString source = tableOrView;
+    if (view)
+    {
+        source = QString("SELECT %1 FROM %2").arg(view->columns.join(", "), view->table);
+        if (!compiler.base.isEmpty())
+        {
+            source += " WHERE " + compiler.base.join(" AND ");
+        }
+        if (!view->groupBy.isEmpty())
+        {
+            source += " GROUP BY " + view->groupBy.join(", ");
+        }
+        compiled.bound = compiler.baseValues;
+        compiled.predicates = compiler.predicates;
+        compiled.baseOnly = compiler.display.isEmpty();
+    }
+    if (!view)
+    {
+        compiled.sql = "SELECT * FROM " + source;
+    }
+    else if (compiler.display.isEmpty())
+    {
+        compiled.sql = source;
+    }
+    else
+    {
+        compiled.sql = "SELECT * FROM (" + source + ")";
+    }
+    if (!compiler.display.isEmpty())
+    {
+        compiled.sql += " WHERE " + compiler.display.join(" AND ");
+        compiled.bound << compiler.displayValues;
+    }
+    return compiled;
+}
+
+QStringList woodworks::infra::filterableColumns(const QString &view)
+{
+    static const QRegularExpression aliased(R"(^(.*) AS '([^']*)'$)");
+    QStringList columns;
+    if (auto definition = displayView(view))
+    {
+        for (const QString &column : definition->columns)
+        {
+            auto m = aliased.match(column);
+            if (!m.hasMatch())
+            {
+                continue;
+            }
+            Translation t = translationFor(m.captured(1).trimmed());
+            if (t.kind != Translation::None && !columns.contains(t.column))
+            {
+                columns << t.column;
+            }
+        }
+    }
+    return columns;
+}
+
+QSqlQueryModel *woodworks::infra::makeFilteredModel(const QString &tableOrView, const QVector<FieldFilter> &filters, QObject *parent, QSqlQueryModel *replacing)
+{
+    CompiledFilter compiled = compileFilters(tableOrView, filters);
+    WOODWORKS_LOG_DEBUG("views", "filtered model", {{"sql", compiled.sql}, {"values", compiled.bound.size()}});
+
+    // Statements never outlive the process's single connection, so the cache is never torn down
+    static auto *statements = new std::map<QString, CachedStatement>();
+    QSqlDatabase db = QSqlDatabase::database();
+    QString key = db.connectionName() + '\n' + db.databaseName() + '\n' + compiled.sql;
+    auto it = statements->find(key);
+    if (it != statements->end() && it->second.owner && it->second.owner != replacing)
+    {
+        // Another live model still reads from the cached statement's result, so this one gets its own
+        statements->erase(it);
+        it = statements->end();
+    }
+    if (it == statements->end())
+    {
+        CachedStatement statement{QSqlQuery(db), nullptr};
+        if (!statement.query.prepare(compiled.sql))
+        {
+            WOODWORKS_LOG_WARN("views", "filtered model prepare error", {{"error", statement.query.lastError().text()}, {"sql", compiled.sql}});
+        }
+        it = statements->emplace(key, statement).first;
+    }
+    else if (it->second.owner)
+    {
+        // Re-running the statement replaces the result the replaced model reads from
+        it->second.owner->clear();
+    }
+
+    auto *model = new QSqlQueryModel(parent);
+    setTracedQuery(model, it->second.query, compiled.bound, db);
+    it->second.owner = model;
+
+    if (model->lastError().isValid())
+        WOODWORKS_LOG_WARN("views", "filtered model query error", {{"error", model->lastError().text()}, {"sql", compiled.sql}});
+
+    return model;
+}
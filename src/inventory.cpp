@@ -12,6 +12,8 @@
 #include <QStringList>
 #include <QVariant>
 #include <QMenu>
+#include <QItemSelectionModel>
+#include <QTableView>
 
 #include "inventory.hpp"
 #include "csv_importer.hpp"
@@ -30,12 +32,16 @@
 #include "infra/repository.hpp"
 #include "infra/mappers/view_helpers.hpp"
 #include "infra/helpers.hpp"
+#include "infra/dictionaries.hpp"
+#include "infra/inventory_snapshot.hpp"
 #include "infra/images.hpp"
+#include "infra/logging.hpp"
 
 #include "widgets/SlabCuttingWindow.hpp"
 #include "widgets/slabSurfacingPopup.hpp"
 #include "widgets/dryingPopup.hpp"
 #include "widgets/LumberCuttingWindow.hpp"
+#include "widgets/RefreshScheduler.hpp"
 #include "domain/firewood_bundle.hpp"
 
 using namespace woodworks::domain::imperial;
@@ -44,6 +50,42 @@ using namespace woodworks::domain;
 using namespace woodworks::infra;
 using namespace woodworks::widgets;
 
+namespace
+{
+    // Whether the clicked row is part of a multi-row selection the action should apply to
+    bool inSelection(QTableView *view, const QModelIndex &clicked)
+    {
+        auto *selection = view->selectionModel();
+        return selection && selection->isRowSelected(clicked.row(), QModelIndex());
+    }
+
+    // The selected rows if the clicked row is one of them, else just the clicked row, read in one query
+    template <typename T>
+    std::vector<T> selectedItems(QTableView *view, const QModelIndex &clicked)
+    {
+        std::vector<int> ids;
+        if (inSelection(view, clicked))
+        {
+            for (const QModelIndex &row : view->selectionModel()->selectedRows(0))
+            {
+                ids.push_back(row.data().toInt());
+            }
+        }
+        else
+        {
+            ids.push_back(clicked.sibling(clicked.row(), 0).data().toInt());
+        }
+        return QtSqlRepository<T>::spawn().getMany(ids);
+    }
+
+    // "Dry Log" for one row, "Dry Log (80 selected)" for a selection
+    QString forSelection(QTableView *view, const QModelIndex &clicked, const QString &label)
+    {
+        int count = inSelection(view, clicked) ? view->selectionModel()->selectedRows(0).size() : 1;
+        return count > 1 ? QString("%1 (%2 selected)").arg(label).arg(count) : label;
+    }
+}
+
 InventoryPage::InventoryPage(QWidget *parent)
     : QWidget(parent), ui(new Ui::InventoryPage),
       individualLogsModel(new QSqlQueryModel(this)),
@@ -67,46 +109,54 @@ InventoryPage::InventoryPage(QWidget *parent)
     ui->logEntryLogDryingComboBox->addItem("Kiln Dried", QVariant(static_cast<int>(Drying::KILN_DRIED)));
     ui->logEntryLogDryingComboBox->addItem("Air & Kiln Dried", QVariant(static_cast<int>(Drying::KILN_AND_AIR_DRIED)));
 
-    buildFilterWidgets();
-
-    refreshModels();
-
-    // When the views/filters are changed, refresh the models.
-    connect(ui->detailedViewCheckBox, &QCheckBox::stateChanged, this, &InventoryPage::refreshModels);
-    connect(ui->logSpeciesComboBox, &QComboBox::currentTextChanged, this, &InventoryPage::refreshModels);
-    connect(ui->logLengthMin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->logLengthMax, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->logDiameterMin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->logDiameterMax, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->logSpeciesComboBox, &QComboBox::currentTextChanged, this, &InventoryPage::refreshModels);
-    connect(ui->logDryingComboBox, &QComboBox::currentTextChanged, this, &InventoryPage::refreshModels);
-    connect(ui->cookiesSpeciesCombo, &QComboBox::currentTextChanged, this, &InventoryPage::refreshModels);
-    connect(ui->cookieThicknessSpinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->cookieThicknessMaxSpinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->cookieDiameterMinSpinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->cookieDiameterMaxSpinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->cookieDryingCombo, &QComboBox::currentTextChanged, this, &InventoryPage::refreshModels);
-    connect(ui->slabDryingCombo, &QComboBox::currentTextChanged, this, &InventoryPage::refreshModels);
-    connect(ui->slabsSpeciesCombo, &QComboBox::currentTextChanged, this, &InventoryPage::refreshModels);
-    connect(ui->slabLengthMin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->slabLengthMax, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->slabWidthMin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->slabWidthMax, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->slabThicknessMin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->slabThicknessMax, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->lumberSpeciesCombo, &QComboBox::currentTextChanged, this, &InventoryPage::refreshModels);
-    connect(ui->lumberThicknessCombo, &QComboBox::currentTextChanged, this, &InventoryPage::refreshModels);
-    connect(ui->lumberDryingCombo, &QComboBox::currentTextChanged, this, &InventoryPage::refreshModels);
-    connect(ui->lumberWidthMin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->lumberWidthMax, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->lumberLengthMin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->lumberLengthMax, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->lumberThicknessCombo, &QComboBox::currentTextChanged, this, &InventoryPage::refreshModels);
-    connect(ui->lumberSurfacingCombo, &QComboBox::currentTextChanged, this, &InventoryPage::refreshModels);
-    connect(ui->lumberLengthMin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->lumberLengthMax, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &InventoryPage::refreshModels);
-    connect(ui->firewoodSpeciesCombo, &QComboBox::currentTextChanged, this, &InventoryPage::refreshModels);
-    connect(ui->firewoodDryingCombo, &QComboBox::currentTextChanged, this, &InventoryPage::refreshModels);
+    refresh = new RefreshScheduler(
+        ui->inventoryTabs, [this](int tab)
+        { refreshTab(tab); },
+        [this]()
+        { buildFilterWidgets(); });
+    // The first load is not worth waiting for
+    refresh->dataChanged();
+    refresh->flushNow();
+
+    // Filter input is debounced and only re-queries the tab it belongs to
+    auto filtersOf = [this](QWidget *tab)
+    {
+        return [this, tab]()
+        { refresh->request(ui->inventoryTabs->indexOf(tab)); };
+    };
+    connect(ui->detailedViewCheckBox, &QCheckBox::stateChanged, this, [this]()
+            { refresh->requestAll(); });
+    connect(ui->logSpeciesComboBox, &QComboBox::currentTextChanged, this, filtersOf(ui->logsTab));
+    connect(ui->logLengthMin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->logsTab));
+    connect(ui->logLengthMax, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->logsTab));
+    connect(ui->logDiameterMin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->logsTab));
+    connect(ui->logDiameterMax, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->logsTab));
+    connect(ui->logDryingComboBox, &QComboBox::currentTextChanged, this, filtersOf(ui->logsTab));
+    connect(ui->cookiesSpeciesCombo, &QComboBox::currentTextChanged, this, filtersOf(ui->cookiesTab));
+    connect(ui->cookieThicknessSpinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->cookiesTab));
+    connect(ui->cookieThicknessMaxSpinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->cookiesTab));
+    connect(ui->cookieDiameterMinSpinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->cookiesTab));
+    connect(ui->cookieDiameterMaxSpinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->cookiesTab));
+    connect(ui->cookieDryingCombo, &QComboBox::currentTextChanged, this, filtersOf(ui->cookiesTab));
+    connect(ui->slabsSpeciesCombo, &QComboBox::currentTextChanged, this, filtersOf(ui->slabsTab));
+    connect(ui->slabLengthMin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->slabsTab));
+    connect(ui->slabLengthMax, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->slabsTab));
+    connect(ui->slabWidthMin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->slabsTab));
+    connect(ui->slabWidthMax, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->slabsTab));
+    connect(ui->slabThicknessMin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->slabsTab));
+    connect(ui->slabThicknessMax, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->slabsTab));
+    connect(ui->slabDryingCombo, &QComboBox::currentTextChanged, this, filtersOf(ui->slabsTab));
+    connect(ui->slabSurfacingCombo, &QComboBox::currentTextChanged, this, filtersOf(ui->slabsTab));
+    connect(ui->lumberSpeciesCombo, &QComboBox::currentTextChanged, this, filtersOf(ui->lumberTab));
+    connect(ui->lumberThicknessCombo, &QComboBox::currentTextChanged, this, filtersOf(ui->lumberTab));
+    connect(ui->lumberDryingCombo, &QComboBox::currentTextChanged, this, filtersOf(ui->lumberTab));
+    connect(ui->lumberSurfacingCombo, &QComboBox::currentTextChanged, this, filtersOf(ui->lumberTab));
+    connect(ui->lumberWidthMin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->lumberTab));
+    connect(ui->lumberWidthMax, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->lumberTab));
+    connect(ui->lumberLengthMin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->lumberTab));
+    connect(ui->lumberLengthMax, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, filtersOf(ui->lumberTab));
+    connect(ui->firewoodSpeciesCombo, &QComboBox::currentTextChanged, this, filtersOf(ui->firewoodTab));
+    connect(ui->firewoodDryingCombo, &QComboBox::currentTextChanged, this, filtersOf(ui->firewoodTab));
 
     connect(ui->addLogButton, &QPushButton::clicked, this, &InventoryPage::onAddLogClicked);
     connect(ui->spreadsheetImporterButton, &QPushButton::clicked, this, &InventoryPage::onSpreadsheetImportClicked);
@@ -139,6 +189,12 @@ InventoryPage::InventoryPage(QWidget *parent)
 
 InventoryPage::~InventoryPage()
 {
+    auto stats = refresh->stats();
+    WOODWORKS_LOG_INFO("inventory", "refresh summary",
+                       {{"requested", stats.requested}, {"refreshed", stats.refreshed}, {"avoided", stats.avoided()}});
+    auto snapshots = InventorySnapshots::instance().stats();
+    WOODWORKS_LOG_INFO("inventory", "snapshot summary",
+                       {{"loads", snapshots.loads}, {"scans", snapshots.scans}, {"fallbacks", snapshots.fallbacks}, {"invalidations", snapshots.invalidations}});
     delete ui;
 }
 
@@ -148,7 +204,7 @@ void InventoryPage::slabsCustomContextMenu(const QPoint &pos)
     QModelIndex index = ui->slabsTableView->indexAt(pos);
     if (!index.isValid())
     {
-        std::cout << "Invalid index" << std::endl;
+        WOODWORKS_LOG_DEBUG("inventory", "context menu outside any row");
         return;
     }
     if (!ui->detailedViewCheckBox->isChecked())
@@ -156,17 +212,19 @@ void InventoryPage::slabsCustomContextMenu(const QPoint &pos)
         return;
     }
 
+    // Surfacing, drying, relocating and scrapping apply to every selected row at once
+    QTableView *view = ui->slabsTableView;
     QMenu contextMenu;
-    contextMenu.addAction("Surface Board", [this, index]()
+    contextMenu.addAction(forSelection(view, index, "Surface Board"), [view, index]()
                           {
-        auto slab = QtSqlRepository<LiveEdgeSlab>::spawn().get(index.sibling(index.row(), 0).data().toInt());
-        slabSurfacingPopUp(slab.value()); });
+        auto slabs = selectedItems<LiveEdgeSlab>(view, index);
+        slabSurfacingPopUp(slabs); });
 
     // Dry board
-    contextMenu.addAction("Dry Board", [this, index]()
+    contextMenu.addAction(forSelection(view, index, "Dry Board"), [view, index]()
                           {
-        auto slab = QtSqlRepository<LiveEdgeSlab>::spawn().get(index.sibling(index.row(), 0).data().toInt());
-        dryingPopUp(slab.value()); });
+        auto slabs = selectedItems<LiveEdgeSlab>(view, index);
+        dryingPopUp(slabs); });
 
     contextMenu.addAction("Cut Lumber", [this, index]()
                           {
@@ -177,31 +235,15 @@ void InventoryPage::slabsCustomContextMenu(const QPoint &pos)
             win->show();
         } });
 
-    contextMenu.addAction("Change Location", [this, index]()
+    contextMenu.addAction(forSelection(view, index, "Change Location"), [this, view, index]()
                           {
-        int slabId = index.sibling(index.row(), 0).data().toInt();
-        auto repo = QtSqlRepository<LiveEdgeSlab>::spawn();
-        auto slabOpt = repo.get(slabId);
-    
-        if (slabOpt) {
-            LiveEdgeSlab slab = slabOpt.value();
-            bool ok;
-            QString currentLoc = QString::fromStdString(slab.location);
-            QString newLoc = QInputDialog::getText(this, "Relocate", "Enter new location:", QLineEdit::Normal, currentLoc, &ok);
-            
-            if (ok && !newLoc.isEmpty()) {
-                slab.location = newLoc.toStdString();
-                repo.update(slab);
-                refreshModels();    
-            }
-        } });
+        auto slabs = selectedItems<LiveEdgeSlab>(view, index);
+        relocatePopUp(slabs, this); });
 
     // add scrap board
-    contextMenu.addAction("Scrap Board", [this, index]()
+    contextMenu.addAction(forSelection(view, index, "Scrap Board"), [this, view, index]()
                           {
-        int id = index.sibling(index.row(), 0).data().toInt();
-        auto slab = QtSqlRepository<LiveEdgeSlab>::spawn().get(id);
-        if (slab) { scrapPopUp(*slab, this); refreshModels(); } });
+        scrapPopUp(selectedItems<LiveEdgeSlab>(view, index), this); });
 
     contextMenu.exec(ui->slabsTableView->viewport()->mapToGlobal(pos));
 }
@@ -211,7 +253,7 @@ void InventoryPage::logsCustomContextMenu(const QPoint &pos)
     QModelIndex index = ui->logsTableView->indexAt(pos);
     if (!index.isValid())
     {
-        std::cout << "Invalid index" << std::endl;
+        WOODWORKS_LOG_DEBUG("inventory", "context menu outside any row");
         return;
     }
 
@@ -226,6 +268,8 @@ void InventoryPage::logsCustomContextMenu(const QPoint &pos)
     }
     else
     {
+        // Drying, scrapping and relocating apply to every selected row at once
+        QTableView *view = ui->logsTableView;
         QMenu contextMenu;
         contextMenu.addAction("View Image", [this, index]()
                               {
@@ -238,32 +282,21 @@ void InventoryPage::logsCustomContextMenu(const QPoint &pos)
             } });
 
         // Dry log
-        contextMenu.addAction("Dry Log", [this, index]()
+        contextMenu.addAction(forSelection(view, index, "Dry Log"), [view, index]()
                               {
-            // Get the log ID from the model
-            int logId = index.sibling(index.row(), 0).data().toInt();
-            // Get the log from the database
-            auto log = QtSqlRepository<Log>::spawn().get(logId);
-            if (log) {
-                // Show a dialog to select the drying state
-                dryingPopUp(*log);
-                refreshModels();
-            } });
+            // Show a dialog to select the drying state
+            auto logs = selectedItems<Log>(view, index);
+            dryingPopUp(logs); });
 
-        contextMenu.addAction("Scrap Log", [this, index]()
+        contextMenu.addAction(forSelection(view, index, "Scrap Log"), [this, view, index]()
                               {
-            int logId = index.sibling(index.row(), 0).data().toInt();
-            auto log = QtSqlRepository<Log>::spawn().get(logId);
-            if (log) {
-                scrapPopUp(*log, this);
-                refreshModels();
-            } });
+            scrapPopUp(selectedItems<Log>(view, index), this); });
 
         contextMenu.addAction("Cut Cookie", [this, index]()
                               {
             // Get the log ID from the model
             int logId = index.sibling(index.row(), 0).data().toInt();
-            std::cout << "Log ID: " << logId << std::endl;
+            WOODWORKS_LOG_DEBUG("inventory", "log action", {{"id", logId}});
             // Get the log from the database
             auto log = QtSqlRepository<Log>::spawn().get(logId);
             if (log) {
@@ -289,7 +322,7 @@ void InventoryPage::logsCustomContextMenu(const QPoint &pos)
                               {
             // Get the log ID from the model
             int logId = index.sibling(index.row(), 0).data().toInt();
-            std::cout << "Log ID: " << logId << std::endl;
+            WOODWORKS_LOG_DEBUG("inventory", "log action", {{"id", logId}});
             // Get the log from the database
             auto log = QtSqlRepository<Log>::spawn().get(logId);
             if (log) {
@@ -302,24 +335,10 @@ void InventoryPage::logsCustomContextMenu(const QPoint &pos)
                 }
             } });
 
-        contextMenu.addAction("Change Location", [this, index]()
+        contextMenu.addAction(forSelection(view, index, "Change Location"), [this, view, index]()
                               {
-            int logId = index.sibling(index.row(), 0).data().toInt();
-            auto repo = QtSqlRepository<Log>::spawn();
-            auto logOpt = repo.get(logId);
-        
-            if (logOpt) {
-                Log log = logOpt.value();
-                bool ok;
-                QString currentLoc = QString::fromStdString(log.location);
-                QString newLoc = QInputDialog::getText(this, "Relocate", "Enter new location:", QLineEdit::Normal, currentLoc, &ok);
-                
-                if (ok && !newLoc.isEmpty()) {
-                    log.location = newLoc.toStdString();
-                    repo.update(log);
-                    refreshModels();    
-                }
-            } });
+            auto logs = selectedItems<Log>(view, index);
+            relocatePopUp(logs, this); });
 
         contextMenu.exec(ui->logsTableView->viewport()->mapToGlobal(pos));
     }
@@ -330,37 +349,21 @@ void InventoryPage::cookiesCustomContextMenu(const QPoint &pos)
     QModelIndex index = ui->cookiesTableView->indexAt(pos);
     if (!index.isValid() || !ui->detailedViewCheckBox->isChecked())
         return;
+    QTableView *view = ui->cookiesTableView;
     QMenu contextMenu;
-    contextMenu.addAction("Dry Cookie", [this, index]()
+    contextMenu.addAction(forSelection(view, index, "Dry Cookie"), [view, index]()
                           {
-        int id = index.sibling(index.row(), 0).data().toInt();
-        auto cookie = QtSqlRepository<Cookie>::spawn().get(id);
-        if (cookie) { dryingPopUp(*cookie); refreshModels(); } });
+        auto cookies = selectedItems<Cookie>(view, index);
+        dryingPopUp(cookies); });
 
-    contextMenu.addAction("Scrap Cookie", [this, index]()
+    contextMenu.addAction(forSelection(view, index, "Scrap Cookie"), [this, view, index]()
                           {
-        int id = index.sibling(index.row(), 0).data().toInt();
-        auto cookie = QtSqlRepository<Cookie>::spawn().get(id);
-        if (cookie) { scrapPopUp(*cookie, this); refreshModels(); } });
+        scrapPopUp(selectedItems<Cookie>(view, index), this); });
 
-    contextMenu.addAction("Change Location", [this, index]()
+    contextMenu.addAction(forSelection(view, index, "Change Location"), [this, view, index]()
                           {
-        int cookieId = index.sibling(index.row(), 0).data().toInt();
-        auto repo = QtSqlRepository<Cookie>::spawn();
-        auto cookieOpt = repo.get(cookieId);
-    
-        if (cookieOpt) {
-            Cookie cookie = cookieOpt.value();
-            bool ok;
-            QString currentLoc = QString::fromStdString(cookie.location);
-            QString newLoc = QInputDialog::getText(this, "Relocate", "Enter new location:", QLineEdit::Normal, currentLoc, &ok);
-            
-            if (ok && !newLoc.isEmpty()) {
-                cookie.location = newLoc.toStdString();
-                repo.update(cookie);
-                refreshModels();    
-            }
-        } });
+        auto cookies = selectedItems<Cookie>(view, index);
+        relocatePopUp(cookies, this); });
 
     contextMenu.exec(ui->cookiesTableView->viewport()->mapToGlobal(pos));
 }
@@ -370,69 +373,27 @@ void InventoryPage::lumberCustomContextMenu(const QPoint &pos)
     QModelIndex index = ui->lumberTableView->indexAt(pos);
     if (!index.isValid() || !ui->detailedViewCheckBox->isChecked())
         return;
+    QTableView *view = ui->lumberTableView;
     QMenu contextMenu;
-    contextMenu.addAction("Dry Lumber", [this, index]()
+    contextMenu.addAction(forSelection(view, index, "Dry Lumber"), [view, index]()
                           {
-        int id = index.sibling(index.row(), 0).data().toInt();
-        auto lumber = QtSqlRepository<Lumber>::spawn().get(id);
-        if (lumber) { dryingPopUp(*lumber); refreshModels(); } });
+        auto boards = selectedItems<Lumber>(view, index);
+        dryingPopUp(boards); });
 
-    contextMenu.addAction("Scrap Lumber", [this, index]()
+    contextMenu.addAction(forSelection(view, index, "Scrap Lumber"), [this, view, index]()
                           {
-        int id = index.sibling(index.row(), 0).data().toInt();
-        auto lumber = QtSqlRepository<Lumber>::spawn().get(id);
-        if (lumber) { scrapPopUp(*lumber, this); refreshModels(); } });
+        scrapPopUp(selectedItems<Lumber>(view, index), this); });
 
     // Surface lumber
-    contextMenu.addAction("Surface Lumber", [this, index]()
+    contextMenu.addAction(forSelection(view, index, "Surface Lumber"), [view, index]()
                           {
-        int id = index.sibling(index.row(), 0).data().toInt();
-        auto lumber = QtSqlRepository<Lumber>::spawn().get(id);
-        if (lumber) {
-            auto toSurface = lumber.value();
-            std::vector<LumberSurfacing> allowed = allowedTransitions(toSurface.surfacing);
-            QDialog dialog;
-            dialog.setWindowTitle("Surface Lumber");
-            dialog.setModal(true);
-            dialog.setLayout(new QVBoxLayout());
-            dialog.setMinimumWidth(300);
-            QComboBox* comboBox = new QComboBox();
-            for (const auto& surf : allowed) {
-                comboBox->addItem(QString::fromStdString(toString(surf)), QVariant(static_cast<int>(surf)));
-            }
-            dialog.layout()->addWidget(comboBox);
-            QPushButton* confirmButton = new QPushButton("Confirm");
-            dialog.layout()->addWidget(confirmButton);
-            QPushButton* cancelButton = new QPushButton("Cancel");
-            dialog.layout()->addWidget(cancelButton);
-            QObject::connect(confirmButton, &QPushButton::clicked, [&dialog]() { dialog.accept(); });
-            QObject::connect(cancelButton, &QPushButton::clicked, [&dialog]() { dialog.reject(); });
-            if (dialog.exec() == QDialog::Accepted) {
-                LumberSurfacing selectedSurfacing = static_cast<LumberSurfacing>(comboBox->currentData().toInt());
-                toSurface.surfacing = selectedSurfacing;
-                QtSqlRepository<Lumber>::spawn().update(toSurface);
-                refreshModels();
-            }
-        } });
+        auto boards = selectedItems<Lumber>(view, index);
+        lumberSurfacingPopUp(boards); });
 
-    contextMenu.addAction("Change Location", [this, index]()
+    contextMenu.addAction(forSelection(view, index, "Change Location"), [this, view, index]()
                           {
-        int lumbId = index.sibling(index.row(), 0).data().toInt();
-        auto repo = QtSqlRepository<Lumber>::spawn();
-        auto lumbOpt = repo.get(lumbId);
-    
-        if (lumbOpt) {
-            Lumber lumber = lumbOpt.value();
-            bool ok;
-            QString currentLoc = QString::fromStdString(lumber.location);
-            QString newLoc = QInputDialog::getText(this, "Relocate", "Enter new location:", QLineEdit::Normal, currentLoc, &ok);
-            
-            if (ok && !newLoc.isEmpty()) {
-                lumber.location = newLoc.toStdString();
-                repo.update(lumber);
-                refreshModels();    
-            }
-        } });
+        auto boards = selectedItems<Lumber>(view, index);
+        relocatePopUp(boards, this); });
 
     contextMenu.exec(ui->lumberTableView->viewport()->mapToGlobal(pos));
 }
@@ -556,7 +517,9 @@ void InventoryPage::buildFilterWidgets()
     ui->lumberThicknessCombo->clear();
 
     // speciesComboBox has all the species in the database, pluas an "All" option that filters out nothing.
-    QStringList species = getUniqueSpecies(); // Doesn't have an "All" option
+    // Served from memory; Dictionaries keeps the distinct values up to date as items are written
+    auto &dictionaries = Dictionaries::instance();
+    QStringList species = dictionaries.values(Dictionaries::SPECIES); // Doesn't have an "All" option
     species.prepend("All");
     ui->logEntrySpeciesCombo->addItems(species);
     ui->logEntrySpeciesCombo->setCurrentIndex(0);
@@ -608,7 +571,7 @@ void InventoryPage::buildFilterWidgets()
         ui->firewoodSpeciesCombo->setCurrentIndex(0);
     }
 
-    QStringList dryings = getUniqueDryingOptions();
+    QStringList dryings = dictionaries.values(Dictionaries::DRYING);
     dryings.prepend("All");
     ui->logDryingComboBox->addItems(dryings);
     ui->cookieDryingCombo->addItems(dryings);
@@ -659,7 +622,7 @@ void InventoryPage::buildFilterWidgets()
 
     // Surfacing options for the slabs are different than the ones for the lumber
     ui->slabSurfacingCombo->addItem("All");
-    auto surfacings = getUniqueValuesOfColumn("display_slabs", "Surfacing");
+    auto surfacings = dictionaries.values(Dictionaries::SLAB_SURFACING);
     ui->slabSurfacingCombo->addItems(surfacings);
     if (surfacings.contains(oldSlabSurfacing))
     {
@@ -671,7 +634,7 @@ void InventoryPage::buildFilterWidgets()
     }
 
     ui->lumberSurfacingCombo->addItem("All");
-    auto lumberSurfacings = getUniqueValuesOfColumn("display_lumber", "Surfacing");
+    auto lumberSurfacings = dictionaries.values(Dictionaries::LUMBER_SURFACING);
     ui->lumberSurfacingCombo->addItems(lumberSurfacings);
     if (lumberSurfacings.contains(oldLumberSurfacing))
     {
@@ -684,7 +647,7 @@ void InventoryPage::buildFilterWidgets()
 
     // Since we're displaying lumber thickness in 'quarters'/4, we combo box it instead
     ui->lumberThicknessCombo->addItem("All");
-    auto thicknesses = getUniqueValuesOfColumn("display_lumber", "Thickness");
+    auto thicknesses = dictionaries.values(Dictionaries::LUMBER_THICKNESS);
     ui->lumberThicknessCombo->addItems(thicknesses);
     if (thicknesses.contains(oldLumberThickness))
     {
@@ -696,164 +659,191 @@ void InventoryPage::buildFilterWidgets()
     }
 
     // Unique locations for log entry
-    QStringList locations = getUniqueLocations();
+    QStringList locations = dictionaries.values(Dictionaries::LOCATIONS);
     ui->logEntryLocationCombo->addItems(locations);
 }
 
 void InventoryPage::refreshModels()
 {
-    QVector<FieldFilter> logFilters;
-    QVector<FieldFilter> cookieFilters;
-    QVector<FieldFilter> slabsFilter;
-    QVector<FieldFilter> lumberFilters;
-    QVector<FieldFilter> firewoodFilters;
+    refresh->dataChanged();
+}
 
-    if (ui->logSpeciesComboBox->currentText() != "All")
-    {
-        logFilters.push_back(FieldFilter().exact("species", ui->logSpeciesComboBox->currentText()));
-    }
+void InventoryPage::refreshTab(int tab)
+{
+    QWidget *page = ui->inventoryTabs->widget(tab);
+    QTableView *view = nullptr;
+    QString viewName;
+    QVector<FieldFilter> filters;
+    // Only the firewood tab has no detailed view
+    const QString grouping = ui->detailedViewCheckBox->isChecked() ? "" : "_grouped";
 
-    if (ui->logLengthMin->value() != 0 || ui->logLengthMax->value() != 0)
+    if (page == ui->logsTab)
     {
-        logFilters.push_back(FieldFilter().between(
-            "\"Length (ft)\"",
-            ui->logLengthMin->value(),
-            ui->logLengthMax->value()));
-    }
+        view = ui->logsTableView;
+        viewName = "display_logs" + grouping;
 
-    if (ui->logDiameterMin->value() != 0 || ui->logDiameterMax->value() != 0)
-    {
-        logFilters.push_back(FieldFilter().between(
-            "\"Diameter (in)\"",
-            ui->logDiameterMin->value(),
-            ui->logDiameterMax->value()));
-    }
+        if (ui->logSpeciesComboBox->currentText() != "All")
+        {
+            filters.push_back(FieldFilter().exact("species", ui->logSpeciesComboBox->currentText()));
+        }
 
-    if (ui->logDryingComboBox->currentText() != "All")
-    {
-        logFilters.push_back(FieldFilter().exact("drying", ui->logDryingComboBox->currentText()));
-    }
+        if (ui->logLengthMin->value() != 0 || ui->logLengthMax->value() != 0)
+        {
+            filters.push_back(FieldFilter().between(
+                "\"Length (ft)\"",
+                ui->logLengthMin->value(),
+                ui->logLengthMax->value()));
+        }
 
-    if (ui->cookiesSpeciesCombo->currentText() != "All")
-    {
-        cookieFilters.push_back(FieldFilter().exact("species", ui->cookiesSpeciesCombo->currentText()));
-    }
-    if (ui->cookieThicknessSpinBox->value() != 0 || ui->cookieThicknessMaxSpinBox->value() != 0)
-    {
-        cookieFilters.push_back(FieldFilter().between(
-            "\"Thickness (in)\"",
-            ui->cookieThicknessSpinBox->value(),
-            ui->cookieThicknessMaxSpinBox->value()));
-    }
-    if (ui->cookieDiameterMinSpinBox->value() != 0 || ui->cookieDiameterMaxSpinBox->value() != 0)
-    {
-        cookieFilters.push_back(FieldFilter().between(
-            "\"Diameter (in)\"",
-            ui->cookieDiameterMinSpinBox->value(),
-            ui->cookieDiameterMaxSpinBox->value()));
-    }
-    if (ui->cookieDryingCombo->currentText() != "All")
-    {
-        cookieFilters.push_back(FieldFilter().exact("drying", ui->cookieDryingCombo->currentText()));
-    }
+        if (ui->logDiameterMin->value() != 0 || ui->logDiameterMax->value() != 0)
+        {
+            filters.push_back(FieldFilter().between(
+                "\"Diameter (in)\"",
+                ui->logDiameterMin->value(),
+                ui->logDiameterMax->value()));
+        }
 
-    if (ui->slabsSpeciesCombo->currentText() != "All")
-    {
-        slabsFilter.push_back(FieldFilter().exact("species", ui->slabsSpeciesCombo->currentText()));
-    }
-    if (ui->slabLengthMin->value() != 0 || ui->slabLengthMax->value() != 0)
-    {
-        slabsFilter.push_back(FieldFilter().between(
-            "\"Length (in)\"",
-            ui->slabLengthMin->value(),
-            ui->slabLengthMax->value()));
-    }
-    if (ui->slabWidthMax->value() != 0 || ui->slabWidthMin->value() != 0)
-    {
-        slabsFilter.push_back(FieldFilter().between(
-            "\"Width (in)\"",
-            ui->slabWidthMin->value(),
-            ui->slabWidthMax->value()));
-    }
-    if (ui->slabThicknessMin->value() != 0 || ui->slabThicknessMax->value() != 0)
-    {
-        slabsFilter.push_back(FieldFilter().between(
-            "\"Thickness (in)\"",
-            ui->slabThicknessMin->value(),
-            ui->slabThicknessMax->value()));
-    }
-    if (ui->slabDryingCombo->currentText() != "All")
-    {
-        slabsFilter.push_back(FieldFilter().exact("drying", ui->slabDryingCombo->currentText()));
+        if (ui->logDryingComboBox->currentText() != "All")
+        {
+            filters.push_back(FieldFilter().exact("drying", ui->logDryingComboBox->currentText()));
+        }
     }
-    if (ui->slabSurfacingCombo->currentText() != "All")
+    else if (page == ui->cookiesTab)
     {
-        slabsFilter.push_back(FieldFilter().exact("surfacing", ui->slabSurfacingCombo->currentText()));
-    }
+        view = ui->cookiesTableView;
+        viewName = "display_cookies" + grouping;
 
-    if (ui->lumberSpeciesCombo->currentText() != "All")
-    {
-        lumberFilters.push_back(FieldFilter().exact("species", ui->lumberSpeciesCombo->currentText()));
-    }
-    if (ui->lumberLengthMin->value() != 0 || ui->lumberLengthMax->value() != 0)
-    {
-        lumberFilters.push_back(FieldFilter().between(
-            "\"Length (in)\"",
-            ui->lumberLengthMin->value(),
-            ui->lumberLengthMax->value()));
-    }
-    if (ui->lumberWidthMin->value() != 0 || ui->lumberWidthMax->value() != 0)
-    {
-        lumberFilters.push_back(FieldFilter().between(
-            "\"Width (in)\"",
-            ui->lumberWidthMin->value(),
-            ui->lumberWidthMax->value()));
-    }
-    if (ui->lumberThicknessCombo->currentText() != "All")
-    {
-        lumberFilters.push_back(FieldFilter().exact("thickness", ui->lumberThicknessCombo->currentText()));
+        if (ui->cookiesSpeciesCombo->currentText() != "All")
+        {
+            filters.push_back(FieldFilter().exact("species", ui->cookiesSpeciesCombo->currentText()));
+        }
+        if (ui->cookieThicknessSpinBox->value() != 0 || ui->cookieThicknessMaxSpinBox->value() != 0)
+        {
+            filters.push_back(FieldFilter().between(
+                "\"Thickness (in)\"",
+                ui->cookieThicknessSpinBox->value(),
+                ui->cookieThicknessMaxSpinBox->value()));
+        }
+        if (ui->cookieDiameterMinSpinBox->value() != 0 || ui->cookieDiameterMaxSpinBox->value() != 0)
+        {
+            filters.push_back(FieldFilter().between(
+                "\"Diameter (in)\"",
+                ui->cookieDiameterMinSpinBox->value(),
+                ui->cookieDiameterMaxSpinBox->value()));
+        }
+        if (ui->cookieDryingCombo->currentText() != "All")
+        {
+            filters.push_back(FieldFilter().exact("drying", ui->cookieDryingCombo->currentText()));
+        }
     }
-    if (ui->lumberDryingCombo->currentText() != "All")
+    else if (page == ui->slabsTab)
     {
-        lumberFilters.push_back(FieldFilter().exact("drying", ui->lumberDryingCombo->currentText()));
+        view = ui->slabsTableView;
+        viewName = "display_slabs" + grouping;
+
+        if (ui->slabsSpeciesCombo->currentText() != "All")
+        {
+            filters.push_back(FieldFilter().exact("species", ui->slabsSpeciesCombo->currentText()));
+        }
+        if (ui->slabLengthMin->value() != 0 || ui->slabLengthMax->value() != 0)
+        {
+            filters.push_back(FieldFilter().between(
+                "\"Length (in)\"",
+                ui->slabLengthMin->value(),
+                ui->slabLengthMax->value()));
+        }
+        if (ui->slabWidthMax->value() != 0 || ui->slabWidthMin->value() != 0)
+        {
+            filters.push_back(FieldFilter().between(
+                "\"Width (in)\"",
+                ui->slabWidthMin->value(),
+                ui->slabWidthMax->value()));
+        }
+        if (ui->slabThicknessMin->value() != 0 || ui->slabThicknessMax->value() != 0)
+        {
+            filters.push_back(FieldFilter().between(
+                "\"Thickness (in)\"",
+                ui->slabThicknessMin->value(),
+                ui->slabThicknessMax->value()));
+        }
+        if (ui->slabDryingCombo->currentText() != "All")
+        {
+            filters.push_back(FieldFilter().exact("drying", ui->slabDryingCombo->currentText()));
+        }
+        if (ui->slabSurfacingCombo->currentText() != "All")
+        {
+            filters.push_back(FieldFilter().exact("surfacing", ui->slabSurfacingCombo->currentText()));
+        }
     }
-    if (ui->lumberSurfacingCombo->currentText() != "All")
+    else if (page == ui->lumberTab)
     {
-        lumberFilters.push_back(FieldFilter().exact("surfacing", ui->lumberSurfacingCombo->currentText()));
-    }
+        view = ui->lumberTableView;
+        viewName = "display_lumber" + grouping;
 
-    if (ui->firewoodSpeciesCombo->currentText() != "All")
-    {
-        firewoodFilters.push_back(FieldFilter().exact("species", ui->firewoodSpeciesCombo->currentText()));
+        if (ui->lumberSpeciesCombo->currentText() != "All")
+        {
+            filters.push_back(FieldFilter().exact("species", ui->lumberSpeciesCombo->currentText()));
+        }
+        if (ui->lumberLengthMin->value() != 0 || ui->lumberLengthMax->value() != 0)
+        {
+            filters.push_back(FieldFilter().between(
+                "\"Length (in)\"",
+                ui->lumberLengthMin->value(),
+                ui->lumberLengthMax->value()));
+        }
+        if (ui->lumberWidthMin->value() != 0 || ui->lumberWidthMax->value() != 0)
+        {
+            filters.push_back(FieldFilter().between(
+                "\"Width (in)\"",
+                ui->lumberWidthMin->value(),
+                ui->lumberWidthMax->value()));
+        }
+        if (ui->lumberThicknessCombo->currentText() != "All")
+        {
+            filters.push_back(FieldFilter().exact("thickness", ui->lumberThicknessCombo->currentText()));
+        }
+        if (ui->lumberDryingCombo->currentText() != "All")
+        {
+            filters.push_back(FieldFilter().exact("drying", ui->lumberDryingCombo->currentText()));
+        }
+        if (ui->lumberSurfacingCombo->currentText() != "All")
+        {
+            filters.push_back(FieldFilter().exact("surfacing", ui->lumberSurfacingCombo->currentText()));
+        }
     }
-    if (ui->firewoodDryingCombo->currentText() != "All")
+    else if (page == ui->firewoodTab)
     {
-        firewoodFilters.push_back(FieldFilter().exact("drying", ui->firewoodDryingCombo->currentText()));
-    }
+        view = ui->firewoodTableView;
+        viewName = "display_firewood_grouped";
 
-    if (ui->detailedViewCheckBox->isChecked())
-    {
-        ui->logsTableView->setModel(makeFilteredModel("display_logs", logFilters, this));
-        ui->cookiesTableView->setModel(makeFilteredModel("display_cookies", cookieFilters, this));
-        ui->slabsTableView->setModel(makeFilteredModel("display_slabs", slabsFilter, this));
-        ui->lumberTableView->setModel(makeFilteredModel("display_lumber", lumberFilters, this));
+        if (ui->firewoodSpeciesCombo->currentText() != "All")
+        {
+            filters.push_back(FieldFilter().exact("species", ui->firewoodSpeciesCombo->currentText()));
+        }
+        if (ui->firewoodDryingCombo->currentText() != "All")
+        {
+            filters.push_back(FieldFilter().exact("drying", ui->firewoodDryingCombo->currentText()));
+        }
     }
     else
     {
-        ui->logsTableView->setModel(makeFilteredModel("display_logs_grouped", logFilters, this));
-        ui->cookiesTableView->setModel(makeFilteredModel("display_cookies_grouped", cookieFilters, this));
-        ui->slabsTableView->setModel(makeFilteredModel("display_slabs_grouped", slabsFilter, this));
-        ui->lumberTableView->setModel(makeFilteredModel("display_lumber_grouped", lumberFilters, this));
+        return;
     }
-    ui->firewoodTableView->setModel(makeFilteredModel("display_firewood_grouped", firewoodFilters, this));
-
-    ui->logsTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    ui->cookiesTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    ui->slabsTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    ui->lumberTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    ui->firewoodTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
 
-    buildFilterWidgets();
+    // Detailed views are filtered in memory; grouped views and anything the snapshot cannot answer go to SQLite
+    QAbstractItemModel *model = makeSnapshotModel(viewName, filters, this);
+    if (!model)
+    {
+        // The view's current model is about to be replaced, so its statement may be reused
+        model = makeFilteredModel(viewName, filters, this, dynamic_cast<QSqlQueryModel *>(view->model()));
+    }
+    QAbstractItemModel *previous = view->model();
+    QItemSelectionModel *previousSelection = view->selectionModel();
+    view->setModel(model);
+    view->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    // setModel leaves the replaced model and its selection model to us
+    delete previousSelection;
+    delete previous;
 }
 
 void InventoryPage::refreshTableViews()
@@ -1137,28 +1127,19 @@ void InventoryPage::onClearFiltersClicked()
     ui->lumberWidthMax->setValue(0);
     ui->firewoodSpeciesCombo->setCurrentIndex(0);
     ui->firewoodDryingCombo->setCurrentIndex(0);
-    refreshModels();
+    refresh->requestAll();
 }
 
 void InventoryPage::mousePressEvent(QMouseEvent *event)
 {
-    qDebug() << "InventoryPage clicked at:" << event->pos()
-             << "Mouse click on widgetAt:"
-             << QApplication::widgetAt(QCursor::pos());
+    WOODWORKS_LOG_TRACE("inventory", "mouse press", {{"x", event->pos().x()}, {"y", event->pos().y()}});
 
     QWidget::mousePressEvent(event);
 }
 
 bool InventoryPage::eventFilter(QObject *obj, QEvent *event)
 {
-    qDebug() << "EVENT TYPE:" << event->type()
-             << "on:" << obj->metaObject()->className()
-             << "named:" << obj->objectName();
-
-    if (event->type() == QEvent::MouseButtonPress)
-    {
-        qDebug() << "Mouse click intercepted on:" << obj->objectName();
-    }
+    WOODWORKS_LOG_TRACE("inventory", "event", {{"type", static_cast<int>(event->type())}, {"class", obj->metaObject()->className()}, {"name", obj->objectName()}});
 
     return QWidget::eventFilter(obj, event);
 }
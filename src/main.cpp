@@ -1,5 +1,6 @@
-#ifndef BUILDING_WOODWORKS_TEST
+#if !defined(BUILDING_WOODWORKS_TEST) && !defined(BUILDING_WOODWORKS_BENCHMARK)
 
+#include <cstdlib>
 #include <string>
 #include <iostream>
 #include <vector>
@@ -12,6 +13,7 @@
 #include <QSqlError>
 #include <QDir>
 #include <QSqlQuery>
+#include <QCommandLineParser>
 
 #include "mainwindow.hpp"
 
@@ -22,10 +24,15 @@
 #include "domain/cutlist.hpp"
 
 #include "infra/connection.hpp"
+#include "infra/entity_cache.hpp"
 #include "infra/repository.hpp"
 #include "infra/unit_of_work.hpp"
+#include "infra/logging.hpp"
+#include "infra/startup_timeline.hpp"
+#include "infra/legacy_import.hpp"
 
 #include "inventory.hpp"
+#include "widgets/TracingApplication.hpp"
 
 using qsd = QSqlDatabase;
 
@@ -49,38 +56,79 @@ public:
     }
 };
 
-int main(int argc, char *argv[])
+// Copies an old quarter-inch database into ours, checks the result and reports it on stderr
+int importLegacy(const QString &path)
 {
+    using namespace woodworks::infra;
+    auto &db = DbConnection::instance();
+    bool ok = true;
+    try
+    {
+        LegacyImportOptions options;
+        options.progress = [](const QString &table, size_t copied)
+        {
+            WOODWORKS_LOG_DEBUG("legacy", "batch", {{"table", table}, {"copied", copied}});
+        };
+        LegacyImporter::run(db, path, options);
+        for (const auto &check : LegacyImporter::verify(db, path))
+        {
+            ok = ok && check.ok();
+        }
+        WOODWORKS_LOG_INFO("legacy", ok ? "verified" : "verification failed", {{"path", path}});
+    }
+    catch (const std::exception &e)
+    {
+        WOODWORKS_LOG_ERROR("legacy", "import failed", {{"path", path}, {"error", e.what()}});
+        ok = false;
+    }
+    woodworks::infra::logging::Logger::instance().flush();
+    return ok ? 0 : 1;
+}
 
-    QApplication app(argc, argv);
+int main(int argc, char *argv[])
+{
 
-    // Mock open the types so that we ensure their tables + views are created
-    auto &debee = woodworks::infra::DbConnection::instance();
+    // Started first so the timeline covers QApplication's own setup
+    auto &timeline = woodworks::infra::StartupTimeline::instance();
+
+    // Tags the queries each click causes when SQL tracing is on
+    woodworks::widgets::TracingApplication app(argc, argv);
+    timeline.mark("application");
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption dbOption("db", "Database file, or :memory: for a throwaway in-memory one. Defaults to WOODWORKS_DB, then the saved setting, then woodworks.db.", "path");
+    QCommandLineOption templateOption("template", "With --db :memory:, start from a copy of this database.", "file");
+    QCommandLineOption importOption("import-legacy", "Import a database in the old quarter-inch schema, then exit. Rerun to resume.", "file");
+    parser.addOption(dbOption);
+    parser.addOption(templateOption);
+    parser.addOption(importOption);
+    parser.process(app);
+    if (parser.isSet(dbOption))
+    {
+        woodworks::infra::DbConnection::configure(parser.value(dbOption), parser.value(templateOption));
+    }
+    if (parser.isSet(importOption))
+    {
+        return importLegacy(parser.value(importOption));
+    }
 
-    // Delete all existing views
+    // Context menus and double clicks fetch the same rows repeatedly; WOODWORKS_ENTITY_CACHE_KB overrides the size
+    if (!std::getenv("WOODWORKS_ENTITY_CACHE_KB"))
     {
-        QSqlQuery query(debee);
-        query.exec("SELECT name FROM sqlite_master WHERE type='view'");
-        while (query.next())
-        {
-            QString viewName = query.value(0).toString();
-            QSqlQuery dropQuery(debee);
-            if (!dropQuery.exec(QString("DROP VIEW IF EXISTS %1").arg(viewName)))
-            {
-                qWarning() << "Failed to drop view" << viewName << ":" << dropQuery.lastError().text();
-            }
-        }
+        woodworks::infra::EntityCaches::setCapacity(4 * 1024 * 1024);
     }
 
-    woodworks::infra::QtSqlRepository<woodworks::domain::Log> logRepo(debee);
-    woodworks::infra::QtSqlRepository<woodworks::domain::Cookie> cookieRepo(debee);
-    woodworks::infra::QtSqlRepository<woodworks::domain::LiveEdgeSlab> liveEdgeSlabRepo(debee);
-    woodworks::infra::QtSqlRepository<woodworks::domain::Lumber> lumberRepo(debee);
-    woodworks::infra::QtSqlRepository<woodworks::domain::Firewood> firewoodRepo(debee);
-    woodworks::infra::QtSqlRepository<woodworks::domain::CustomCut> customCutRepo(debee);
+    // Opening the database brings its schema up to date; on a current database this runs no DDL
+    woodworks::infra::DbConnection::instance();
+    timeline.mark("database");
 
+    // Pages are built on first use, so this is only the landing window
     MainWindow window;
+    timeline.mark("main window");
     window.show();
+    timeline.mark("show");
+    // MainWindow marks the first paint and reports the timeline
 
     return app.exec();
 }
@@ -0,0 +1,660 @@
+#ifdef BUILDING_WOODWORKS_BENCHMARK
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QSqlQuery>
+#include <QSqlQueryModel>
+#include <QTemporaryDir>
+
+#include "domain/units.hpp"
+#include "domain/types.hpp"
+#include "domain/geometry_kernels.hpp"
+#include "domain/width_profile.hpp"
+#include "domain/slab_planner.hpp"
+#include "domain/lumber_cutter.hpp"
+#include "domain/log.hpp"
+#include "domain/cookie.hpp"
+#include "domain/live_edge_slab.hpp"
+#include "domain/lumber.hpp"
+#include "domain/firewood.hpp"
+#include "infra/connection.hpp"
+#include "infra/entity_cache.hpp"
+#include "infra/repository.hpp"
+#include "infra/unit_of_work.hpp"
+#include "infra/inventory_generator.hpp"
+#include "infra/inventory_snapshot.hpp"
+#include "infra/logging.hpp"
+#include "sales/generator.hpp"
+#include "csv_importer.hpp"
+
+using namespace woodworks::domain;
+using namespace woodworks::domain::imperial;
+using namespace woodworks::domain::types;
+using woodworks::infra::QtSqlRepository;
+using woodworks::infra::UnitOfWork;
+
+namespace
+{
+    // Keeps the optimizer from discarding benchmark results
+    volatile double sink = 0.0;
+
+    struct BenchResult
+    {
+        std::string name;
+        /** Rows per table the benchmark ran against; 0 when it does not touch the database. */
+        size_t scale;
+        size_t items;
+        double seconds;
+    };
+
+    std::vector<BenchResult> results;
+    size_t currentScale = 0;
+
+    // Runs `body` `repeats` times and records the best time
+    void bench(const std::string &name, size_t items, int repeats, const std::function<void()> &body)
+    {
+        double best = 1e300;
+        for (int r = 0; r < repeats; ++r)
+        {
+            auto start = std::chrono::steady_clock::now();
+            body();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+        results.push_back(BenchResult{name, currentScale, items, best});
+    }
+
+    void report()
+    {
+        std::printf("%-40s %10s %10s %12s %14s\n", "benchmark", "scale", "items", "ms", "ns/item");
+        for (const auto &result : results)
+        {
+            std::printf("%-40s %10zu %10zu %12.3f %14.2f\n", result.name.c_str(), result.scale, result.items, result.seconds * 1e3,
+                        result.seconds * 1e9 / static_cast<double>(std::max<size_t>(result.items, 1)));
+        }
+    }
+
+    std::string jsonString(const std::string &text)
+    {
+        std::string out = "\"";
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+            }
+            out += c;
+        }
+        return out + "\"";
+    }
+
+    // One object per result, so runs can be diffed or loaded by a regression check
+    bool writeJson(const std::string &path)
+    {
+        std::ofstream out(path);
+        if (!out)
+        {
+            return false;
+        }
+        out << "{\n  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const auto &result = results[i];
+            out << "    {\"name\": " << jsonString(result.name)
+                << ", \"scale\": " << result.scale
+                << ", \"items\": " << result.items
+                << ", \"seconds\": " << result.seconds
+                << ", \"ns_per_item\": " << result.seconds * 1e9 / static_cast<double>(std::max<size_t>(result.items, 1))
+                << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+        return static_cast<bool>(out);
+    }
+
+    // ---- Geometry: scalar forms as they were written before the kernels ----
+
+    void benchGeometry(size_t n)
+    {
+        std::mt19937 rng(42);
+        auto pick = [&](uint32_t low, uint32_t span)
+        { return Length::fromTicks(low + static_cast<uint32_t>(rng() % span)); };
+        geometry::BoardColumns boards;
+        geometry::LogColumns logs;
+        boards.reserve(n);
+        logs.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            boards.push(pick(16, 48), pick(64, 400), pick(960, 1000));
+            logs.push(pick(160, 400), pick(960, 1000));
+        }
+        const uint32_t diameter = 24 * 16;
+        std::vector<uint32_t> offsets(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            offsets[i] = pick(0, diameter + 1).toTicks();
+        }
+        std::vector<uint32_t> widths(n);
+        std::vector<double> out(n);
+
+        bench("chord width, scalar", n, 5, [&]()
+              {
+            for (size_t i = 0; i < n; ++i)
+            {
+                widths[i] = static_cast<uint32_t>(2 * std::sqrt(offsets[i] * (diameter - offsets[i])));
+            }
+            sink = widths[n / 2]; });
+        bench("chord width, batch", n, 5, [&]()
+              {
+            geometry::chordWidths(diameter, offsets.data(), n, widths.data());
+            sink = widths[n / 2]; });
+
+        bench("board feet, scalar", n, 5, [&]()
+              {
+            for (size_t i = 0; i < n; ++i)
+            {
+                Length t = Length::fromTicks(boards.thickness[i]);
+                Length w = Length::fromTicks(boards.width[i]);
+                Length l = Length::fromTicks(boards.length[i]);
+                out[i] = l.toFeet() * w.toFeet() * t.toFeet();
+            }
+            sink = out[n / 2]; });
+        bench("board feet, batch", n, 5, [&]()
+              {
+            geometry::boardFeet(boards, out.data());
+            sink = out[n / 2]; });
+
+        bench("cylinder volume, scalar", n, 5, [&]()
+              {
+            for (size_t i = 0; i < n; ++i)
+            {
+                Length d = Length::fromTicks(logs.diameter[i]);
+                Length l = Length::fromTicks(logs.length[i]);
+                out[i] = l.toFeet() * std::pow((d.toFeet() / 2), 2) * 3.14159;
+            }
+            sink = out[n / 2]; });
+        bench("cylinder volume, batch", n, 5, [&]()
+              {
+            geometry::cylinderCubicFeet(logs, out.data());
+            sink = out[n / 2]; });
+
+        std::vector<double> prices(n, 850.0);
+        geometry::boardFeet(boards, out.data());
+        std::vector<double> values(n);
+        bench("value total, batch", n, 5, [&]()
+              { sink = geometry::value(out.data(), prices.data(), n, values.data()); });
+    }
+
+    // ---- Slab planning: width queries, whole plans and undo/redo ----
+
+    void benchSlabPlanning(size_t n)
+    {
+        std::mt19937 rng(7);
+        const Length diameter = Length::fromInches(24);
+        const uint32_t d = diameter.toTicks();
+        std::vector<uint32_t> offsets(n);
+        std::vector<uint32_t> thicknesses(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            offsets[i] = static_cast<uint32_t>(rng() % (d + 1));
+            thicknesses[i] = 16 + static_cast<uint32_t>(rng() % 48);
+        }
+
+        bench("slab width, sqrt per query", n, 5, [&]()
+              {
+            uint64_t total = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                Length offset = Length::fromTicks(offsets[i]);
+                Length thickness = Length::fromTicks(thicknesses[i]);
+                Length near = geometry::chordWidth(diameter, offset);
+                total += offset + thickness > diameter ? near.toTicks()
+                                                       : ((near + geometry::chordWidth(diameter, offset + thickness)) / 2).toTicks();
+            }
+            sink = static_cast<double>(total); });
+        slabs::LogWidthProfile profile(diameter);
+        bench("slab width, profile", n, 5, [&]()
+              {
+            uint64_t total = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                total += profile.slabWidth(Length::fromTicks(offsets[i]), Length::fromTicks(thicknesses[i])).toTicks();
+            }
+            sink = static_cast<double>(total); });
+
+        Log log;
+        log.diameter = diameter;
+        log.length = Length::fromFeet(8);
+        slabs::SlabPlannerOptions options;
+        for (int quarters : {4, 6, 8, 12})
+        {
+            options.thicknesses.push_back(slabs::ThicknessOption{Length::fromQuarters(quarters), 800.0 + 50.0 * quarters});
+        }
+        options.minWidth = Length::fromInches(6);
+        slabs::SlabPlanner planner(options);
+        const size_t plans = 20;
+        bench("slab plan, 24\" log", plans, 3, [&]()
+              {
+            for (size_t i = 0; i < plans; ++i)
+            {
+                sink = planner.plan(log, Length::fromTicks(0), profile).front().score;
+            } });
+
+        slabs::SlabCutter cutter(log);
+        const size_t cycles = n / 100;
+        bench("slab cut/undo/redo cycle", cycles, 5, [&]()
+              {
+            for (size_t i = 0; i < cycles; ++i)
+            {
+                cutter.addSlab(Length::fromQuarters(8));
+                cutter.undoCut();
+                cutter.redoCut();
+                cutter.undoCut();
+            }
+            sink = cutter.slabWidthAtThickness(Length::fromQuarters(8)).toTicks(); });
+    }
+
+    // ---- Database: repositories, views, importer, sales page and cutters ----
+
+    // Pulls every row into the model, as scrolling a table view to the bottom would
+    int fetchAll(QSqlQueryModel *model)
+    {
+        while (model->canFetchMore())
+        {
+            model->fetchMore();
+        }
+        return model->rowCount();
+    }
+
+    void removeTagged(const QString &table)
+    {
+        QSqlQuery q(woodworks::infra::DbConnection::instance());
+        q.exec(QString("DELETE FROM %1 WHERE notes = 'bench'").arg(table));
+    }
+
+    void benchDatabase(size_t scale, const std::string &directory, woodworks::infra::InventoryGenerator &generator, std::mt19937 &rng)
+    {
+        currentScale = scale;
+        auto &db = woodworks::infra::DbConnection::instance();
+        QtSqlRepository<Log> logRepo(db);
+        QtSqlRepository<Cookie> cookieRepo(db);
+        QtSqlRepository<LiveEdgeSlab> slabRepo(db);
+        QtSqlRepository<Lumber> lumberRepo(db);
+        QtSqlRepository<Firewood> firewoodRepo(db);
+        const size_t ops = std::min<size_t>(scale, 1000);
+
+        std::vector<int> ids(ops);
+        for (auto &id : ids)
+        {
+            id = 1 + static_cast<int>(rng() % scale);
+        }
+        bench("repo get, logs", ops, 3, [&]()
+              {
+            size_t found = 0;
+            for (int id : ids)
+            {
+                found += logRepo.get(id).has_value();
+            }
+            sink = static_cast<double>(found); });
+        // The same lookups served by the identity map after the first pass
+        woodworks::infra::EntityCaches::setCapacity(16 * 1024 * 1024);
+        bench("repo get, logs (cached)", ops, 3, [&]()
+              {
+            size_t found = 0;
+            for (int id : ids)
+            {
+                found += logRepo.get(id).has_value();
+            }
+            sink = static_cast<double>(found); });
+        // A notes edit writes one column when the cache holds the stored row, every column otherwise
+        auto editNotes = [&]()
+        {
+            for (int id : ids)
+            {
+                if (auto log = logRepo.get(id))
+                {
+                    log->notes = log->notes == "edited" ? "" : "edited";
+                    logRepo.update(*log);
+                }
+            }
+        };
+        bench("repo update notes, logs (partial)", ops, 3, editNotes);
+        woodworks::infra::EntityCaches::setCapacity(0);
+        bench("repo update notes, logs (full)", ops, 3, editNotes);
+
+        bench("repo list, logs", scale, 3, [&]()
+              { sink = static_cast<double>(logRepo.list().size()); });
+        bench("repo list, cookies", scale, 3, [&]()
+              { sink = static_cast<double>(cookieRepo.list().size()); });
+        bench("repo list, slabs", scale, 3, [&]()
+              { sink = static_cast<double>(slabRepo.list().size()); });
+        bench("repo list, lumber", scale, 3, [&]()
+              { sink = static_cast<double>(lumberRepo.list().size()); });
+        bench("repo list, firewood", scale, 3, [&]()
+              { sink = static_cast<double>(firewoodRepo.list().size()); });
+        bench("repo forEach, slabs", scale, 3, [&]()
+              {
+            double area = 0.0;
+            slabRepo.forEach([&area](const LiveEdgeSlab &s)
+                             { area += s.width.toInches() * s.length.toInches(); });
+            sink = area; });
+        bench("repo filter, slabs by species", scale, 3, [&]()
+              { sink = static_cast<double>(slabRepo.filter([](const LiveEdgeSlab &s)
+                                                        { return s.species.name == "Walnut"; })
+                                               .size()); });
+
+        bench("repo add/update/remove, logs", ops, 1, [&]()
+              {
+            UnitOfWork uow(db);
+            std::vector<Log> added;
+            added.reserve(ops);
+            for (size_t i = 0; i < ops; ++i)
+            {
+                Log log = generator.makeLog();
+                log.notes = "bench";
+                log.id = Id{logRepo.add(log)};
+                added.push_back(log);
+            }
+            for (auto &log : added)
+            {
+                log.location = "Shop";
+                logRepo.update(log);
+            }
+            for (const auto &log : added)
+            {
+                logRepo.remove(log.id.id);
+            }
+            uow.commit(); });
+
+        QVector<woodworks::infra::FieldFilter> slabFilters{
+            woodworks::infra::FieldFilter().exact("Species", QString("Walnut")),
+            woodworks::infra::FieldFilter().between("\"Width (in)\"", 12, 30)};
+        bench("filtered model, slabs", scale, 3, [&]()
+              {
+            QSqlQueryModel *model = woodworks::infra::makeFilteredModel("display_slabs", slabFilters);
+            sink = fetchAll(model);
+            delete model; });
+        // Loaded outside the timing, as the inventory page does on its first refresh
+        woodworks::infra::InventorySnapshots::instance().get("display_slabs");
+        bench("snapshot filter, slabs", scale, 3, [&]()
+              {
+            auto *model = woodworks::infra::makeSnapshotModel("display_slabs", slabFilters);
+            sink = model ? model->rowCount() : -1.0;
+            delete model; });
+        for (const char *view : {"display_logs_grouped", "display_slabs_grouped", "display_lumber_grouped", "display_firewood_grouped"})
+        {
+            bench(std::string("grouped view, ") + view, scale, 3, [&]()
+                  {
+                QSqlQueryModel *model = woodworks::infra::makeViewModel(view, nullptr);
+                sink = fetchAll(model);
+                delete model; });
+        }
+
+        // The importer commits row by row, so it gets a smaller file
+        const size_t importRows = std::min<size_t>(scale, 500);
+        const std::string csv = directory + "/logs.csv";
+        {
+            std::ofstream out(csv);
+            out << "ID,Length,Diameter,Species,Quality,Drying,Cost,Location,Notes\n";
+            for (size_t i = 0; i < importRows; ++i)
+            {
+                Log log = generator.makeLog();
+                out << i << "," << log.length.toTicks() / 192 << "'" << (log.length.toTicks() % 192) / 16 << ","
+                    << log.diameter.toTicks() / 16 << "," << log.species.name << "," << log.quality.value << ","
+                    << "Kiln Dried," << log.cost.cents / 100 << "," << log.location << ",bench\n";
+            }
+        }
+        bench("importer, logs", importRows, 1, [&]()
+              { Importer().importLogs(csv); });
+        removeTagged("logs");
+
+        std::vector<LiveEdgeSlab> slabList = slabRepo.list();
+        std::vector<Lumber> lumberList = lumberRepo.list();
+        bench("sales page, slabs + lumber", slabList.size() + lumberList.size(), 3, [&]()
+              {
+            woodworks::sales::SalesPageGenerator page;
+            for (auto &slab : slabList)
+            {
+                page.addProduct(slab.toProduct());
+            }
+            for (auto &board : lumberList)
+            {
+                page.addProduct(board.toProduct());
+            }
+            sink = static_cast<double>(page.generate().size()); });
+
+        // Cutters write through the repositories, so each run uses fresh tagged rows
+        const size_t cuts = std::min<size_t>(scale, 50);
+        std::vector<Log> cutLogs;
+        {
+            UnitOfWork uow(db);
+            for (size_t i = 0; i < cuts; ++i)
+            {
+                Log log = generator.makeLog();
+                log.notes = "bench";
+                log.id = Id{logRepo.add(log)};
+                cutLogs.push_back(log);
+            }
+            uow.commit();
+        }
+        slabs::SlabPlannerOptions planOptions;
+        planOptions.thicknesses = {{Length::fromQuarters(8), 1.0}, {Length::fromQuarters(12), 1.0}};
+        planOptions.minWidth = Length::fromInches(8);
+        planOptions.objective = slabs::PlanObjective::YIELD;
+        planOptions.maxPlans = 1;
+        std::vector<LiveEdgeSlab> cutSlabs;
+        bench("slab cutter, plan + complete", cuts, 1, [&]()
+              {
+            UnitOfWork uow(db);
+            for (const auto &log : cutLogs)
+            {
+                slabs::SlabCutter cutter(log);
+                auto plans = slabs::SlabPlanner(planOptions).plan(cutter);
+                if (!plans.empty())
+                {
+                    plans.front().applyTo(cutter);
+                    for (auto &slab : cutter.completeCuts(Length::fromFeet(4), std::nullopt, std::string("bench")))
+                    {
+                        cutSlabs.push_back(slab);
+                    }
+                }
+            }
+            uow.commit(); });
+        bench("lumber cutter, rip + finalize", cutSlabs.size(), 1, [&]()
+              {
+            UnitOfWork uow(db);
+            for (const auto &slab : cutSlabs)
+            {
+                lumber::LumberCutter cutter(slab);
+                cutter.setTrimWidth(Length::fromInches(0.5));
+                cutter.setBoardWidth(Length::fromInches(4));
+                cutter.planCuts();
+                cutter.finalizeCuts(std::nullopt, std::string("bench"));
+            }
+            uow.commit(); });
+        for (const char *table : {"logs", "live_edge_slabs", "lumber"})
+        {
+            removeTagged(table);
+        }
+    }
+
+    // `Woodworks_bench generate PATH ...` fills PATH, or PATH/woodworks.db if it is a directory, with synthetic inventory
+    int runGenerator(int argc, char *argv[])
+    {
+        if (argc < 3)
+        {
+            std::fprintf(stderr, "usage: %s generate PATH [--rows N] [--seed S] [--lineage N] [--images BYTES] [--batch N]\n", argv[0]);
+            return 1;
+        }
+        size_t rows = 10000;
+        uint32_t seed = 1;
+        std::optional<size_t> lineage;
+        size_t imageBytes = 0;
+        size_t batch = 10000;
+        for (int i = 3; i + 1 < argc; i += 2)
+        {
+            std::string arg = argv[i];
+            size_t value = std::stoul(argv[i + 1]);
+            if (arg == "--rows")
+                rows = value;
+            else if (arg == "--seed")
+                seed = static_cast<uint32_t>(value);
+            else if (arg == "--lineage")
+                lineage = value;
+            else if (arg == "--images")
+                imageBytes = value;
+            else if (arg == "--batch")
+                batch = value;
+            else
+            {
+                std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+                return 1;
+            }
+        }
+
+        QFileInfo target(QString::fromLocal8Bit(argv[2]));
+        if (target.isDir())
+        {
+            target = QFileInfo(QDir(target.filePath()), "woodworks.db");
+        }
+        if (!QDir().mkpath(target.absolutePath()))
+        {
+            std::fprintf(stderr, "could not use directory %s\n", target.absolutePath().toLocal8Bit().constData());
+            return 1;
+        }
+        woodworks::infra::DbConnection::configure(target.absoluteFilePath());
+
+        auto options = woodworks::infra::GeneratorOptions::uniform(rows);
+        if (lineage)
+        {
+            options.lineageLogs = *lineage;
+        }
+        options.imageBytes = imageBytes;
+        options.batchSize = batch;
+
+        auto stats = woodworks::infra::InventoryGenerator(seed).generate(options);
+        std::printf("logs %zu, slabs %zu, lumber %zu, cookies %zu, firewood %zu, custom cuts %zu\n",
+                    stats.logs, stats.slabs, stats.lumber, stats.cookies, stats.firewood, stats.customCuts);
+        std::printf("%zu rows in %.2f s (%.0f rows/s)\n", stats.total(), stats.seconds,
+                    static_cast<double>(stats.total()) / std::max(stats.seconds, 1e-9));
+        return 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    if (argc > 1 && std::string(argv[1]) == "generate")
+    {
+        return runGenerator(argc, argv);
+    }
+
+    size_t n = 1000000;
+    std::vector<size_t> scales{1000, 10000, 100000};
+    std::string jsonPath;
+    bool verbose = false;
+    // In memory unless asked otherwise, so runs are hermetic and measure SQLite rather than the disk
+    QString database = woodworks::infra::DbConnection::IN_MEMORY;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--items" && i + 1 < argc)
+        {
+            n = std::stoul(argv[++i]);
+        }
+        else if (arg == "--scales" && i + 1 < argc)
+        {
+            scales.clear();
+            std::stringstream list(argv[++i]);
+            for (std::string item; std::getline(list, item, ',');)
+            {
+                if (!item.empty())
+                {
+                    scales.push_back(std::stoul(item));
+                }
+            }
+        }
+        else if (arg == "--json" && i + 1 < argc)
+        {
+            jsonPath = argv[++i];
+        }
+        else if (arg == "--verbose")
+        {
+            verbose = true;
+        }
+        else if (arg == "--db" && i + 1 < argc)
+        {
+            database = QString::fromLocal8Bit(argv[++i]);
+        }
+        else if (!arg.empty() && std::isdigit(static_cast<unsigned char>(arg[0])))
+        {
+            n = std::stoul(arg);
+        }
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--items N] [--scales 1000,10000,...] [--json FILE] [--db PATH|:memory:] [--verbose]\n"
+                                 "       %s generate PATH [--rows N] [--seed S] [--lineage N] [--images BYTES] [--batch N]\n",
+                         argv[0], argv[0]);
+            return 1;
+        }
+    }
+
+    // The repositories and cutters log every statement at debug level
+    using woodworks::infra::logging::Level;
+    woodworks::infra::logging::Logger::instance().setLevel(verbose ? Level::Debug : Level::Warn);
+
+    benchGeometry(n);
+    benchSlabPlanning(n);
+
+    if (!scales.empty())
+    {
+        // Holds the CSV export; the database is wherever --db says
+        QTemporaryDir directory;
+        if (!directory.isValid())
+        {
+            std::fprintf(stderr, "could not create a scratch directory\n");
+            return 1;
+        }
+        woodworks::infra::DbConnection::configure(database);
+        std::sort(scales.begin(), scales.end());
+        woodworks::infra::InventoryGenerator generator(2024);
+        std::mt19937 rng(2024);
+        size_t seeded = 0;
+        for (size_t scale : scales)
+        {
+            // Grow every table to the next scale
+            auto options = woodworks::infra::GeneratorOptions::uniform(scale - seeded);
+            options.lineageLogs = 0;
+            currentScale = scale;
+            auto stats = generator.generate(options);
+            results.push_back(BenchResult{"generator, seed rows", scale, stats.total(), stats.seconds});
+            seeded = scale;
+            benchDatabase(scale, directory.path().toStdString(), generator, rng);
+        }
+    }
+
+    woodworks::infra::logging::Logger::instance().flush();
+    report();
+    if (!jsonPath.empty() && !writeJson(jsonPath))
+    {
+        std::fprintf(stderr, "could not write %s\n", jsonPath.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+#endif
@@ -1,15 +1,32 @@
 #ifdef BUILDING_WOODWORKS_TEST
 
+#include <algorithm>
 #include <cassert>
 #include <optional>
 #include <stdio.h>
+#include <QTemporaryDir>
 #include "domain/log.hpp"
 #include "domain/cookie.hpp"
 #include "domain/live_edge_slab.hpp"
 #include "domain/lumber.hpp"
+#include "domain/firewood_bundle.hpp"
+#include "domain/slab_planner.hpp"
+#include "domain/nesting.hpp"
+#include "domain/rip_planner.hpp"
+#include "domain/yard_planner.hpp"
+#include "domain/geometry_kernels.hpp"
 #include "infra/repository.hpp"
 #include "infra/unit_of_work.hpp"
 #include "infra/connection.hpp"
+#include "infra/entity_cache.hpp"
+#include "infra/logging.hpp"
+#include "infra/migrations.hpp"
+#include "infra/dictionaries.hpp"
+#include "infra/inventory_snapshot.hpp"
+#include "infra/name_table.hpp"
+#include "infra/legacy_import.hpp"
+#include "infra/startup_timeline.hpp"
+#include "infra/sql_trace.hpp"
 #include "infra/mappers/log_mapper.hpp"
 #include "infra/mappers/cookie_mapper.hpp"
 #include "infra/mappers/live_edge_slab_mapper.hpp"
@@ -22,7 +39,194 @@ using namespace woodworks::infra;
 
 int main(int argc, char *argv[])
 {
+    // A fresh in-memory database, so runs neither touch nor depend on woodworks.db
+    DbConnection::configure(DbConnection::IN_MEMORY);
     auto &db = DbConnection::instance();
+
+    // Opening the connection migrated it; migrating again is a no-op
+    assert(SchemaMigrator::currentVersion(db) == SchemaMigrator::latestVersion());
+    assert(SchemaMigrator::migrate(db).applied == 0);
+
+    // Migration 5 moves existing names into the interned tables, keeping ids, views and the id counter
+    {
+        QSqlDatabase old = QSqlDatabase::addDatabase("QSQLITE", "migration_test");
+        old.setDatabaseName(DbConnection::IN_MEMORY);
+        assert(old.open() && SchemaMigrator::migrate(old, 4).toVersion == 4);
+        QSqlQuery q(old);
+        assert(q.exec("INSERT INTO logs (species, length, diameter, quality, drying, cost, location, notes) VALUES "
+                      "('Oak', 1920, 192, 4, 0, 5000, 'Barn', 'First'), ('Maple', 960, 160, 3, 1, 2500, '', NULL), "
+                      "('Oak', 480, 128, 2, 2, 1000, 'Shed', NULL)"));
+        // The deleted log leaves the AUTOINCREMENT counter above the largest id
+        assert(q.exec("DELETE FROM logs WHERE id = 3"));
+        assert(q.exec("INSERT INTO cookies (species, length, diameter, drying, worth, location) VALUES ('Walnut', 32, 192, 0, 800, 'Barn')"));
+        auto upgraded = SchemaMigrator::migrate(old);
+        assert(upgraded.fromVersion == 4 && upgraded.applied == 1 && upgraded.toVersion == SchemaMigrator::latestVersion());
+
+        assert(q.exec("SELECT (SELECT COUNT(*) FROM species), (SELECT COUNT(*) FROM storage_bins)") && q.next());
+        assert(q.value(0).toInt() == 3 && q.value(1).toInt() == 1);
+        assert(q.exec("SELECT l.id, s.name, b.name FROM logs l JOIN species s ON s.id = l.species_id "
+                      "LEFT JOIN storage_bins b ON b.id = l.location_id ORDER BY l.id"));
+        assert(q.next() && q.value(0).toInt() == 1 && q.value(1).toString() == "Oak" && q.value(2).toString() == "Barn");
+        assert(q.next() && q.value(0).toInt() == 2 && q.value(1).toString() == "Maple" && q.value(2).isNull() && !q.next());
+        assert(QtSqlRepository<Cookie>(old).get(1)->species.name == "Walnut");
+
+        // Every key points at a row, and the rebuilt tables declare their foreign keys
+        assert(q.exec("PRAGMA foreign_key_check") && !q.next());
+        assert(q.exec("SELECT COUNT(*) FROM pragma_foreign_key_list('logs') WHERE \"table\" IN ('species', 'storage_bins')") && q.next() && q.value(0).toInt() == 2);
+        assert(q.exec("SELECT COUNT(*) FROM sqlite_master WHERE name = 'idx_logs_species_length' AND sql LIKE '%species_id%'") && q.next() && q.value(0).toInt() == 1);
+
+        // The views read the names back through the keys
+        assert(q.exec("SELECT Species, Location FROM display_logs WHERE ID = 1") && q.next());
+        assert(q.value(0).toString() == "Oak" && q.value(1).toString() == "Barn");
+        assert(q.exec("SELECT COUNT(*) FROM display_logs") && q.next() && q.value(0).toInt() == 2);
+
+        // New rows continue after the deleted one, not over it
+        assert(q.exec("SELECT seq FROM sqlite_sequence WHERE name = 'logs'") && q.next() && q.value(0).toInt() == 3);
+        q.finish();
+        Log later = Log::uninitialized();
+        later.species = Species{"Oak"};
+        later.length = Length::fromFeet(4);
+        later.diameter = Length::fromInches(10);
+        later.quality = Quality{3};
+        assert(QtSqlRepository<Log>(old).add(later) == 4);
+        old.close();
+    }
+    QSqlDatabase::removeDatabase("migration_test");
+
+    // The database cannot be swapped once it is open
+    bool locked = false;
+    try
+    {
+        DbConnection::configure("elsewhere.db");
+    }
+    catch (const std::runtime_error &)
+    {
+        locked = true;
+    }
+    assert(locked && DbConnection::path() == DbConnection::IN_MEMORY);
+
+    // Legacy import refuses a file that is not in the old schema, such as our own
+    bool rejected = false;
+    try
+    {
+        LegacyImporter::run(db, db.databaseName());
+    }
+    catch (const std::runtime_error &)
+    {
+        rejected = true;
+    }
+    assert(rejected);
+
+    // Legacy import: a small file in the old schema converts, keeps lineage, resumes and verifies
+    {
+        QTemporaryDir legacyDir;
+        assert(legacyDir.isValid());
+        const QString legacyPath = legacyDir.filePath("legacy.db");
+        {
+            QSqlDatabase legacy = QSqlDatabase::addDatabase("QSQLITE", "legacy_fixture");
+            legacy.setDatabaseName(legacyPath);
+            assert(legacy.open());
+            const char *const fixture[] = {
+                // Tables as in schema_dump.sql
+                "CREATE TABLE storage_bins (name TEXT PRIMARY KEY NOT NULL UNIQUE, notes TEXT)",
+                "CREATE TABLE logs (id integer PRIMARY KEY AUTOINCREMENT, species varchar NOT NULL, len_quarters int NOT NULL CHECK ((len_quarters > 0)), diameter_quarters int NOT NULL CHECK ((diameter_quarters > 0)), cost_cents_quarters int NOT NULL CHECK ((cost_cents_quarters > 0)), quality INTEGER CHECK ((quality BETWEEN 1 AND 5)), location TEXT REFERENCES storage_bins (name), notes TEXT, media BLOB, scrapped INTEGER NOT NULL DEFAULT (0), drying INTEGER NOT NULL DEFAULT (3))",
+                "CREATE TABLE cookies (id INTEGER PRIMARY KEY AUTOINCREMENT UNIQUE NOT NULL, from_log INTEGER NOT NULL REFERENCES logs (id), species TEXT NOT NULL, thickness_quarters INTEGER CHECK ((thickness_quarters > 0)) NOT NULL, diameter_quarters INTEGER NOT NULL CHECK ((diameter_quarters > 0)), drying INTEGER NOT NULL CHECK ((drying BETWEEN 0 AND 3)), location TEXT REFERENCES storage_bins (name), notes TEXT, media BLOB)",
+                "CREATE TABLE custom_cuts (id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL UNIQUE, from_log INTEGER REFERENCES logs (id) NOT NULL, len_quarters INTEGER NOT NULL CHECK (len_quarters > 0))",
+                "CREATE TABLE partial_cuts (id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL UNIQUE, from_log INTEGER REFERENCES logs (id) NOT NULL, len_quarters INTEGER NOT NULL CHECK ((len_quarters > 0)), type TEXT NOT NULL, num_products_made INTEGER NOT NULL DEFAULT ((1)))",
+                "CREATE TABLE slabs (id INTEGER PRIMARY KEY AUTOINCREMENT UNIQUE NOT NULL, from_log INTEGER REFERENCES logs (id), species TEXT NOT NULL, thickness_eights INTEGER CHECK ((thickness_eights > 0)) NOT NULL, len_quarters INTEGER NOT NULL CHECK ((len_quarters > 0)), drying INTEGER NOT NULL CHECK ((drying BETWEEN 0 AND 3)), smoothed INTEGER CHECK ((smoothed BETWEEN 0 AND 1)) NOT NULL, location TEXT REFERENCES storage_bins (name), notes TEXT, media BLOB, cut INTEGER REFERENCES partial_cuts (id), width_eights INTEGER NOT NULL DEFAULT (1))",
+                "CREATE TABLE lumber (id INTEGER NOT NULL UNIQUE PRIMARY KEY AUTOINCREMENT, from_log INTEGER REFERENCES logs (id) NOT NULL, species TEXT NOT NULL, len_inches INTEGER NOT NULL CHECK ((len_inches > 0)), width_quarters INTEGER NOT NULL CHECK ((width_quarters > 0)), thickness_quarters INTEGER NOT NULL CHECK ((thickness_quarters > 0)), drying INTEGER NOT NULL DEFAULT Wet, surfacing INTEGER NOT NULL CHECK ((drying BETWEEN 0 AND 4)) DEFAULT (0), location TEXT REFERENCES storage_bins (name), notes TEXT, media BLOB, cut INTEGER REFERENCES partial_cuts (id) NOT NULL)",
+                "CREATE TABLE firewood (id INTEGER PRIMARY KEY AUTOINCREMENT UNIQUE NOT NULL, from_log INTEGER REFERENCES logs (id) NOT NULL, species TEXT NOT NULL, drying INTEGER NOT NULL CHECK ((drying BETWEEN 0 AND 3)), feet_3 INTEGER CHECK ((feet_3 >= 0)) NOT NULL, location varchar REFERENCES storage_bins (name), notes TEXT, media BLOB, taken_len_quarters INTEGER NOT NULL)",
+                "CREATE TABLE cutlist (id INTEGER PRIMARY KEY AUTOINCREMENT UNIQUE NOT NULL, project TEXT NOT NULL DEFAULT General, part TEXT, code TEXT, cut INTEGER REFERENCES custom_cuts (id), quantity INTEGER NOT NULL DEFAULT (1) CHECK ((quantity > 0)), t INTEGER NOT NULL CHECK ((t > 0)), w INTEGER NOT NULL CHECK ((w > 0)), l INTEGER NOT NULL CHECK ((l > 0)), required_t_eigths INTEGER, required_w_eights INTEGER, required_l_eights INTEGER NOT NULL, species TEXT, progress_rough INTEGER, progress_finished, notes TEXT)",
+                // A 10" oak log with 2" left after its cuts, a scrapped log and one cut to nothing
+                "INSERT INTO storage_bins (name) VALUES ('Barn')",
+                "INSERT INTO logs (id, species, len_quarters, diameter_quarters, cost_cents_quarters, quality, location, media, drying) VALUES (1, 'Oak', 40, 48, 50, 4, 'Barn', X'01020304', 0)",
+                "INSERT INTO logs (id, species, len_quarters, diameter_quarters, cost_cents_quarters, scrapped) VALUES (2, 'Maple', 20, 40, 10, 1)",
+                "INSERT INTO logs (id, species, len_quarters, diameter_quarters, cost_cents_quarters) VALUES (3, 'Cherry', 8, 32, 10)",
+                "INSERT INTO cookies (id, from_log, species, thickness_quarters, diameter_quarters, drying, location, media) VALUES (1, 1, 'Oak', 4, 48, 0, 'Barn', X'AABB')",
+                "INSERT INTO custom_cuts (id, from_log, len_quarters) VALUES (1, 1, 8)",
+                "INSERT INTO custom_cuts (id, from_log, len_quarters) VALUES (2, 3, 8)",
+                "INSERT INTO partial_cuts (id, from_log, len_quarters, type, num_products_made) VALUES (1, 1, 12, 'SLAB', 2)",
+                "INSERT INTO partial_cuts (id, from_log, len_quarters, type) VALUES (2, 1, 4, 'LUMBER')",
+                "INSERT INTO slabs (id, from_log, species, thickness_eights, len_quarters, drying, smoothed, cut, width_eights) VALUES (1, 1, 'Oak', 16, 12, 1, 1, 1, 80)",
+                "INSERT INTO slabs (id, from_log, species, thickness_eights, len_quarters, drying, smoothed, cut, width_eights) VALUES (2, 1, 'Oak', 16, 12, 1, 0, 1, 72)",
+                "INSERT INTO lumber (id, from_log, species, len_inches, width_quarters, thickness_quarters, drying, surfacing, cut) VALUES (1, 1, 'Oak', 3, 16, 4, 2, 4, 2)",
+                "INSERT INTO firewood (id, from_log, species, drying, feet_3, taken_len_quarters) VALUES (1, 1, 'Oak', 2, 5, 4)",
+                "INSERT INTO cutlist (id, project, part, code, cut, quantity, t, w, l, required_l_eights, species) VALUES (1, 'Table', 'Leg', 'L1', 1, 4, 16, 16, 240, 240, 'Oak')",
+            };
+            for (const char *statement : fixture)
+            {
+                assert(QSqlQuery(legacy).exec(statement));
+            }
+            legacy.close();
+        }
+        QSqlDatabase::removeDatabase("legacy_fixture");
+
+        QSqlDatabase imported = QSqlDatabase::addDatabase("QSQLITE", "legacy_import_test");
+        imported.setDatabaseName(DbConnection::IN_MEMORY);
+        assert(imported.open() && SchemaMigrator::migrate(imported).toVersion == SchemaMigrator::latestVersion());
+
+        // Stop after the first slab is committed, as a crash would
+        struct Interrupted
+        {
+        };
+        LegacyImportOptions interrupt;
+        interrupt.batchSize = 1;
+        interrupt.progress = [](const QString &target, size_t)
+        {
+            if (target == "live_edge_slabs")
+            {
+                throw Interrupted{};
+            }
+        };
+        bool interrupted = false;
+        try
+        {
+            LegacyImporter::run(imported, legacyPath, interrupt);
+        }
+        catch (const Interrupted &)
+        {
+            interrupted = true;
+        }
+        assert(interrupted);
+        LegacyImportOptions resume;
+        resume.batchSize = 1;
+        auto reports = LegacyImporter::run(imported, legacyPath, resume);
+        assert(reports.size() == 6 && reports[0].target == "logs" && reports[2].target == "live_edge_slabs");
+        assert(reports[0].resumed && reports[0].batches == 0 && reports[0].copied == 1 && reports[0].skipped == 2);
+        assert(reports[2].resumed && reports[2].copied == 2 && reports[3].copied == 1 && !reports[3].resumed);
+        for (const auto &report : LegacyImporter::run(imported, legacyPath))
+        {
+            assert(report.resumed && report.batches == 0);
+        }
+
+        // Quarter and eighth inches become 1/16" ticks; the log keeps only what its cuts left
+        auto oak = QtSqlRepository<Log>(imported).get(1);
+        assert(oak && oak->species.name == "Oak" && oak->location == "Barn" && oak->imageBuffer.size() == 4);
+        assert(oak->length == Length::fromQuarters(8) && oak->diameter == Length::fromQuarters(48) && oak->cost.toCents() == 400);
+        assert(!QtSqlRepository<Log>(imported).get(2) && !QtSqlRepository<Log>(imported).get(3));
+        auto importedSlab = QtSqlRepository<LiveEdgeSlab>(imported).get(1);
+        assert(importedSlab && importedSlab->thickness == Length::fromInches(2) && importedSlab->width == Length::fromInches(10));
+        assert(importedSlab->length == Length::fromQuarters(12) && importedSlab->surfacing == SlabSurfacing::S2S && importedSlab->worth.toCents() == 300);
+        assert(QtSqlRepository<Lumber>(imported).get(1)->length == Length::fromInches(3));
+        QSqlQuery lineage(imported);
+        assert(lineage.exec("SELECT COUNT(*), TOTAL(from_log = 1) FROM (SELECT from_log FROM cookies UNION ALL SELECT from_log FROM live_edge_slabs "
+                            "UNION ALL SELECT from_log FROM lumber UNION ALL SELECT from_log FROM firewood UNION ALL SELECT from_log FROM cutlist)") &&
+               lineage.next());
+        assert(lineage.value(0).toInt() == 6 && lineage.value(1).toInt() == 6);
+        assert(lineage.exec("SELECT l FROM cutlist WHERE id = 1") && lineage.next() && lineage.value(0).toInt() == 480);
+        lineage.finish();
+
+        auto checks = LegacyImporter::verify(imported, legacyPath);
+        assert(checks.size() == 6);
+        for (const auto &check : checks)
+        {
+            assert(check.ok() && check.expectedRows == check.actualRows);
+        }
+        assert(checks[0].actualMeasure == 32 && checks[0].actualBlobBytes == 4 && checks[2].actualRows == 2);
+        imported.close();
+    }
+    QSqlDatabase::removeDatabase("legacy_import_test");
+
     UnitOfWork uow(db);
     QtSqlRepository<Log> logs(db);
 
@@ -143,6 +347,436 @@ int main(int argc, char *argv[])
     uow6.commit();
     auto log3_2 = logs.get(id).value();
     auto cookie4 = log3_2.cutCookie(woodworks::domain::imperial::Length::fromInches(6));
+
+    // Slab planner: plans fit the log after a slab cut by hand, and applying one keeps that slab
+    slabs::SlabCutter planCutter(*log3);
+    planCutter.addSlab(Length::fromQuarters(4));
+    slabs::SlabPlannerOptions planOptions;
+    planOptions.thicknesses = {{Length::fromQuarters(8), 1000.0}, {Length::fromQuarters(12), 1200.0}};
+    planOptions.minWidth = Length::fromInches(4);
+    auto plans = slabs::SlabPlanner(planOptions).plan(planCutter);
+    assert(!plans.empty());
+    assert(plans.front().score >= plans.back().score);
+    assert(plans.front().offsets.front() >= Length::fromQuarters(4));
+    assert(plans.front().endOffset <= log3->diameter);
+    plans.front().applyTo(planCutter);
+    assert(planCutter.plannedCuts.size() == plans.front().cuts.size() + 1);
+    assert(planCutter.plannedCuts.front().thickness == Length::fromQuarters(4));
+    assert(planCutter.logDiameterUsed == plans.front().endOffset);
+    for (size_t i = 0; i < plans.front().cuts.size(); ++i)
+    {
+        assert(planCutter.plannedCuts[i + 1].thickness == plans.front().cuts[i].thickness);
+        assert(planCutter.plannedCuts[i + 1].width == plans.front().cuts[i].width);
+    }
+
+    // Undo and redo restore the cut and where it started
+    planCutter.clearPlannedCuts();
+    planCutter.addSlab(Length::fromQuarters(8));
+    planCutter.addSlab(Length::fromQuarters(12));
+    planCutter.undoCut();
+    assert(planCutter.logDiameterUsed == Length::fromQuarters(8));
+    assert(planCutter.canRedo());
+    planCutter.redoCut();
+    assert(planCutter.logDiameterUsed == Length::fromQuarters(20));
+    assert(!planCutter.canRedo());
+    assert(planCutter.widthProfile().chordAt(Length::fromInches(6)) == slabs::SlabPlanner::chordWidth(log3->diameter, Length::fromInches(6)));
+
+    // Nesting: two 24" parts share one 4' board with kerf, the walnut part finds no stock
+    std::vector<nesting::NestPart> nestParts = {
+        {Id{1}, "Leg", "Oak", Length::fromQuarters(4), Length::fromInches(3), Length::fromInches(23.5)},
+        {Id{1}, "Leg", "Oak", Length::fromQuarters(4), Length::fromInches(3), Length::fromInches(23.5)},
+        {Id{2}, "Top", "Walnut", Length::fromQuarters(4), Length::fromInches(12), Length::fromInches(36)},
+    };
+    std::vector<nesting::NestStock> nestStock = {
+        {Id{10}, nesting::StockKind::LUMBER, "Oak", Length::fromQuarters(4), Length::fromInches(3), Length::fromFeet(4)},
+        {Id{11}, nesting::StockKind::LUMBER, "Oak", Length::fromQuarters(8), Length::fromInches(6), Length::fromFeet(8)},
+    };
+    auto nested = nesting::CutlistNester().nest(nestParts, nestStock);
+    assert(nested.boards.size() == 1);
+    assert(nested.boards.front().stock.id.id == 10);
+    assert(nested.boards.front().placements.size() == 2);
+    assert(nested.unplaced.size() == 1 && nested.parts[nested.unplaced.front()].name == "Top");
+
+    // Rip planner: 22" usable with 1/8" kerf fits 8 + 8 + 4, not 8 + 8 + 6
+    lumber::RipPlannerOptions ripOptions;
+    ripOptions.widths = {{Length::fromInches(4), 100.0}, {Length::fromInches(6), 125.0}, {Length::fromInches(8), 150.0}};
+    ripOptions.kerf = Length::fromInches(0.125);
+    ripOptions.trimWidth = Length::fromInches(0.5);
+    auto rip = lumber::RipPlanner(ripOptions).plan(Length::fromInches(23));
+    assert(rip.boards.size() == 3);
+    assert(rip.boards.front() == Length::fromInches(8) && rip.boards.back() == Length::fromInches(4));
+    assert(rip.valueCents == 2800.0);
+    assert(rip.waste == Length::fromInches(3));
+
+    // Yard planner: the walnut slab order goes to the walnut log, cookies to the wide oak log
+    std::vector<Log> yardLogs(2, Log::uninitialized());
+    yardLogs[0].id = Id{100};
+    yardLogs[0].species = Species{"Walnut"};
+    yardLogs[0].length = Length::fromFeet(8);
+    yardLogs[0].diameter = Length::fromInches(24);
+    yardLogs[1].id = Id{101};
+    yardLogs[1].species = Species{"Oak"};
+    yardLogs[1].length = Length::fromFeet(4);
+    yardLogs[1].diameter = Length::fromInches(20);
+    std::vector<yard::Demand> yardDemands(2);
+    yardDemands[0] = {yard::DemandKind::SLAB, "Walnut", Length::fromInches(2), Length::fromInches(12), Length::fromFeet(8), 4, 20000.0};
+    yardDemands[1] = {yard::DemandKind::COOKIE, "", Length::fromInches(2), Length::fromInches(18), Length::fromTicks(0), 10, 1500.0};
+    size_t partialPlans = 0;
+    yard::YardPlannerOptions yardOptions;
+    yardOptions.batchSize = 1;
+    auto yardPlan = yard::YardPlanner(yardOptions).plan(yardLogs, yardDemands, [&](const yard::YardPlan &)
+                                                        { ++partialPlans; });
+    assert(yardPlan.complete && partialPlans >= 1);
+    assert(yardPlan.ordersFilled == 2);
+    assert(yardPlan.assignments.size() == 2);
+    for (const auto &assignment : yardPlan.assignments)
+    {
+        assert(assignment.logId.id == (assignment.demand == 0 ? 100 : 101));
+    }
+
+    // A log that would finish a partly filled line earns the bonus even though it scored lower before
+    yardLogs[0].species = Species{"Walnut"};
+    yardLogs[0].length = Length::fromInches(12);
+    yardLogs[0].diameter = Length::fromInches(20);
+    yardLogs[1].species = Species{"Oak"};
+    yardLogs[1].length = Length::fromInches(8);
+    yardLogs[1].diameter = Length::fromInches(20);
+    yardDemands[0] = {yard::DemandKind::COOKIE, "", Length::fromInches(2), Length::fromInches(18), Length::fromTicks(0), 8, 100.0};
+    yardDemands[1] = {yard::DemandKind::COOKIE, "Oak", Length::fromInches(2), Length::fromInches(12), Length::fromTicks(0), 100, 110.0};
+    yardOptions.orderFilledBonusCents = 10000.0;
+    yardPlan = yard::YardPlanner(yardOptions).plan(yardLogs, yardDemands, {});
+    assert(yardPlan.filled[0] == 8 && yardPlan.ordersFilled == 1);
+
+    // Geometry kernels: batch results match the scalar forms exactly
+    auto profile = geometry::chordWidthProfile(Length::fromInches(12));
+    for (unsigned int x = 0; x < profile.size(); ++x)
+    {
+        assert(profile[x] == geometry::chordWidth(Length::fromInches(12), Length::fromTicks(x)).toTicks());
+    }
+    assert(profile[96] == 192);
+    geometry::BoardColumns boardColumns;
+    boardColumns.push(Length::fromInches(1), Length::fromInches(12), Length::fromInches(12));
+    boardColumns.push(Length::fromInches(2), Length::fromInches(6), Length::fromFeet(8));
+    double boardFeetOut[2];
+    geometry::boardFeet(boardColumns, boardFeetOut);
+    assert(boardFeetOut[0] == 1.0 && boardFeetOut[1] == 8.0);
+    assert(boardFeetOut[1] == geometry::boardFeet(Length::fromInches(2), Length::fromInches(6), Length::fromFeet(8)));
+
+    // Logging: records below the runtime level are skipped, the rest reach the sink in order
+    using namespace woodworks::infra::logging;
+    std::vector<std::string> lines;
+    Logger::instance().setSink([&](const Record &record)
+                               { lines.push_back(Logger::format(record)); });
+    Logger::instance().setLevel(Level::Info);
+    WOODWORKS_LOG_DEBUG("test", "hidden");
+    WOODWORKS_LOG_INFO("test", "shown", {{"id", 7}, {"note", "two words"}});
+    WOODWORKS_LOG_WARN("test", "also shown");
+    Logger::instance().flush();
+    assert(lines.size() == 2);
+    assert(lines[0].find("INFO test: shown id=7 note=\"two words\"") != std::string::npos);
+    assert(lines[1].find("WARN test: also shown") != std::string::npos);
+    Logger::instance().setSink(nullptr);
+    assert(parseLevel("Debug", Level::Off) == Level::Debug && parseLevel("loud", Level::Info) == Level::Info);
+
+    // SQL tracing: literals normalize away, and repeated lookups share one statement entry
+    assert(normalizeSql("SELECT *  FROM logs WHERE species = 'Oak' AND id IN (1, 2, 3)") == "SELECT * FROM logs WHERE species = ? AND id IN (?)");
+    SqlTracer::instance().setEnabled(true);
+    SqlTracer::instance().reset();
+    logs.get(1);
+    logs.get(1);
+    auto traced = SqlTracer::instance().snapshot();
+    auto lookup = std::find_if(traced.begin(), traced.end(), [](const StatementStats &stats)
+                               { return stats.statement == normalizeSql(Log::selectOneSQL()); });
+    assert(lookup != traced.end() && lookup->count == 2 && lookup->rows == 2);
+
+    // Entity cache: repeated gets are hits, writes go through, rollbacks and removals forget
+    EntityCaches::setCapacity(64 * 1024);
+    auto &logCache = EntityCache<Log>::instance();
+    auto before = logCache.stats();
+    auto cachedLog = logs.get(1).value();
+    assert(logs.get(1)->notes == cachedLog.notes);
+    assert(logCache.stats().hits == before.hits + 1 && logCache.stats().misses == before.misses + 1);
+    cachedLog.notes = "Written through";
+    logs.update(cachedLog);
+    assert(logs.get(1)->notes == "Written through" && logCache.stats().hits == before.hits + 2);
+    {
+        UnitOfWork abandoned(db);
+        cachedLog.notes = "Rolled back";
+        logs.update(cachedLog);
+    }
+    assert(logCache.stats().entries == 0 && logs.get(1)->notes == "Written through");
+    int doomed = logs.add(cachedLog);
+    logs.remove(doomed);
+    assert(!logs.get(doomed).has_value());
+
+    // Partial updates: only the changed column is written, and an unchanged entity not at all
+    SqlTracer::instance().reset();
+    auto moved = logs.get(1).value();
+    moved.location = "Loft";
+    logs.update(moved);
+    logs.update(moved);
+    traced = SqlTracer::instance().snapshot();
+    auto partial = std::find_if(traced.begin(), traced.end(), [](const StatementStats &stats)
+                                { return stats.statement == normalizeSql("UPDATE logs SET location_id = :location_id WHERE id = :id"); });
+    assert(partial != traced.end() && partial->count == 1);
+    EntityCaches::clearAll();
+    assert(logs.get(1)->location == "Loft" && logs.get(1)->notes == "Written through");
+    EntityCaches::setCapacity(0);
+
+    // With caching off, entities read by list() are diffed against their row, and the statement is prepared once
+    SqlTracer::instance().reset();
+    for (int i = 0; i < 2; ++i)
+    {
+        auto listed = logs.list().front();
+        listed.notes = "Edited from the list " + std::to_string(i);
+        logs.update(listed);
+    }
+    traced = SqlTracer::instance().snapshot();
+    auto notesOnly = std::find_if(traced.begin(), traced.end(), [](const StatementStats &stats)
+                                  { return stats.statement == normalizeSql("UPDATE logs SET notes = :notes WHERE id = :id"); });
+    assert(notesOnly != traced.end() && notesOnly->count == 2);
+    assert(logs.get(logs.list().front().id.id)->notes == "Edited from the list 1");
+
+    // Bulk operations: a bundle edit nested in a caller's transaction signals one change
+    int notified = 0;
+    QObject::connect(&RepositoryNotifier::instance(), &RepositoryNotifier::repositoryChanged, [&notified]()
+                     { ++notified; });
+    Firewood stack = *firewood3;
+    stack.location = "Bulk";
+    stack.cubicFeet = 4.0;
+    for (int i = 0; i < 3; ++i)
+    {
+        firewoods.add(stack);
+    }
+    auto inBulk = [](const Firewood &fw)
+    { return fw.location == "Bulk"; };
+    FirewoodBundle bundle(stack);
+    bundle.items = firewoods.filter(inBulk);
+    notified = 0;
+    {
+        UnitOfWork outer(db);
+        bundle.dryVolume(6.0, Drying::AIR_DRIED);
+        outer.commit();
+    }
+    assert(notified == 1 && firewoods.filter(inBulk).size() == 4);
+    assert(firewoods.updateWhere({{"location", "Bulk"}}, {{"location", "Yard"}}) == 4);
+    assert(firewoods.deleteWhere({{"location", "Yard"}, {"drying", static_cast<int>(Drying::AIR_DRIED)}}) == 2);
+    assert(firewoods.deleteWhere({{"location", "Nowhere"}}) == 0 && !NameTable::species().find("").has_value());
+    assert(notified == 3);
+    {
+        UnitOfWork outer(db);
+        {
+            UnitOfWork inner(db);
+            firewoods.deleteWhere({{"location", "Yard"}});
+        }
+        outer.commit();
+    }
+    auto yard = firewoods.filter([](const Firewood &fw)
+                                 { return fw.location == "Yard"; });
+    assert(yard.size() == 2);
+
+    // Streaming reads see the same rows as list() and can stop early
+    size_t streamed = 0;
+    for (const Firewood &fw : firewoods.cursor())
+    {
+        streamed += fw.location == "Yard" ? 1 : 0;
+    }
+    assert(streamed == yard.size());
+    assert(firewoods.forEach([](Firewood &&) {}) == firewoods.list().size());
+    assert(firewoods.forEach([](const Firewood &) { return false; }) == 1);
+
+    // Streaming reads keep no stored columns, however many rows they pass
+    {
+        UnitOfWork scanRows(db);
+        Firewood scanned = stack;
+        scanned.location = "Scan";
+        for (int i = 0; i < 500; ++i)
+        {
+            firewoods.add(scanned);
+        }
+        scanRows.commit();
+    }
+    EntityCaches::clearAll();
+    auto &storedFirewood = StoredColumns<Firewood>::instance();
+    size_t scannedRows = firewoods.forEach([](Firewood &&) {});
+    for (const Firewood &fw : firewoods.cursor())
+    {
+        scannedRows -= fw.id.id > 0 ? 1 : 0;
+    }
+    assert(scannedRows == 0 && firewoods.list().size() > 500 && storedFirewood.size(db) == 0);
+    assert(firewoods.deleteWhere({{"location", "Scan"}}) == 500 && storedFirewood.size(db) == 0);
+
+    // Table selections are read in one query; unknown ids are skipped
+    assert(firewoods.getMany({yard[0].id.id, yard[1].id.id, -1}).size() == 2);
+    bool refused = false;
+    try
+    {
+        firewoods.deleteWhere({{"1 OR 1", 1}});
+    }
+    catch (const std::runtime_error &)
+    {
+        refused = true;
+    }
+    assert(refused);
+
+    // Action tagging: a dozen lookups of one statement in one action is flagged as N+1
+    SqlTracer::instance().setNPlusOneThreshold(10);
+    {
+        ActionScope action("test: lookups");
+        ActionScope inner("test: ignored");
+        assert(ActionScope::current() == "test: lookups");
+        for (int i = 0; i < 12; ++i)
+        {
+            logs.get(1);
+        }
+    }
+    auto actions = SqlTracer::instance().actionSnapshot();
+    assert(actions.size() == 1 && actions[0].action == "test: lookups");
+    assert(actions[0].invocations == 1 && actions[0].queries == 12 && actions[0].nPlusOne == 1);
+    assert(actions[0].repeated.size() == 1 && actions[0].repeated[0].second == 12);
+    SqlTracer::instance().setEnabled(false);
+
+    // Species and locations are stored as keys; a name keeps its key, and entities read back carry it
+    const int oakKey = NameTable::species().intern("Oak");
+    assert(NameTable::species().intern("Oak") == oakKey && NameTable::species().name(oakKey) == "Oak");
+    assert(logs.get(1)->species.id == oakKey && logs.get(1)->species == Species{"Oak"});
+    assert(!NameTable::species().find("Unobtainium").has_value());
+
+    // Keys belong to their database: a second connection interns on its own tables
+    {
+        QSqlDatabase other = QSqlDatabase::addDatabase("QSQLITE", "name_table_test");
+        other.setDatabaseName(DbConnection::IN_MEMORY);
+        assert(other.open() && SchemaMigrator::migrate(other).toVersion == SchemaMigrator::latestVersion());
+        QtSqlRepository<Log> otherLogs(other);
+        Log rare = *log1;
+        rare.species = Species{"Unobtainium"};
+        int otherId = otherLogs.add(rare);
+        assert(otherLogs.get(otherId)->species == Species{"Unobtainium"});
+        assert(NameTable::species(other).find("Unobtainium").has_value() && !NameTable::species().find("Unobtainium").has_value());
+        assert(Dictionaries::of(other).values(Dictionaries::SPECIES) == QStringList{"Unobtainium"});
+        other.close();
+    }
+    QSqlDatabase::removeDatabase("name_table_test");
+
+    // Cached entities belong to their database: the same id on another connection is a different row
+    EntityCaches::setCapacity(64 * 1024);
+    {
+        QSqlDatabase other = QSqlDatabase::addDatabase("QSQLITE", "entity_cache_test");
+        other.setDatabaseName(DbConnection::IN_MEMORY);
+        assert(other.open() && SchemaMigrator::migrate(other).toVersion == SchemaMigrator::latestVersion());
+        QtSqlRepository<Log> otherLogs(other);
+        auto mine = logs.get(1).value();
+        Log theirs = mine;
+        theirs.notes = "Only in the other database";
+        int theirId = otherLogs.add(theirs);
+        assert(theirId == 1 && otherLogs.get(1)->notes == theirs.notes && logs.get(1)->notes == mine.notes);
+        // With only the cache to diff against, writing back this database's notes must still reach the other one
+        StoredColumns<Log>::instance().clear();
+        theirs.id = Id{theirId};
+        theirs.notes = mine.notes;
+        otherLogs.update(theirs);
+        EntityCaches::clearAll();
+        assert(otherLogs.get(1)->notes == mine.notes);
+        other.close();
+    }
+    QSqlDatabase::removeDatabase("entity_cache_test");
+    EntityCaches::setCapacity(0);
+
+    // Dictionaries load once, then follow the repository's writes without reading again
+    auto &dictionaries = Dictionaries::instance();
+    assert(dictionaries.values(Dictionaries::SPECIES).contains("Oak"));
+    assert(dictionaries.values(Dictionaries::DRYING).contains("Kiln Dried"));
+    size_t loads = dictionaries.stats().loads;
+    Log zebrawood = *log1;
+    zebrawood.species = Species{"Zebrawood"};
+    int zebrawoodId = logs.add(zebrawood);
+    assert(dictionaries.values(Dictionaries::SPECIES).contains("Zebrawood"));
+    zebrawood.id = Id{zebrawoodId};
+    zebrawood.location = "Dictionary test";
+    logs.update(zebrawood);
+    assert(dictionaries.values(Dictionaries::LOCATIONS).contains("Dictionary test"));
+    logs.remove(zebrawoodId);
+    assert(!dictionaries.values(Dictionaries::SPECIES).contains("Zebrawood"));
+    assert(!dictionaries.values(Dictionaries::LOCATIONS).contains("Dictionary test"));
+    assert(dictionaries.stats().loads == loads);
+
+    // Items without a location add no blank entry, whether counted on load or as they are written
+    Log unplaced = *log1;
+    unplaced.location = "";
+    int unplacedId = logs.add(unplaced);
+    assert(!dictionaries.values(Dictionaries::LOCATIONS).contains(""));
+    dictionaries.invalidate();
+    assert(!dictionaries.values(Dictionaries::LOCATIONS).contains(""));
+    logs.remove(unplacedId);
+
+    // Filters on display columns compile to bound tick ranges on the base table and match the view's own rows
+    QVector<FieldFilter> logFilters{FieldFilter().between("\"Length (ft)\"", 1, 40), FieldFilter().exact("drying", QString("Green"))};
+    CompiledFilter compiled = compileFilters("display_logs", logFilters);
+    assert(compiled.sql.contains("length >= ?") && compiled.sql.contains("drying = ?") && compiled.bound.size() == 3);
+    QVector<FieldFilter> sameShape{FieldFilter().between("\"Length (ft)\"", 2, 3), FieldFilter().exact("drying", QString("Kiln Dried"))};
+    assert(compileFilters("display_logs", sameShape).sql == compiled.sql);
+    QSqlQuery literal(db);
+    literal.exec("SELECT COUNT(*) FROM display_logs WHERE \"Length (ft)\" BETWEEN 1 AND 40 AND Drying = 'Green'");
+    literal.next();
+    QSqlQueryModel *filtered = makeFilteredModel("display_logs", logFilters);
+    assert(filtered->rowCount() == literal.value(0).toInt());
+    delete filtered;
+
+    // Two live models of one filter shape get their own statements; a replaced model hands its statement on
+    QVector<FieldFilter> kilnDried{FieldFilter().between("\"Length (ft)\"", 1, 40), FieldFilter().exact("drying", QString("Kiln Dried"))};
+    QSqlQueryModel *kilnModel = makeFilteredModel("display_logs", kilnDried);
+    const int kilnRows = kilnModel->rowCount();
+    assert(kilnRows > 0);
+    QSqlQueryModel *greenModel = makeFilteredModel("display_logs", logFilters);
+    assert(kilnModel->rowCount() == kilnRows);
+    QSqlQueryModel *kilnAgain = makeFilteredModel("display_logs", kilnDried, nullptr, greenModel);
+    delete greenModel;
+    assert(kilnAgain->rowCount() == kilnRows && kilnModel->rowCount() == kilnRows);
+    delete kilnAgain;
+    delete kilnModel;
+
+    // The snapshot answers the same filters from memory with the same rows
+    assert(compiled.baseOnly && compiled.predicates.size() == 2 && compiled.predicates[1].equals.toInt() == 0);
+    SnapshotModel *snapshotModel = makeSnapshotModel("display_logs", logFilters);
+    const int greenLogs = literal.value(0).toInt();
+    assert(snapshotModel && snapshotModel->rowCount() == greenLogs);
+    assert(snapshotModel->headerData(1, Qt::Horizontal).toString() == "Species");
+    delete snapshotModel;
+    assert(!makeSnapshotModel("display_logs_grouped", logFilters));
+
+    // Repository writes patch the snapshot by id instead of reading the view again
+    auto &snapshots = InventorySnapshots::instance();
+    const size_t snapshotLoads = snapshots.stats().loads;
+    const int snapshotRows = snapshots.get("display_logs")->rowCount();
+    auto greenMatches = [&]()
+    { return static_cast<int>(snapshots.get("display_logs")->match(logFilters)->size()); };
+    Log green = *log1;
+    green.drying = Drying::GREEN;
+    green.id = Id{logs.add(green)};
+    assert(greenMatches() == greenLogs + 1);
+    green.drying = Drying::AIR_DRIED;
+    logs.update(green);
+    assert(greenMatches() == greenLogs);
+    green.drying = Drying::GREEN;
+    logs.update(green);
+    logs.remove(green.id.id);
+    assert(greenMatches() == greenLogs);
+    auto patchedSnapshot = snapshots.get("display_logs");
+    assert(patchedSnapshot->rowCount() == snapshotRows + 1 && patchedSnapshot->deadRows() == 1);
+    assert(snapshots.stats().loads == snapshotLoads && snapshots.stats().rowsPatched >= 4);
+
+    // A bulk statement cannot say which rows it touched, so it drops the snapshots
+    size_t invalidations = snapshots.stats().invalidations;
+    assert(logs.updateWhere({{"id", 1}}, {{"quality", logs.get(1)->quality.value}}) == 1);
+    assert(snapshots.stats().invalidations == invalidations + 1);
+
+    // Startup timeline: phases keep their order and add up to the elapsed time
+    StartupTimeline::instance().mark("test: first");
+    StartupTimeline::instance().mark("test: second");
+    auto phases = StartupTimeline::instance().phases();
+    assert(phases.size() == 2 && phases[1].name == "test: second");
+    assert(phases[0].millis >= 0.0 && phases[1].atMillis >= phases[0].atMillis);
+    assert(phases[1].atMillis - (phases[0].millis + phases[1].millis) < 1e-6);
 }
 
 #endif
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include <QSqlError>
 #include <QSqlQueryModel>
 #include <QSqlRecord>
+#include <QTimer>
 #include <QVBoxLayout>
 
 #include "cutlist.hpp"
@@ -23,18 +24,38 @@
 #include "cutlist.hpp"
 #include "sales.hpp"
 #include "infra/mappers/view_helpers.hpp"
+#include "widgets/YardPlanningWindow.hpp"
+#include "widgets/SqlDiagnosticsWindow.hpp"
+#include "infra/logging.hpp"
+#include "infra/startup_timeline.hpp"
+#include "widgets/WebEnginePrewarmer.hpp"
 
+#include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <string>
 
+namespace
+{
+    // Pages are built on first use, since their models query the database
+    template <typename Page>
+    Page *buildPage(const char *name)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Page *page = new Page();
+        WOODWORKS_LOG_DEBUG("ui", "page built",
+                            {{"page", name},
+                             {"ms", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()}});
+        return page;
+    }
+}
+
 #define GROUPED_LOGS_QUERY "SELECT * from logs_view_grouped"
 #define LOGS_QUERY "SELECT * FROM logs_view"
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent), ui(new Ui::MainWindow),
-      cutlistPage(new CutlistPage()), salesPage(new SalesPage()),
-      inventoryPage(nullptr)
+      inventoryPage(nullptr), cutlistPage(nullptr), salesPage(nullptr)
 {
     // Load UI layout and set the central widget
     ui->setupUi(this);
@@ -51,16 +72,25 @@ MainWindow::MainWindow(QWidget *parent)
     QAction *inventoryAction = new QAction("Inventory", this);
     QAction *cutlistAction = new QAction("Cutlist", this);
     QAction *salesAction = new QAction("Sales", this);
+    QAction *yardPlanningAction = new QAction("Plan Yard", this);
+    QAction *sqlDiagnosticsAction = new QAction("SQL Diagnostics", this);
 
     menu->addAction(inventoryAction);
     menu->addAction(cutlistAction);
     menu->addAction(salesAction);
+    menu->addAction(yardPlanningAction);
+    menu->addSeparator();
+    menu->addAction(sqlDiagnosticsAction);
 
     connect(inventoryAction, &QAction::triggered, this,
             &MainWindow::showInventoryPage);
     connect(cutlistAction, &QAction::triggered, this,
             &MainWindow::showCutlistPage);
     connect(salesAction, &QAction::triggered, this, &MainWindow::showSalesPage);
+    connect(yardPlanningAction, &QAction::triggered, this,
+            &MainWindow::showYardPlanning);
+    connect(sqlDiagnosticsAction, &QAction::triggered, this,
+            &MainWindow::showSqlDiagnostics);
 
     connect(ui->openInventoryButton, &QPushButton::clicked, this,
             &MainWindow::showInventoryPage);
@@ -78,17 +108,30 @@ MainWindow::MainWindow(QWidget *parent)
     QVBoxLayout *layout = new QVBoxLayout(ui->centralwidget);
     layout->addWidget(welcomeLabel);
 
-    // Database connection setup
-    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
-    db.setDatabaseName("woodworks.db");
-    if (!db.open())
-    {
-        qDebug() << "Database error:" << db.lastError().text();
-        return;
-    }
+    // The database itself is opened by DbConnection before the window is built
 
     ui->openInventoryButton->setStyleSheet(
         "font-family: 'Segoe UI Symbol'; font-size: 14pt;");
+
+    // Watch for the first paint to finish the startup timeline
+    ui->centralwidget->installEventFilter(this);
+}
+
+bool MainWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == ui->centralwidget && event->type() == QEvent::Paint)
+    {
+        ui->centralwidget->removeEventFilter(this);
+        // Queued so the mark lands after this paint has been drawn
+        QTimer::singleShot(0, this, []
+                           {
+            auto &timeline = woodworks::infra::StartupTimeline::instance();
+            timeline.mark("first paint");
+            timeline.report();
+            // Only once the window is up and idle, so it does not delay the first paint
+            woodworks::widgets::WebEnginePrewarmer::schedule(1000); });
+    }
+    return QMainWindow::eventFilter(watched, event);
 }
 
 MainWindow::~MainWindow() { delete ui; }
@@ -96,7 +139,7 @@ MainWindow::~MainWindow() { delete ui; }
 void MainWindow::showInventoryPage()
 {
     if (!inventoryPage)
-        inventoryPage = new InventoryPage();
+        inventoryPage = buildPage<InventoryPage>("InventoryPage");
     inventoryPage->show();
     inventoryPage->raise();
     inventoryPage->activateWindow();
@@ -105,7 +148,7 @@ void MainWindow::showInventoryPage()
 void MainWindow::showCutlistPage()
 {
     if (!cutlistPage)
-        cutlistPage = new CutlistPage();
+        cutlistPage = buildPage<CutlistPage>("CutlistPage");
     cutlistPage->show();
     cutlistPage->raise();
     cutlistPage->activateWindow();
@@ -114,8 +157,22 @@ void MainWindow::showCutlistPage()
 void MainWindow::showSalesPage()
 {
     if (!salesPage)
-        salesPage = new SalesPage();
+        salesPage = buildPage<SalesPage>("SalesPage");
     salesPage->show();
     salesPage->raise();
     salesPage->activateWindow();
 }
+
+void MainWindow::showYardPlanning()
+{
+    auto *window = new woodworks::widgets::YardPlanningWindow();
+    window->setAttribute(Qt::WA_DeleteOnClose);
+    window->show();
+}
+
+void MainWindow::showSqlDiagnostics()
+{
+    auto *window = new woodworks::widgets::SqlDiagnosticsWindow();
+    window->setAttribute(Qt::WA_DeleteOnClose);
+    window->show();
+}
@@ -7,6 +7,7 @@
 
 #include "project_editor.hpp"
 #include "ui_projectEditor.h"
+#include "infra/logging.hpp"
 
 ProjectEditorWindow::ProjectEditorWindow(QWidget *parent) : QMainWindow(parent),
                                                             ui(new Ui::ProjectsWindow)
@@ -44,7 +45,7 @@ void ProjectEditorWindow::updateDisplay()
 
     if (model->lastError().isValid())
     {
-        qDebug() << "Error: " << model->lastError().text();
+        WOODWORKS_LOG_WARN("projects", "cut list query error", {{"error", model->lastError().text()}});
         return;
     }
 
@@ -39,6 +39,8 @@
 #include "sales/generator.hpp"
 
 #include "infra/repository.hpp"
+#include "infra/logging.hpp"
+#include "widgets/WebEnginePrewarmer.hpp"
 
 using namespace woodworks::domain;
 using namespace woodworks::domain::imperial;
@@ -88,7 +90,7 @@ void SalesPage::onPreviewHtmlButtonClicked()
     QFile file(filename);
     if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
     {
-        qDebug() << "Failed to open file for writing";
+        WOODWORKS_LOG_ERROR("sales", "failed to open file for writing", {{"path", filename}});
         return;
     }
     QTextStream out(&file);
@@ -99,7 +101,8 @@ void SalesPage::onPreviewHtmlButtonClicked()
     QDialog *dialog = new QDialog(this);
     dialog->setWindowTitle("Sales Preview");
     QVBoxLayout *layout = new QVBoxLayout(dialog);
-    QWebEngineView *view = new QWebEngineView(dialog);
+    // Usually already warmed by MainWindow, which saves seconds on the first preview
+    QWebEngineView *view = woodworks::widgets::WebEnginePrewarmer::take(dialog);
     layout->addWidget(view);
     connect(dialog, &QDialog::finished, view, &QObject::deleteLater);
     connect(dialog, &QDialog::finished, view->page(), &QObject::deleteLater);
@@ -132,7 +135,7 @@ void SalesPage::onSaveHtmlButtonClicked()
     QFile file(filename);
     if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
     {
-        qDebug() << "Failed to open file for writing";
+        WOODWORKS_LOG_ERROR("sales", "failed to open file for writing", {{"path", filename}});
         return;
     }
     QTextStream out(&file);
@@ -51,6 +51,32 @@ void LumberCuttingWindow::setupUi()
     widthLayout->addWidget(boardWidthSpin);
     mainLayout->addLayout(widthLayout);
 
+    // Mixed width rip, planned for value
+    mixedWidthsCheck = new QCheckBox("Rip mixed widths for best value");
+    mainLayout->addWidget(mixedWidthsCheck);
+
+    auto *kerfLayout = new QHBoxLayout();
+    kerfLayout->addWidget(new QLabel("Kerf (in):"));
+    kerfSpin = new QDoubleSpinBox();
+    kerfSpin->setSuffix("in");
+    kerfSpin->setDecimals(3);
+    kerfSpin->setSingleStep(0.0625);
+    kerfSpin->setRange(0, 1);
+    kerfSpin->setValue(0.125);
+    kerfLayout->addWidget(kerfSpin);
+    mainLayout->addLayout(kerfLayout);
+
+    auto *ripWidthsLayout = new QHBoxLayout();
+    ripWidthsLayout->addWidget(new QLabel("Widths (in@$/in):"));
+    ripWidthsEdit = new QLineEdit("4@1.00, 6@1.25, 8@1.50");
+    ripWidthsEdit->setToolTip("Sellable board widths and their value per inch of width, e.g. 4@1.00, 6@1.25");
+    ripWidthsLayout->addWidget(ripWidthsEdit);
+    mainLayout->addLayout(ripWidthsLayout);
+
+    ripPlanLabel = new QLabel(this);
+    ripPlanLabel->setWordWrap(true);
+    mainLayout->addWidget(ripPlanLabel);
+
     // Display cut summary
     cutsCountLabel = new QLabel(this);
     boardWidthLabel = new QLabel(this);
@@ -70,6 +96,9 @@ void LumberCuttingWindow::setupUi()
     connect(boardCountSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &LumberCuttingWindow::onBoardCountChanged);
     connect(boardWidthSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &LumberCuttingWindow::onBoardWidthChanged);
     connect(finishButton, &QPushButton::clicked, this, &LumberCuttingWindow::onFinishCuts);
+    connect(mixedWidthsCheck, &QCheckBox::toggled, this, &LumberCuttingWindow::onRipOptionsChanged);
+    connect(kerfSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &LumberCuttingWindow::onRipOptionsChanged);
+    connect(ripWidthsEdit, &QLineEdit::textChanged, this, &LumberCuttingWindow::onRipOptionsChanged);
 
     setWindowTitle("Lumber Cutting");
     adjustSize();
@@ -93,6 +122,56 @@ void LumberCuttingWindow::updateUi()
     // update summary labels
     cutsCountLabel->setText(QString("Boards made: %1").arg(cutter.boardCount));
     boardWidthLabel->setText(QString("Board width: %1 in").arg(cutter.boardWidth.toInches()));
+
+    // the equal width controls don't apply to a mixed rip
+    bool mixed = mixedWidthsCheck->isChecked();
+    boardCountSpin->setEnabled(!mixed);
+    boardWidthSpin->setEnabled(!mixed);
+    kerfSpin->setEnabled(mixed);
+    ripWidthsEdit->setEnabled(mixed);
+    planRip();
+}
+
+void LumberCuttingWindow::planRip()
+{
+    if (!mixedWidthsCheck->isChecked())
+    {
+        ripPlanLabel->clear();
+        return;
+    }
+
+    // Parse "width@value" pairs, skipping anything malformed
+    RipPlannerOptions options;
+    options.kerf = Length::fromInches(kerfSpin->value());
+    options.trimWidth = cutter.trimWidth;
+    for (const auto &entry : ripWidthsEdit->text().split(','))
+    {
+        auto parts = entry.split('@');
+        bool widthOk = false;
+        bool valueOk = parts.size() == 2;
+        double width = parts.value(0).trimmed().toDouble(&widthOk);
+        double value = valueOk ? parts.value(1).trimmed().toDouble(&valueOk) : 0.0;
+        if (widthOk && valueOk && width > 0)
+        {
+            options.widths.push_back(RipWidth{Length::fromInches(width), value * 100.0});
+        }
+    }
+
+    ripPlan = RipPlanner(options).plan(cutter.slab);
+    QStringList widths;
+    for (const auto &board : ripPlan.boards)
+    {
+        widths << QString::number(board.toInches());
+    }
+    ripPlanLabel->setText(QString("Rip: %1\nValue: $%2, waste: %3 in")
+                              .arg(widths.isEmpty() ? QString("nothing fits") : widths.join(", ") + " in")
+                              .arg(ripPlan.valueCents / 100.0, 0, 'f', 2)
+                              .arg(ripPlan.waste.toInches()));
+}
+
+void LumberCuttingWindow::onRipOptionsChanged()
+{
+    updateUi();
 }
 
 void LumberCuttingWindow::onTrimWidthChanged(double value)
@@ -116,7 +195,14 @@ void LumberCuttingWindow::onBoardWidthChanged(double value)
 void LumberCuttingWindow::onFinishCuts()
 {
     // prepare boards then finalize
-    cutter.planCuts();
+    if (mixedWidthsCheck->isChecked())
+    {
+        ripPlan.applyTo(cutter);
+    }
+    else
+    {
+        cutter.planCuts();
+    }
     cutter.finalizeCuts();
     close();
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "widgets/RefreshScheduler.hpp"
+#include <QTabWidget>
+
+#include "infra/logging.hpp"
+#include "infra/sql_trace.hpp"
+
+using namespace woodworks::widgets;
+
+RefreshScheduler::RefreshScheduler(QTabWidget *tabs, std::function<void(int)> refreshTab,
+                                   std::function<void()> rebuildFilters, int debounceMs)
+    : QObject(tabs), tabs_(tabs), refreshTab_(std::move(refreshTab)), rebuildFilters_(std::move(rebuildFilters))
+{
+    debounce_.setSingleShot(true);
+    debounce_.setInterval(debounceMs);
+    connect(&debounce_, &QTimer::timeout, this, [this]()
+            { flush(); });
+    // A stale tab is brought up to date as soon as it is shown, without waiting
+    connect(tabs_, &QTabWidget::currentChanged, this, [this](int tab)
+            {
+        if (stale_.contains(tab))
+            flushNow(); });
+}
+
+void RefreshScheduler::request(int tab)
+{
+    if (tab < 0)
+    {
+        return;
+    }
+    ++stats_.requested;
+    stale_.insert(tab);
+    recordAction();
+    debounce_.start();
+}
+
+void RefreshScheduler::requestAll()
+{
+    for (int tab = 0; tab < tabs_->count(); ++tab)
+    {
+        ++stats_.requested;
+        stale_.insert(tab);
+    }
+    recordAction();
+    debounce_.start();
+}
+
+void RefreshScheduler::dataChanged()
+{
+    filtersStale_ = true;
+    requestAll();
+}
+
+void RefreshScheduler::flushNow()
+{
+    debounce_.stop();
+    flush();
+}
+
+void RefreshScheduler::recordAction()
+{
+    // The debounce timer fires outside the handler that asked, so the action is carried over
+    QString action = woodworks::infra::ActionScope::current();
+    if (!action.isEmpty())
+    {
+        action_ = action;
+    }
+}
+
+void RefreshScheduler::flush()
+{
+    // Tabs still stale afterwards are refreshed when shown, which is an action of its own
+    woodworks::infra::ActionScope scope(action_.isEmpty() ? QString("inventory: refresh") : action_);
+    action_.clear();
+    if (filtersStale_)
+    {
+        filtersStale_ = false;
+        rebuildFilters_();
+    }
+    int tab = tabs_->currentIndex();
+    if (!stale_.remove(tab))
+    {
+        return;
+    }
+    ++stats_.refreshed;
+    refreshTab_(tab);
+    WOODWORKS_LOG_DEBUG("inventory", "refreshed tab",
+                        {{"tab", tab}, {"requested", stats_.requested}, {"refreshed", stats_.refreshed}, {"avoided", stats_.avoided()}});
+}
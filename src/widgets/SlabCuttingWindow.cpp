@@ -21,6 +21,9 @@ SlabCuttingWindow::SlabCuttingWindow(Log log, QWidget *parent) : QMainWindow(par
     // Connect signals and slots
     connect(ui->squareOffButton, &QPushButton::clicked, this, &SlabCuttingWindow::onSquareOffButtonClicked);
     connect(ui->addCutButton, &QPushButton::clicked, this, &SlabCuttingWindow::onAddCutButtonClicked);
+    connect(ui->suggestCutsButton, &QPushButton::clicked, this, &SlabCuttingWindow::onSuggestCutsButtonClicked);
+    connect(ui->undoCutButton, &QPushButton::clicked, this, &SlabCuttingWindow::onUndoCutButtonClicked);
+    connect(ui->redoCutButton, &QPushButton::clicked, this, &SlabCuttingWindow::onRedoCutButtonClicked);
     connect(ui->nextSlabThicknessSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &SlabCuttingWindow::onSlabThicknessChanged);
     connect(ui->finishCutButton, &QPushButton::clicked, this, &SlabCuttingWindow::onFinishCutButtonClicked);
 }
@@ -62,20 +65,76 @@ void SlabCuttingWindow::onAddCutButtonClicked()
     updateUi();
 }
 
-void SlabCuttingWindow::onSlabThicknessChanged()
+void SlabCuttingWindow::onSuggestCutsButtonClicked()
+{
+    // Plan the rest of the log for yield over the common slab thicknesses
+    SlabPlannerOptions options;
+    for (double quarters : {4.0, 6.0, 8.0, 12.0})
+    {
+        options.thicknesses.push_back(ThicknessOption{Length::fromQuarters(quarters), 1.0});
+    }
+    options.kerf = Length::fromInches(0.125);
+    options.minWidth = Length::fromInches(6);
+    options.objective = PlanObjective::YIELD;
+
+    auto plans = SlabPlanner(options).plan(cutter);
+    if (plans.empty())
+    {
+        QMessageBox::warning(this, "No Plan", "No slabs fit in the remaining diameter.");
+        return;
+    }
+
+    // Let the sawyer pick one of the plans
+    QStringList descriptions;
+    for (const auto &plan : plans)
+    {
+        QStringList thicknesses;
+        for (const auto &slab : plan.cuts)
+        {
+            thicknesses << QString::number(slab.thickness.toQuarters()) + "/4";
+        }
+        descriptions << QString("%1 bf: %2").arg(plan.boardFeet, 0, 'f', 1).arg(thicknesses.join(", "));
+    }
+
+    bool ok;
+    QString choice = QInputDialog::getItem(this, "Suggested Cuts", "Choose a cutting plan:", descriptions, 0, false, &ok);
+    if (!ok)
+    {
+        return;
+    }
+
+    plans[static_cast<size_t>(descriptions.indexOf(choice))].applyTo(cutter);
+    updateUi();
+}
+
+void SlabCuttingWindow::onUndoCutButtonClicked()
 {
+    cutter.undoCut();
     updateUi();
 }
 
+void SlabCuttingWindow::onRedoCutButtonClicked()
+{
+    cutter.redoCut();
+    updateUi();
+}
+
+void SlabCuttingWindow::onSlabThicknessChanged()
+{
+    // Only the width preview depends on the thickness
+    ui->slabWidthDisplayLabel->setText(QString::number(cutter.slabWidthAtThickness(Length::fromQuarters(ui->nextSlabThicknessSpin->value())).toInches()) + " inches");
+}
+
 void SlabCuttingWindow::updateUi()
 {
     ui->remainingDiameterLabel->setText(QString::number(cutter.getRemainingDiameter().toQuarters()) + " quarters");
-    ui->slabWidthDisplayLabel->setText(QString::number(cutter.slabWidthAtThickness(Length::fromQuarters(ui->nextSlabThicknessSpin->value())).toQuarters()) + " quarters");
-    ui->slabWidthDisplayLabel->setText(QString::number(cutter.slabWidthAtThickness(Length::fromQuarters(ui->nextSlabThicknessSpin->value())).toInches()) + " inches");
     ui->listWidget->clear();
     auto planned = cutter.getPlannedCuts();
     ui->listWidget->addItems(QStringList::fromVector(QVector<QString>(planned.begin(), planned.end())));
     ui->nextSlabThicknessSpin->setMaximum(cutter.getRemainingDiameter().toQuarters());
+    ui->undoCutButton->setEnabled(cutter.canUndo());
+    ui->redoCutButton->setEnabled(cutter.canRedo());
+    onSlabThicknessChanged();
 }
 
 void SlabCuttingWindow::onFinishCutButtonClicked()
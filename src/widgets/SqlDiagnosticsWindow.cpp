@@ -0,0 +1,351 @@
+#include "widgets/SqlDiagnosticsWindow.hpp"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QPushButton>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QSplitter>
+#include <QTabWidget>
+#include <QFont>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace woodworks::widgets;
+using namespace woodworks::infra;
+
+namespace
+{
+    enum StatementColumn
+    {
+        STATEMENT,
+        COUNT,
+        ERRORS,
+        ROWS,
+        PREPARE_MS,
+        EXEC_MS,
+        MEAN_US,
+        P50_US,
+        P95_US,
+        P99_US,
+        MAX_MS,
+        STATEMENT_COLUMNS
+    };
+
+    enum ActionColumn
+    {
+        ACTION,
+        INVOCATIONS,
+        QUERIES,
+        QUERIES_PER_RUN,
+        MAX_QUERIES,
+        DB_MS,
+        N_PLUS_ONE,
+        ACTION_COLUMNS
+    };
+
+    QTableWidgetItem *numberItem(double value, int decimals)
+    {
+        auto *item = new QTableWidgetItem();
+        double scale = std::pow(10.0, decimals);
+        item->setData(Qt::DisplayRole, decimals == 0 ? QVariant(static_cast<qlonglong>(value)) : QVariant(std::round(value * scale) / scale));
+        item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        return item;
+    }
+
+    QString bucketLabel(size_t bucket)
+    {
+        if (bucket == 0)
+        {
+            return "< 1 us";
+        }
+        auto low = 1ull << (bucket - 1);
+        if (bucket + 1 == StatementStats::HISTOGRAM_BUCKETS)
+        {
+            return QString(">= %1 us").arg(low);
+        }
+        return QString("%1-%2 us").arg(low).arg(1ull << bucket);
+    }
+}
+
+SqlDiagnosticsWindow::SqlDiagnosticsWindow(QWidget *parent)
+    : QMainWindow(parent)
+{
+    setupUi();
+    onRefresh();
+}
+
+void SqlDiagnosticsWindow::setupUi()
+{
+    QWidget *central = new QWidget(this);
+    setCentralWidget(central);
+    auto *mainLayout = new QVBoxLayout(central);
+    mainLayout->setContentsMargins(10, 10, 10, 10);
+
+    // Controls
+    auto *controls = new QHBoxLayout();
+    enabledCheck = new QCheckBox("Trace queries");
+    enabledCheck->setChecked(SqlTracer::instance().enabled());
+    thresholdSpin = new QDoubleSpinBox();
+    thresholdSpin->setRange(0.0, 60000.0);
+    thresholdSpin->setDecimals(1);
+    thresholdSpin->setSuffix(" ms");
+    thresholdSpin->setValue(static_cast<double>(SqlTracer::instance().slowThreshold().count()) / 1000.0);
+    nPlusOneSpin = new QSpinBox();
+    nPlusOneSpin->setRange(2, 100000);
+    nPlusOneSpin->setSuffix(" runs");
+    nPlusOneSpin->setValue(static_cast<int>(SqlTracer::instance().nPlusOneThreshold()));
+    auto *refreshButton = new QPushButton("Refresh");
+    auto *resetButton = new QPushButton("Reset");
+    auto *exportButton = new QPushButton("Export JSON...");
+    controls->addWidget(enabledCheck);
+    controls->addWidget(new QLabel("Slow query threshold:"));
+    controls->addWidget(thresholdSpin);
+    controls->addWidget(new QLabel("N+1 after:"));
+    controls->addWidget(nPlusOneSpin);
+    controls->addStretch();
+    controls->addWidget(refreshButton);
+    controls->addWidget(resetButton);
+    controls->addWidget(exportButton);
+    mainLayout->addLayout(controls);
+
+    summaryLabel = new QLabel(this);
+    mainLayout->addWidget(summaryLabel);
+
+    // Statements, slowest total time first, with the selected one's details below
+    auto *splitter = new QSplitter(Qt::Vertical, this);
+    statementTable = new QTableWidget(0, STATEMENT_COLUMNS, this);
+    statementTable->setHorizontalHeaderLabels({"Statement", "Count", "Errors", "Rows", "Prepare (ms)", "Exec (ms)",
+                                               "Mean (us)", "p50 (us)", "p95 (us)", "p99 (us)", "Max (ms)"});
+    statementTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    statementTable->horizontalHeader()->setSectionResizeMode(STATEMENT, QHeaderView::Stretch);
+    statementTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    statementTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    statementTable->setSelectionMode(QAbstractItemView::SingleSelection);
+    splitter->addWidget(statementTable);
+
+    detailText = new QPlainTextEdit(this);
+    detailText->setReadOnly(true);
+    detailText->setLineWrapMode(QPlainTextEdit::NoWrap);
+    detailText->setFont(QFont("Monospace"));
+    splitter->addWidget(detailText);
+
+    // Actions, most database time first, with the busiest run's repeated statements below
+    auto *actionSplitter = new QSplitter(Qt::Vertical, this);
+    actionTable = new QTableWidget(0, ACTION_COLUMNS, this);
+    actionTable->setHorizontalHeaderLabels({"Action", "Runs", "Queries", "Queries / Run", "Max Queries", "DB (ms)", "N+1 Runs"});
+    actionTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    actionTable->horizontalHeader()->setSectionResizeMode(ACTION, QHeaderView::Stretch);
+    actionTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    actionTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    actionTable->setSelectionMode(QAbstractItemView::SingleSelection);
+    actionSplitter->addWidget(actionTable);
+
+    actionDetailText = new QPlainTextEdit(this);
+    actionDetailText->setReadOnly(true);
+    actionDetailText->setLineWrapMode(QPlainTextEdit::NoWrap);
+    actionDetailText->setFont(QFont("Monospace"));
+    actionSplitter->addWidget(actionDetailText);
+
+    auto *tabs = new QTabWidget(this);
+    tabs->addTab(splitter, "Statements");
+    tabs->addTab(actionSplitter, "Actions");
+    mainLayout->addWidget(tabs);
+
+    refreshTimer = new QTimer(this);
+    refreshTimer->setInterval(1000);
+    refreshTimer->start();
+
+    connect(enabledCheck, &QCheckBox::toggled, this, [](bool enabled)
+            { SqlTracer::instance().setEnabled(enabled); });
+    connect(thresholdSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, [](double ms)
+            { SqlTracer::instance().setSlowThreshold(std::chrono::microseconds(static_cast<int64_t>(ms * 1000.0))); });
+    connect(nPlusOneSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, [](int runs)
+            { SqlTracer::instance().setNPlusOneThreshold(static_cast<size_t>(runs)); });
+    connect(refreshButton, &QPushButton::clicked, this, &SqlDiagnosticsWindow::onRefresh);
+    connect(resetButton, &QPushButton::clicked, this, &SqlDiagnosticsWindow::onReset);
+    connect(exportButton, &QPushButton::clicked, this, &SqlDiagnosticsWindow::onExport);
+    connect(statementTable, &QTableWidget::itemSelectionChanged, this, &SqlDiagnosticsWindow::onSelectionChanged);
+    connect(actionTable, &QTableWidget::itemSelectionChanged, this, &SqlDiagnosticsWindow::onActionSelectionChanged);
+    connect(refreshTimer, &QTimer::timeout, this, &SqlDiagnosticsWindow::onRefresh);
+
+    setWindowTitle("SQL Diagnostics");
+    resize(1100, 700);
+}
+
+void SqlDiagnosticsWindow::onRefresh()
+{
+    // Keep the same statement selected across refreshes
+    QString selected;
+    int current = statementTable->currentRow();
+    if (current >= 0 && static_cast<size_t>(current) < statements.size())
+    {
+        selected = statements[static_cast<size_t>(current)].statement;
+    }
+
+    statements = SqlTracer::instance().snapshot();
+    size_t executions = 0;
+    double totalMs = 0.0;
+    for (const auto &stats : statements)
+    {
+        executions += stats.count;
+        totalMs += static_cast<double>(stats.prepareNanos + stats.execNanos) / 1e6;
+    }
+    summaryLabel->setText(QString("%1 statements, %2 executions, %3 ms in the database%4")
+                              .arg(statements.size())
+                              .arg(executions)
+                              .arg(totalMs, 0, 'f', 1)
+                              .arg(SqlTracer::instance().enabled() ? "" : " (tracing is off)"));
+
+    statementTable->blockSignals(true);
+    statementTable->setRowCount(static_cast<int>(statements.size()));
+    int selectedRow = -1;
+    for (size_t i = 0; i < statements.size(); ++i)
+    {
+        const auto &stats = statements[i];
+        int row = static_cast<int>(i);
+        auto *statementItem = new QTableWidgetItem(stats.statement);
+        statementItem->setToolTip(stats.statement);
+        statementTable->setItem(row, STATEMENT, statementItem);
+        statementTable->setItem(row, COUNT, numberItem(static_cast<double>(stats.count), 0));
+        statementTable->setItem(row, ERRORS, numberItem(static_cast<double>(stats.errors), 0));
+        statementTable->setItem(row, ROWS, numberItem(static_cast<double>(stats.rows), 0));
+        statementTable->setItem(row, PREPARE_MS, numberItem(static_cast<double>(stats.prepareNanos) / 1e6, 2));
+        statementTable->setItem(row, EXEC_MS, numberItem(static_cast<double>(stats.execNanos) / 1e6, 2));
+        statementTable->setItem(row, MEAN_US, numberItem(stats.meanMicros(), 1));
+        statementTable->setItem(row, P50_US, numberItem(stats.percentileMicros(0.50), 0));
+        statementTable->setItem(row, P95_US, numberItem(stats.percentileMicros(0.95), 0));
+        statementTable->setItem(row, P99_US, numberItem(stats.percentileMicros(0.99), 0));
+        statementTable->setItem(row, MAX_MS, numberItem(static_cast<double>(stats.maxExecNanos) / 1e6, 2));
+        if (stats.statement == selected)
+        {
+            selectedRow = row;
+        }
+    }
+    statementTable->blockSignals(false);
+    if (selectedRow >= 0)
+    {
+        statementTable->selectRow(selectedRow);
+    }
+    onSelectionChanged();
+
+    QString selectedAction;
+    current = actionTable->currentRow();
+    if (current >= 0 && static_cast<size_t>(current) < actions.size())
+    {
+        selectedAction = actions[static_cast<size_t>(current)].action;
+    }
+    actions = SqlTracer::instance().actionSnapshot();
+    actionTable->blockSignals(true);
+    actionTable->setRowCount(static_cast<int>(actions.size()));
+    selectedRow = -1;
+    for (size_t i = 0; i < actions.size(); ++i)
+    {
+        const auto &stats = actions[i];
+        int row = static_cast<int>(i);
+        auto *actionItem = new QTableWidgetItem(stats.action);
+        if (stats.nPlusOne > 0)
+        {
+            actionItem->setForeground(Qt::red);
+        }
+        actionTable->setItem(row, ACTION, actionItem);
+        actionTable->setItem(row, INVOCATIONS, numberItem(static_cast<double>(stats.invocations), 0));
+        actionTable->setItem(row, QUERIES, numberItem(static_cast<double>(stats.queries), 0));
+        actionTable->setItem(row, QUERIES_PER_RUN, numberItem(static_cast<double>(stats.queries) / static_cast<double>(std::max<size_t>(stats.invocations, 1)), 1));
+        actionTable->setItem(row, MAX_QUERIES, numberItem(static_cast<double>(stats.maxQueries), 0));
+        actionTable->setItem(row, DB_MS, numberItem(static_cast<double>(stats.dbNanos) / 1e6, 2));
+        actionTable->setItem(row, N_PLUS_ONE, numberItem(static_cast<double>(stats.nPlusOne), 0));
+        if (stats.action == selectedAction)
+        {
+            selectedRow = row;
+        }
+    }
+    actionTable->blockSignals(false);
+    if (selectedRow >= 0)
+    {
+        actionTable->selectRow(selectedRow);
+    }
+    onActionSelectionChanged();
+}
+
+void SqlDiagnosticsWindow::onReset()
+{
+    SqlTracer::instance().reset();
+    onRefresh();
+}
+
+void SqlDiagnosticsWindow::onExport()
+{
+    QString path = QFileDialog::getSaveFileName(this, "Export SQL Trace", "sql_trace.json", "JSON (*.json)");
+    if (path.isEmpty())
+    {
+        return;
+    }
+    if (!SqlTracer::instance().writeJson(path))
+    {
+        QMessageBox::warning(this, "SQL Diagnostics", "Could not write " + path);
+    }
+}
+
+void SqlDiagnosticsWindow::onSelectionChanged()
+{
+    int row = statementTable->currentRow();
+    if (row < 0 || static_cast<size_t>(row) >= statements.size())
+    {
+        detailText->clear();
+        return;
+    }
+    const auto &stats = statements[static_cast<size_t>(row)];
+
+    QStringList lines;
+    lines << stats.statement << "";
+    lines << "Slowest execution (" + QString::number(static_cast<double>(stats.maxExecNanos) / 1e6, 'f', 2) + " ms):";
+    lines << stats.slowestText << "";
+    lines << "Query plan:";
+    lines << (stats.plan.isEmpty() ? QString("  (none; captured when an execution is slower than the threshold)") : stats.plan);
+    lines << "" << "Latency histogram:";
+
+    // Bars scaled to the fullest bucket, skipping empty buckets at either end
+    size_t first = StatementStats::HISTOGRAM_BUCKETS, last = 0, peak = 1;
+    for (size_t b = 0; b < StatementStats::HISTOGRAM_BUCKETS; ++b)
+    {
+        if (stats.histogram[b] > 0)
+        {
+            first = std::min(first, b);
+            last = b;
+            peak = std::max(peak, stats.histogram[b]);
+        }
+    }
+    for (size_t b = first; b <= last && first < StatementStats::HISTOGRAM_BUCKETS; ++b)
+    {
+        int width = static_cast<int>(40 * stats.histogram[b] / peak);
+        lines << QString("  %1 %2 %3").arg(bucketLabel(b), 16).arg(QString(width, '#'), -40).arg(stats.histogram[b]);
+    }
+    detailText->setPlainText(lines.join('\n'));
+}
+
+void SqlDiagnosticsWindow::onActionSelectionChanged()
+{
+    int row = actionTable->currentRow();
+    if (row < 0 || static_cast<size_t>(row) >= actions.size())
+    {
+        actionDetailText->clear();
+        return;
+    }
+    const auto &stats = actions[static_cast<size_t>(row)];
+
+    QStringList lines;
+    lines << stats.action << "";
+    lines << QString("Busiest run issued %1 queries. Statements it ran more than once:").arg(stats.maxQueries);
+    if (stats.repeated.empty())
+    {
+        lines << "  (none)";
+    }
+    size_t threshold = SqlTracer::instance().nPlusOneThreshold();
+    for (const auto &[statement, count] : stats.repeated)
+    {
+        lines << QString("  %1x%2 %3").arg(count, 6).arg(count >= threshold ? " N+1" : "    ").arg(statement);
+    }
+    actionDetailText->setPlainText(lines.join('\n'));
+}
@@ -0,0 +1,103 @@
+#include "widgets/TracingApplication.hpp"
+#include <QAbstractButton>
+#include <QAction>
+#include <QKeyEvent>
+#include <QKeySequence>
+#include <QMenu>
+#include <QMouseEvent>
+
+#include "infra/sql_trace.hpp"
+
+using namespace woodworks::widgets;
+using namespace woodworks::infra;
+
+namespace
+{
+    QString cleanText(QString text)
+    {
+        return text.remove('&');
+    }
+
+    // The widget itself or its closest ancestor with a name of our own, skipping Qt's internal ones
+    QString widgetName(QWidget *widget)
+    {
+        for (QWidget *w = widget; w; w = w->parentWidget())
+        {
+            if (!w->objectName().isEmpty() && !w->objectName().startsWith("qt_"))
+            {
+                return w->objectName();
+            }
+        }
+        return widget->metaObject()->className();
+    }
+}
+
+QString TracingApplication::actionName(QObject *receiver, QEvent *event)
+{
+    switch (event->type())
+    {
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseButtonDblClick:
+    {
+        auto *widget = qobject_cast<QWidget *>(receiver);
+        if (!widget)
+        {
+            return QString();
+        }
+        if (auto *menu = qobject_cast<QMenu *>(widget))
+        {
+            QAction *action = menu->actionAt(static_cast<QMouseEvent *>(event)->pos());
+            return action ? "menu: " + cleanText(action->text()) : QString();
+        }
+        if (auto *button = qobject_cast<QAbstractButton *>(widget))
+        {
+            return "button: " + (button->objectName().isEmpty() ? cleanText(button->text()) : button->objectName());
+        }
+        QString kind = event->type() == QEvent::MouseButtonDblClick ? "double click: " : "click: ";
+        return kind + widgetName(widget);
+    }
+    case QEvent::KeyPress:
+    {
+        auto *widget = qobject_cast<QWidget *>(receiver);
+        auto *key = static_cast<QKeyEvent *>(event);
+        if (!widget || key->isAutoRepeat())
+        {
+            return QString();
+        }
+        if (auto *menu = qobject_cast<QMenu *>(widget))
+        {
+            if (menu->activeAction() && (key->key() == Qt::Key_Return || key->key() == Qt::Key_Enter))
+            {
+                return "menu: " + cleanText(menu->activeAction()->text());
+            }
+        }
+        return "key: " + QKeySequence(key->key() | static_cast<int>(key->modifiers())).toString() + " in " + widgetName(widget);
+    }
+    case QEvent::Shortcut:
+    {
+        if (auto *action = qobject_cast<QAction *>(receiver))
+        {
+            return "shortcut: " + cleanText(action->text());
+        }
+        return QString();
+    }
+    default:
+        return QString();
+    }
+}
+
+bool TracingApplication::notify(QObject *receiver, QEvent *event)
+{
+    // Only user input starts an action, and only while tracing
+    if (!SqlTracer::instance().enabled() || !ActionScope::current().isEmpty())
+    {
+        return QApplication::notify(receiver, event);
+    }
+    QString name = actionName(receiver, event);
+    if (name.isEmpty())
+    {
+        return QApplication::notify(receiver, event);
+    }
+    ActionScope scope(name);
+    return QApplication::notify(receiver, event);
+}
@@ -0,0 +1,50 @@
+#include "widgets/WebEnginePrewarmer.hpp"
+#include <QApplication>
+#include <QTimer>
+#include <QUrl>
+#include <QWebEngineView>
+
+#include <chrono>
+
+#include "infra/logging.hpp"
+
+using namespace woodworks::widgets;
+
+QPointer<QWebEngineView> WebEnginePrewarmer::warm_;
+
+void WebEnginePrewarmer::schedule(int delayMs)
+{
+    QTimer::singleShot(delayMs, [] { warm(); });
+}
+
+void WebEnginePrewarmer::warm()
+{
+    if (warm_)
+    {
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    // Never shown; it only exists so the engine and its profile are loaded
+    warm_ = new QWebEngineView();
+    warm_->setAttribute(Qt::WA_DontShowOnScreen);
+    warm_->setUrl(QUrl("about:blank"));
+    // WebEngine warns if a view outlives the application's profile
+    QObject::connect(qApp, &QCoreApplication::aboutToQuit, warm_, &QObject::deleteLater);
+    WOODWORKS_LOG_DEBUG("startup", "web engine warmed",
+                        {{"ms", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()}});
+}
+
+QWebEngineView *WebEnginePrewarmer::take(QWidget *parent)
+{
+    QWebEngineView *view = warm_;
+    warm_ = nullptr;
+    if (!view)
+    {
+        view = new QWebEngineView();
+    }
+    view->setParent(parent);
+    view->setAttribute(Qt::WA_DontShowOnScreen, false);
+    // Ready the next one once this preview has had time to load
+    schedule(2000);
+    return view;
+}
@@ -0,0 +1,223 @@
+#include "widgets/YardPlanningWindow.hpp"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QComboBox>
+#include <QMessageBox>
+#include <QMetaObject>
+
+#include "infra/repository.hpp"
+
+using namespace woodworks::widgets;
+using namespace woodworks::domain;
+using namespace woodworks::domain::imperial;
+using namespace woodworks::domain::yard;
+using namespace woodworks::infra;
+
+namespace
+{
+    enum DemandColumn
+    {
+        KIND,
+        SPECIES,
+        THICKNESS,
+        WIDTH,
+        LENGTH,
+        QUANTITY,
+        PRICE,
+        DEMAND_COLUMNS
+    };
+
+    QString kindName(DemandKind kind)
+    {
+        switch (kind)
+        {
+        case DemandKind::SLAB:
+            return "Slab";
+        case DemandKind::LUMBER:
+            return "Lumber";
+        case DemandKind::COOKIE:
+            return "Cookie";
+        }
+        return "";
+    }
+}
+
+YardPlanningWindow::YardPlanningWindow(QWidget *parent)
+    : QMainWindow(parent)
+{
+    setupUi();
+    onAddDemand();
+}
+
+YardPlanningWindow::~YardPlanningWindow()
+{
+    stopPlanning();
+}
+
+void YardPlanningWindow::setupUi()
+{
+    QWidget *central = new QWidget(this);
+    setCentralWidget(central);
+    auto *mainLayout = new QVBoxLayout(central);
+    mainLayout->setContentsMargins(10, 10, 10, 10);
+
+    // Demand list
+    mainLayout->addWidget(new QLabel("Demand (inches, quantity, $ each):"));
+    demandTable = new QTableWidget(0, DEMAND_COLUMNS, this);
+    demandTable->setHorizontalHeaderLabels({"Kind", "Species", "Thickness", "Width", "Length", "Quantity", "$ Each"});
+    demandTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    mainLayout->addWidget(demandTable);
+
+    auto *demandButtons = new QHBoxLayout();
+    auto *addButton = new QPushButton("Add Demand");
+    auto *removeButton = new QPushButton("Remove Demand");
+    demandButtons->addWidget(addButton);
+    demandButtons->addWidget(removeButton);
+    mainLayout->addLayout(demandButtons);
+
+    // Plan controls
+    auto *planButtons = new QHBoxLayout();
+    planButton = new QPushButton("Plan Yard");
+    cancelButton = new QPushButton("Stop");
+    cancelButton->setEnabled(false);
+    planButtons->addWidget(planButton);
+    planButtons->addWidget(cancelButton);
+    mainLayout->addLayout(planButtons);
+
+    statusLabel = new QLabel(this);
+    mainLayout->addWidget(statusLabel);
+
+    // Results
+    resultTable = new QTableWidget(0, 5, this);
+    resultTable->setHorizontalHeaderLabels({"Log", "Species", "Demand", "Pieces", "Value"});
+    resultTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    resultTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mainLayout->addWidget(resultTable);
+
+    connect(addButton, &QPushButton::clicked, this, &YardPlanningWindow::onAddDemand);
+    connect(removeButton, &QPushButton::clicked, this, &YardPlanningWindow::onRemoveDemand);
+    connect(planButton, &QPushButton::clicked, this, &YardPlanningWindow::onPlan);
+    connect(cancelButton, &QPushButton::clicked, this, &YardPlanningWindow::onCancel);
+
+    setWindowTitle("Yard Planning");
+    resize(800, 600);
+}
+
+void YardPlanningWindow::onAddDemand()
+{
+    int row = demandTable->rowCount();
+    demandTable->insertRow(row);
+    auto *kindCombo = new QComboBox();
+    kindCombo->addItems({kindName(DemandKind::SLAB), kindName(DemandKind::LUMBER), kindName(DemandKind::COOKIE)});
+    demandTable->setCellWidget(row, KIND, kindCombo);
+    demandTable->setItem(row, SPECIES, new QTableWidgetItem(""));
+    demandTable->setItem(row, THICKNESS, new QTableWidgetItem("2"));
+    demandTable->setItem(row, WIDTH, new QTableWidgetItem("12"));
+    demandTable->setItem(row, LENGTH, new QTableWidgetItem("96"));
+    demandTable->setItem(row, QUANTITY, new QTableWidgetItem("1"));
+    demandTable->setItem(row, PRICE, new QTableWidgetItem("0"));
+}
+
+void YardPlanningWindow::onRemoveDemand()
+{
+    int row = demandTable->currentRow();
+    if (row >= 0)
+    {
+        demandTable->removeRow(row);
+    }
+}
+
+void YardPlanningWindow::onPlan()
+{
+    stopPlanning();
+
+    demands.clear();
+    for (int row = 0; row < demandTable->rowCount(); ++row)
+    {
+        auto text = [&](int column)
+        { return demandTable->item(row, column) ? demandTable->item(row, column)->text().trimmed() : QString(); };
+
+        Demand demand;
+        demand.kind = static_cast<DemandKind>(qobject_cast<QComboBox *>(demandTable->cellWidget(row, KIND))->currentIndex());
+        demand.species = text(SPECIES).toStdString();
+        demand.thickness = Length::fromInches(text(THICKNESS).toDouble());
+        demand.width = Length::fromInches(text(WIDTH).toDouble());
+        demand.length = Length::fromInches(text(LENGTH).toDouble());
+        demand.quantity = text(QUANTITY).toInt();
+        demand.centsEach = text(PRICE).toDouble() * 100.0;
+        demands.push_back(demand);
+    }
+    if (demands.empty())
+    {
+        QMessageBox::warning(this, "Yard Planning", "Add at least one demand.");
+        return;
+    }
+
+    // Logs are read here since the database connection belongs to this thread
+    logs = QtSqlRepository<Log>::spawn().list();
+    resultTable->setRowCount(0);
+    statusLabel->setText(QString("Evaluating %1 logs...").arg(logs.size()));
+    planButton->setEnabled(false);
+    cancelButton->setEnabled(true);
+
+    cancelled = false;
+    unsigned int run = ++planRun;
+    planThread = std::thread([this, run]()
+                             { YardPlanner().plan(logs, demands, [this, run](const YardPlan &plan)
+                                                  { QMetaObject::invokeMethod(
+                                                        this, [this, run, plan]()
+                                                        {
+                                                            if (run == planRun)
+                                                            {
+                                                                showPlan(plan);
+                                                            } },
+                                                        Qt::QueuedConnection); },
+                                                  &cancelled); });
+}
+
+void YardPlanningWindow::onCancel()
+{
+    cancelled = true;
+}
+
+void YardPlanningWindow::stopPlanning()
+{
+    cancelled = true;
+    if (planThread.joinable())
+    {
+        planThread.join();
+    }
+}
+
+void YardPlanningWindow::showPlan(const YardPlan &plan)
+{
+    resultTable->setRowCount(static_cast<int>(plan.assignments.size()));
+    int row = 0;
+    for (const auto &assignment : plan.assignments)
+    {
+        auto log = std::find_if(logs.begin(), logs.end(), [&](const Log &l)
+                                { return l.id.id == assignment.logId.id; });
+        const auto &demand = demands[assignment.demand];
+        resultTable->setItem(row, 0, new QTableWidgetItem(QString::number(assignment.logId.id)));
+        resultTable->setItem(row, 1, new QTableWidgetItem(log != logs.end() ? QString::fromStdString(log->species.name) : QString()));
+        resultTable->setItem(row, 2, new QTableWidgetItem(QString("#%1 %2").arg(assignment.demand + 1).arg(kindName(demand.kind))));
+        resultTable->setItem(row, 3, new QTableWidgetItem(QString("%1 of %2").arg(assignment.pieces).arg(assignment.capacity)));
+        resultTable->setItem(row, 4, new QTableWidgetItem(Dollar::fromCents(static_cast<int>(assignment.valueCents)).format().c_str()));
+        ++row;
+    }
+
+    statusLabel->setText(QString("%1 %2 of %3 logs evaluated, %4 of %5 orders filled, %6 total")
+                             .arg(plan.complete ? "Done:" : "Planning:")
+                             .arg(plan.logsEvaluated)
+                             .arg(plan.logsTotal)
+                             .arg(plan.ordersFilled)
+                             .arg(demands.size())
+                             .arg(Dollar::fromCents(static_cast<int>(plan.valueCents)).format().c_str()));
+
+    if (plan.complete || cancelled)
+    {
+        planButton->setEnabled(true);
+        cancelButton->setEnabled(false);
+    }
+}